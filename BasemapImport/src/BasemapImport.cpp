@@ -20,6 +20,7 @@
 #include <cstring>
 #include <cstdio>
 
+#include <future>
 #include <iostream>
 #include <memory>
 #include <sstream>
@@ -161,6 +162,81 @@ static void InitializeLocale(osmscout::Progress& progress)
   }
 }
 
+/**
+ * Calculates the state and the ground tiles of all cells of the given level
+ */
+static void CalculateLevel(osmscout::Progress& progress,
+                           const std::list<osmscout::WaterIndexProcessor::CoastRef>& coasts,
+                           uint32_t maxWaterDistance,
+                           osmscout::WaterIndexProcessor::Level& level,
+                           std::map<osmscout::Pixel,std::list<osmscout::GroundTile>>& cellGroundTileMap)
+{
+  osmscout::WaterIndexProcessor                      processor;
+  osmscout::Magnification                            magnification(osmscout::MagnificationLevel(level.level));
+  osmscout::MercatorProjection                       projection;
+  std::list<osmscout::WaterIndexProcessor::CoastRef> boundingPolygons;
+
+  projection.Set(osmscout::GeoCoord(0.0,0.0),magnification,72,640,480);
+
+  progress.SetAction("Building tiles for level "+std::to_string(level.level));
+
+  if (!coasts.empty()) {
+    osmscout::WaterIndexProcessor::Data data;
+
+    // Collects, calculates and generates a number of data about a coastline
+    processor.CalculateCoastlineData(progress,
+                                     osmscout::TransPolygon::fast,
+                                     /*tolerance*/ 10.0,
+                                     /*minObjectDimension*/ 1.0,
+                                     projection,
+                                     level.stateMap,
+                                     coasts,
+                                     data);
+
+    // Mark cells that intersect a coastline as coast
+    processor.MarkCoastlineCells(progress,
+                                 level.stateMap,
+                                 data);
+
+    // Fills coords information for cells that intersect a coastline
+    processor.HandleCoastlinesPartiallyInACell(progress,
+                                               level.stateMap,
+                                               cellGroundTileMap,
+                                               data);
+
+    // Fills coords information for cells that completely contain a coastline
+    processor.HandleAreaCoastlinesCompletelyInACell(progress,
+                                                    level.stateMap,
+                                                    data,
+                                                    cellGroundTileMap);
+  }
+
+  // Calculate the cell type for cells directly around coast cells
+  processor.CalculateCoastEnvironment(progress,
+                                      level.stateMap,
+                                      cellGroundTileMap);
+
+  if (!coasts.empty()) {
+    // Marks all still 'unknown' cells neighbouring 'water' cells as 'water', too
+    processor.FillWater(progress,
+                        level,
+                        std::min(maxWaterDistance, 2u << level.level), // how far (in tiles) from coastline is filled water
+                        boundingPolygons);
+
+    processor.FillWaterAroundIsland(progress,
+                                    level.stateMap,
+                                    cellGroundTileMap,
+                                    boundingPolygons);
+  }
+
+  // Marks all still 'unknown' cells between 'coast' or 'land' and 'land' cells as 'land', too
+  processor.FillLand(progress,
+                     level.stateMap);
+
+  processor.CalculateHasCellData(level,
+                                 cellGroundTileMap);
+}
+
 static bool ImportCoastlines(const std::string& destinationDirectory,
                              const std::string& coastlineShapeFile,
                              osmscout::Progress& progress,
@@ -251,76 +327,32 @@ static bool ImportCoastlines(const std::string& destinationDirectory,
                               levels);
     progress.Info("Generating index for level "+std::to_string(indexMinMag)+" to "+std::to_string(indexMaxMag));
 
-    for (auto& level : levels) {
-      osmscout::Magnification                                    magnification(osmscout::MagnificationLevel(level.level));
-      osmscout::MercatorProjection                               projection;
-      std::list<osmscout::WaterIndexProcessor::CoastRef>         boundingPolygons;
-      std::map<osmscout::Pixel,std::list<osmscout::GroundTile> > cellGroundTileMap;
-
-      projection.Set(osmscout::GeoCoord(0.0,0.0),magnification,72,640,480);
-
-      progress.SetAction("Building tiles for level "+std::to_string(level.level));
-
-      if (!visitor.coasts.empty()) {
-        osmscout::WaterIndexProcessor::Data data;
-
-        // Collects, calculates and generates a number of data about a coastline
-        processor.CalculateCoastlineData(progress,
-                                         osmscout::TransPolygon::fast,
-                                         /*tolerance*/ 10.0,
-                                         /*minObjectDimension*/ 1.0,
-                                         projection,
-                                         level.stateMap,
-                                         visitor.coasts,
-                                         data);
-
-        // Mark cells that intersect a coastline as coast
-        processor.MarkCoastlineCells(progress,
-                                     level.stateMap,
-                                     data);
-
-        // Fills coords information for cells that intersect a coastline
-        processor.HandleCoastlinesPartiallyInACell(progress,
-                                                   level.stateMap,
-                                                   cellGroundTileMap,
-                                                   data);
-
-        // Fills coords information for cells that completely contain a coastline
-        processor.HandleAreaCoastlinesCompletelyInACell(progress,
-                                                        level.stateMap,
-                                                        data,
-                                                        cellGroundTileMap);
-      }
-
-      // Calculate the cell type for cells directly around coast cells
-      processor.CalculateCoastEnvironment(progress,
-                                          level.stateMap,
-                                          cellGroundTileMap);
-
-      if (!visitor.coasts.empty()) {
-        // Marks all still 'unknown' cells neighbouring 'water' cells as 'water', too
-        processor.FillWater(progress,
-                            level,
-                            std::min(maxWaterDistance, 2u << level.level), // how far (in tiles) from coastline is filled water
-                            boundingPolygons);
-
-        processor.FillWaterAroundIsland(progress,
-                                        level.stateMap,
-                                        cellGroundTileMap,
-                                        boundingPolygons);
-      }
-
-      // Marks all still 'unknown' cells between 'coast' or 'land' and 'land' cells as 'land', too
-      processor.FillLand(progress,
-                         level.stateMap);
+    // Levels are independent of each other, so they are calculated in parallel.
+    // Tiles are written in level order as soon as the level is calculated.
+    // Level tasks and writing report to the same progress.
+    osmscout::SynchronizedProgress                                         levelProgress(progress);
+    std::vector<std::map<osmscout::Pixel,std::list<osmscout::GroundTile>>> cellGroundTileMaps(levels.size());
+    std::vector<std::future<void>>                                         levelFutures;
+
+    for (size_t l=0; l<levels.size(); l++) {
+      levelFutures.push_back(std::async(std::launch::async,
+                                        CalculateLevel,
+                                        std::ref(levelProgress),
+                                        std::cref(visitor.coasts),
+                                        maxWaterDistance,
+                                        std::ref(levels[l]),
+                                        std::ref(cellGroundTileMaps[l])));
+    }
 
-      processor.CalculateHasCellData(level,
-                                     cellGroundTileMap);
+    for (size_t l=0; l<levels.size(); l++) {
+      levelFutures[l].get();
 
-      processor.WriteTiles(progress,
-                           cellGroundTileMap,
-                           level,
+      processor.WriteTiles(levelProgress,
+                           cellGroundTileMaps[l],
+                           levels[l],
                            writer);
+
+      cellGroundTileMaps[l].clear();
     }
 
     writer.Close();
@@ -17,14 +17,24 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 */
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <iomanip>
 #include <limits>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
 #include <tuple>
+#include <vector>
 
 #include "config.h"
 
 #include <osmscout/Database.h>
+#include <osmscout/MapPainter.h>
 #include <osmscout/MapService.h>
 
 #if defined(HAVE_LIB_OSMSCOUTMAPCAIRO)
@@ -60,14 +70,42 @@
 #include <osmscout/system/Math.h>
 
 #include <osmscout/util/CmdLineParsing.h>
+#include <osmscout/util/File.h>
+#include <osmscout/util/MemoryMonitor.h>
 #include <osmscout/util/StopClock.h>
+#include <osmscout/util/String.h>
 #include <osmscout/util/Tiling.h>
 
 /*
   Example for the nordrhein-westfalen.osm (to be executed in the Demos top
   level directory), drawing the "Ruhrgebiet":
 
-  src/PerformanceTest ../maps/nordrhein-westfalen ../stylesheets/standard.oss 51.4 7.3 51.6 7.7 10 15 256 256 cairo
+  src/PerformanceTest ../maps/nordrhein-westfalen ../stylesheets/standard.oss 51.4 7.3 51.6 7.7 --start-zoom 10 --end-zoom 15 --driver cairo
+
+  Instead of one bounding box and zoom range, a scenario file can be passed
+  (--scenario). Each non-empty line that does not start with '#' defines
+  one scenario:
+
+    # name   lat_top lon_left lat_bottom lon_right zoom stylesheet                 driver dpi
+    ruhr-z12 51.6    7.3      51.4       7.7       12   -                          cairo  96
+    ruhr-z15 51.6    7.3      51.4       7.7       15   ../stylesheets/winter.oss  -      192
+
+  A '-' for stylesheet, driver or dpi takes the value from the command line.
+
+  Each scenario is rendered in a cold run (database reopened and caches flushed
+  before the run) and/or in a warm run (tiles loaded and rendered once before
+  measuring), see --runs. Tiles are distributed to --threads worker threads,
+  each with its own backend instance. Backends are created once per driver,
+  stylesheet and dpi and reused by all scenarios and runs.
+
+  Note that with more than one thread the DB times include waiting for other
+  threads: MapService loads missing tile data under one internal mutex, so
+  concurrent loads are serialized. Per-tile flushing of caches (--flush-cache,
+  --flush-disk) is disabled with more than one thread.
+
+  Results can be written as JSON (--json) and later be used as a baseline for
+  a new measurement (--baseline), the comparison fails if the median or the
+  90th percentile of data loading or drawing got slower than --tolerance percent.
 */
 
 // See http://wiki.openstreetmap.org/wiki/Slippy_map_tilenames for details about
@@ -89,6 +127,12 @@ struct Arguments {
   size_t loadRepeat{1};
   bool flushCache{false};
   bool flushDiskCache{false};
+  std::string scenarioFile;
+  std::string runs{"cold"};
+  size_t threads{1};
+  std::string jsonFile;
+  std::string baselineFile;
+  double tolerance{10.0};
 
 #if defined(HAVE_LIB_GPERFTOOLS)
   bool heapProfile{false};
@@ -104,68 +148,131 @@ struct Arguments {
   {
     return std::get<1>(tileDimension);
   }
+};
 
-  double LatBottom() const
+/**
+ * One benchmark scenario: An area rendered at a given zoom level
+ * with the given style, driver and dpi
+ */
+struct Scenario
+{
+  std::string                  name;
+  osmscout::GeoCoord           coordTopLeft;
+  osmscout::GeoCoord           coordBottomRight;
+  osmscout::MagnificationLevel zoom;
+  std::string                  style;
+  std::string                  driver;
+  double                       dpi;
+};
+
+/**
+ * Summary of a list of measured values (in milliseconds)
+ */
+struct Percentiles
+{
+  double min{0.0};
+  double avg{0.0};
+  double p50{0.0};
+  double p90{0.0};
+  double p99{0.0};
+  double max{0.0};
+
+  explicit Percentiles(std::vector<double> values)
   {
-    return coordBottomRight.GetLat();
+    if (values.empty()) {
+      return;
+    }
+
+    std::sort(values.begin(),values.end());
+
+    double sum=0.0;
+
+    for (const auto value : values) {
+      sum+=value;
+    }
+
+    min=values.front();
+    max=values.back();
+    avg=sum/values.size();
+    p50=Get(values,50.0);
+    p90=Get(values,90.0);
+    p99=Get(values,99.0);
   }
 
-  double LonLeft() const
+  /**
+   * Nearest-rank percentile of the given (sorted) values
+   */
+  static double Get(const std::vector<double>& sortedValues,
+                    double percentile)
   {
-    return coordTopLeft.GetLon();
+    size_t rank=(size_t)std::ceil(percentile/100.0*sortedValues.size());
+
+    return sortedValues[std::max(rank,(size_t)1)-1];
   }
+};
 
-  double LatTop() const
+/**
+ * Measured values of one run of a scenario
+ */
+struct RunResult
+{
+  std::string                             scenario;
+  std::string                             run;
+  size_t                                  threads{1};
+  size_t                                  tileCount{0};
+  double                                  wallTime{0.0};
+  double                                  peakVMUsage{0.0};
+  double                                  peakResidentSet{0.0};
+  double                                  allocMax{0.0};
+
+  size_t                                  nodeCount{0};
+  size_t                                  wayCount{0};
+  size_t                                  areaCount{0};
+
+  std::vector<double>                     loadTimes;
+  std::vector<double>                     drawTimes;
+  std::vector<osmscout::RenderStatistics> renderStatistics;
+
+  void Merge(const RunResult& other)
   {
-    return coordTopLeft.GetLat();
+    tileCount+=other.tileCount;
+    allocMax=std::max(allocMax,other.allocMax);
+    nodeCount+=other.nodeCount;
+    wayCount+=other.wayCount;
+    areaCount+=other.areaCount;
+    loadTimes.insert(loadTimes.end(),other.loadTimes.begin(),other.loadTimes.end());
+    drawTimes.insert(drawTimes.end(),other.drawTimes.begin(),other.drawTimes.end());
+    renderStatistics.insert(renderStatistics.end(),other.renderStatistics.begin(),other.renderStatistics.end());
   }
 
-  double LonRight() const
+  std::vector<double> GetStepTimes(size_t step) const
   {
-    return coordBottomRight.GetLon();
+    std::vector<double> times;
+
+    times.reserve(renderStatistics.size());
+
+    for (const auto& statistics : renderStatistics) {
+      times.push_back(statistics.stepTime[step]);
+    }
+
+    return times;
   }
-};
 
-struct LevelStats
-{
-  size_t level;
-
-  double dbMinTime;
-  double dbMaxTime;
-  double dbTotalTime;
-
-  double drawMinTime;
-  double drawMaxTime;
-  double drawTotalTime;
-
-  double allocMax;
-  double allocSum;
-
-  size_t nodeCount;
-  size_t wayCount;
-  size_t areaCount;
-
-  size_t tileCount;
-
-  explicit LevelStats(size_t level)
-  : level(level),
-    dbMinTime(std::numeric_limits<double>::max()),
-    dbMaxTime(0.0),
-    dbTotalTime(0.0),
-    drawMinTime(std::numeric_limits<double>::max()),
-    drawMaxTime(0.0),
-    drawTotalTime(0.0),
-    allocMax(0.0),
-    allocSum(0.0),
-    nodeCount(0),
-    wayCount(0),
-    areaCount(0),
-    tileCount(0)
+  std::string GetKey() const
   {
-    // no code
+    return scenario+"/"+run+"/"+std::to_string(threads);
   }
 };
 
+/**
+ * Subset of a result read from a baseline file
+ */
+struct BaselineResult
+{
+  Percentiles load{{}};
+  Percentiles draw{{}};
+};
+
 std::string formatAlloc(double size)
 {
     std::string units = " bytes";
@@ -220,6 +327,7 @@ public:
 
   ~PerformanceTestBackendCairo()
   {
+    delete cairoMapPainter;
     cairo_destroy(cairo);
     cairo_surface_destroy(cairoSurface);
   }
@@ -239,14 +347,25 @@ public:
 #if defined(HAVE_LIB_OSMSCOUTMAPQT)
 class PerformanceTestBackendQt: public PerformanceTestBackend {
 private:
-  QApplication application;
+  QApplication& application;
   QPixmap qtPixmap;
   QPainter qtPainter;
   osmscout::MapPainterQt qtMapPainter;
+
+  /**
+   * There may be just one QApplication in the process, it is shared by all Qt backends.
+   * QApplication keeps a reference to argc, it have to be valid for the whole program run.
+   */
+  static QApplication& GetApplication(int& argc, char* argv[])
+  {
+    static QApplication application(argc, argv, true);
+    return application;
+  }
+
 public:
-  PerformanceTestBackendQt(int argc, char* argv[], int tileWidth, int tileHeight,
+  PerformanceTestBackendQt(int& argc, char* argv[], int tileWidth, int tileHeight,
                            const osmscout::StyleConfigRef& styleConfig):
-    application(argc, argv, true),
+    application(GetApplication(argc, argv)),
     qtPixmap{tileWidth,tileHeight},
     qtPainter{&qtPixmap},
     qtMapPainter{styleConfig}
@@ -285,6 +404,7 @@ public:
   {
     delete pf;
     delete rbuf;
+    delete[] buffer;
   }
 
   void DrawMap(const osmscout::TileProjection &projection,
@@ -302,6 +422,7 @@ public:
 #if defined(HAVE_LIB_OSMSCOUTMAPOPENGL)
 class PerformanceTestBackendOGL: public PerformanceTestBackend {
 private:
+  GLFWwindow* offscreenContext{nullptr};
   osmscout::MapPainterOpenGL* openglMapPainter{nullptr};
   osmscout::StyleConfigRef styleConfig;
 public:
@@ -320,16 +441,15 @@ public:
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
     glfwWindowHint(GLFW_VISIBLE, false);
-    GLFWwindow* offscreen_context;
-    offscreen_context=glfwCreateWindow(tileWidth,
-                                       tileHeight,
-                                       "",
-                                       nullptr,
-                                       nullptr);
-    if (!offscreen_context) {
+    offscreenContext=glfwCreateWindow(tileWidth,
+                                      tileHeight,
+                                      "",
+                                      nullptr,
+                                      nullptr);
+    if (!offscreenContext) {
       throw std::runtime_error("Failed to create offscreen context.");
     }
-    glfwMakeContextCurrent(offscreen_context);
+    glfwMakeContextCurrent(offscreenContext);
 
     // This driver need a valid existing context
     openglMapPainter=new osmscout::MapPainterOpenGL(tileWidth,
@@ -342,7 +462,10 @@ public:
 
   ~PerformanceTestBackendOGL()
   {
-    //leaks openglMapPainter;
+    // painter releases its GL resources, its context have to be current
+    glfwMakeContextCurrent(offscreenContext);
+    delete openglMapPainter;
+    glfwDestroyWindow(offscreenContext);
   }
 
   void DrawMap(const osmscout::TileProjection &projection,
@@ -376,13 +499,18 @@ public:
 
 using PerformanceTestBackendPtr = std::shared_ptr<PerformanceTestBackend>;
 
-PerformanceTestBackendPtr PrepareBackend(int argc, char* argv[], const Arguments &args, osmscout::StyleConfigRef styleConfig)
+PerformanceTestBackendPtr PrepareBackend(int& argc, char* argv[],
+                                         const std::string& driver,
+                                         size_t tileWidth,
+                                         size_t tileHeight,
+                                         double dpi,
+                                         osmscout::StyleConfigRef styleConfig)
 {
-  if (args.driver=="cairo") {
+  if (driver=="cairo") {
     std::cout << "Using driver 'cairo'..." << std::endl;
 #if defined(HAVE_LIB_OSMSCOUTMAPCAIRO)
     try{
-      return std::make_shared<PerformanceTestBackendCairo>(args.TileWidth(),args.TileHeight(),styleConfig);
+      return std::make_shared<PerformanceTestBackendCairo>(tileWidth,tileHeight,styleConfig);
     } catch (std::runtime_error &e){
       std::cerr << e.what() << std::endl;
       return nullptr;
@@ -392,27 +520,27 @@ PerformanceTestBackendPtr PrepareBackend(int argc, char* argv[], const Arguments
     return nullptr;
 #endif
   }
-  else if (args.driver=="Qt") {
+  else if (driver=="Qt") {
     std::cout << "Using driver 'Qt'..." << std::endl;
 #if defined(HAVE_LIB_OSMSCOUTMAPQT)
-    return std::make_shared<PerformanceTestBackendQt>(argc, argv, args.TileWidth(), args.TileHeight(), styleConfig);
+    return std::make_shared<PerformanceTestBackendQt>(argc, argv, tileWidth, tileHeight, styleConfig);
 #else
     std::cerr << "Driver 'Qt' is not enabled" << std::endl;
     return nullptr;
 #endif
-  } else if (args.driver == "agg") {
+  } else if (driver == "agg") {
     std::cout << "Using driver 'Agg'..." << std::endl;
 #if defined(HAVE_LIB_OSMSCOUTMAPAGG)
-    return std::make_shared<PerformanceTestBackendAGG>(args.TileWidth(), args.TileHeight(), styleConfig);
+    return std::make_shared<PerformanceTestBackendAGG>(tileWidth, tileHeight, styleConfig);
 #else
     std::cerr << "Driver 'Agg' is not enabled" << std::endl;
     return nullptr;
 #endif
-  } else if (args.driver == "opengl") {
+  } else if (driver == "opengl") {
     std::cout << "Using driver 'OpenGL'..." << std::endl;
 #if defined(HAVE_LIB_OSMSCOUTMAPOPENGL)
     try{
-      return std::make_shared<PerformanceTestBackendOGL>(args.TileWidth(), args.TileHeight(), args.dpi, styleConfig);
+      return std::make_shared<PerformanceTestBackendOGL>(tileWidth, tileHeight, dpi, styleConfig);
     } catch (std::runtime_error &e){
       std::cerr << e.what() << std::endl;
       return nullptr;
@@ -422,20 +550,934 @@ PerformanceTestBackendPtr PrepareBackend(int argc, char* argv[], const Arguments
     return nullptr;
 #endif
   }
-  else if (args.driver=="noop") {
+  else if (driver=="noop") {
     std::cout << "Using driver 'noop'..." << std::endl;
     return std::make_shared<PerformanceTestBackendNoOp>(styleConfig);
   }
-  else if (args.driver=="none") {
+  else if (driver=="none") {
     std::cout << "Using driver 'none'..." << std::endl;
     return std::make_shared<PerformanceTestBackend>();
   }
   else {
-    std::cerr << "Unsupported driver '" << args.driver << "'" << std::endl;
+    std::cerr << "Unsupported driver '" << driver << "'" << std::endl;
     return nullptr;
   }
 }
 
+/**
+ * Drivers that are bound to one (the main) thread
+ */
+bool IsSingleThreadedDriver(const std::string& driver)
+{
+  return driver=="Qt" || driver=="opengl";
+}
+
+/**
+ * Creating a backend is expensive and some drivers don't support repeated
+ * initialisation (Qt allows just one QApplication), so backends are created
+ * once per driver, stylesheet and dpi and reused by all scenarios and runs.
+ * Stylesheets are loaded once as well.
+ */
+class BackendCache
+{
+private:
+  int&                                                         argc;
+  char**                                                       argv;
+  std::map<std::string,osmscout::StyleConfigRef>               styleConfigs;
+  std::map<std::string,std::vector<PerformanceTestBackendPtr>> backends;
+
+public:
+  BackendCache(int& argc, char* argv[])
+  : argc(argc),
+    argv(argv)
+  {
+    // no code
+  }
+
+  osmscout::StyleConfigRef GetStyleConfig(const osmscout::TypeConfigRef& typeConfig,
+                                          const std::string& style)
+  {
+    auto entry=styleConfigs.find(style);
+
+    if (entry!=styleConfigs.end()) {
+      return entry->second;
+    }
+
+    osmscout::StyleConfigRef styleConfig=std::make_shared<osmscout::StyleConfig>(typeConfig);
+
+    if (!styleConfig->Load(style)) {
+      std::cerr << "Cannot open style '" << style << "'" << std::endl;
+      return nullptr;
+    }
+
+    styleConfigs[style]=styleConfig;
+
+    return styleConfig;
+  }
+
+  /**
+   * Returns one backend for each thread
+   */
+  bool GetBackends(const Arguments& args,
+                   const Scenario& scenario,
+                   const osmscout::StyleConfigRef& styleConfig,
+                   size_t threadCount,
+                   std::vector<PerformanceTestBackendPtr>& result)
+  {
+    std::ostringstream key;
+
+    key.imbue(std::locale::classic());
+    key << scenario.driver << "|" << scenario.style << "|" << scenario.dpi;
+
+    std::vector<PerformanceTestBackendPtr>& entry=backends[key.str()];
+
+    while (entry.size()<threadCount) {
+      PerformanceTestBackendPtr backend=PrepareBackend(argc,
+                                                       argv,
+                                                       scenario.driver,
+                                                       args.TileWidth(),
+                                                       args.TileHeight(),
+                                                       scenario.dpi,
+                                                       styleConfig);
+
+      if (!backend) {
+        return false;
+      }
+
+      entry.push_back(backend);
+    }
+
+    result.assign(entry.begin(),entry.begin()+threadCount);
+
+    return true;
+  }
+};
+
+void FlushDiskCache()
+{
+  // Linux specific
+  if (osmscout::ExistsInFilesystem("/proc/sys/vm/drop_caches")){
+    osmscout::FileWriter f;
+    try {
+      f.Open("/proc/sys/vm/drop_caches");
+      f.Write(std::string("3"));
+      f.Close();
+    }catch(const osmscout::IOException &e){
+      std::cerr << "Can't flush disk cache: " << e.what() << std::endl;
+    }
+  }else{
+    std::cerr << "Can't flush disk cache, \"/proc/sys/vm/drop_caches\" file don't exists" << std::endl;
+  }
+}
+
+/**
+ * Read scenarios from the given file, see the description at the top of this file
+ * for the format
+ */
+bool ReadScenarios(const Arguments& args,
+                   std::vector<Scenario>& scenarios)
+{
+  std::ifstream file(args.scenarioFile);
+
+  if (!file) {
+    std::cerr << "Cannot open scenario file '" << args.scenarioFile << "'" << std::endl;
+    return false;
+  }
+
+  std::string line;
+  size_t      lineNumber=0;
+
+  while (std::getline(file,line)) {
+    lineNumber++;
+
+    std::list<std::string> tokens=osmscout::SplitStringAtSpace(line);
+
+    if (tokens.empty() ||
+        tokens.front().front()=='#') {
+      continue;
+    }
+
+    std::vector<std::string> values(tokens.begin(),tokens.end());
+
+    if (values.size()!=9) {
+      std::cerr << args.scenarioFile << ":" << lineNumber << ": Expected 9 values, got " << values.size() << std::endl;
+      return false;
+    }
+
+    Scenario     scenario;
+    double       latTop;
+    double       lonLeft;
+    double       latBottom;
+    double       lonRight;
+    unsigned int zoom;
+
+    scenario.name=values[0];
+
+    if (!osmscout::StringToNumber(values[1],latTop) ||
+        !osmscout::StringToNumber(values[2],lonLeft) ||
+        !osmscout::StringToNumber(values[3],latBottom) ||
+        !osmscout::StringToNumber(values[4],lonRight)) {
+      std::cerr << args.scenarioFile << ":" << lineNumber << ": Cannot parse bounding box" << std::endl;
+      return false;
+    }
+
+    if (!osmscout::StringToNumber(values[5],zoom)) {
+      std::cerr << args.scenarioFile << ":" << lineNumber << ": Cannot parse zoom level '" << values[5] << "'" << std::endl;
+      return false;
+    }
+
+    scenario.coordTopLeft=osmscout::GeoCoord(latTop,lonLeft);
+    scenario.coordBottomRight=osmscout::GeoCoord(latBottom,lonRight);
+    scenario.zoom=osmscout::MagnificationLevel(zoom);
+    scenario.style=values[6]=="-" ? args.style : values[6];
+    scenario.driver=values[7]=="-" ? args.driver : values[7];
+    scenario.dpi=args.dpi;
+
+    if (values[8]!="-" &&
+        (!osmscout::StringToNumber(values[8],scenario.dpi) || scenario.dpi<=0)) {
+      std::cerr << args.scenarioFile << ":" << lineNumber << ": Invalid dpi '" << values[8] << "'" << std::endl;
+      return false;
+    }
+
+    scenarios.push_back(scenario);
+  }
+
+  return true;
+}
+
+/**
+ * Scenarios from the command line arguments: one scenario per zoom level
+ */
+void GetDefaultScenarios(const Arguments& args,
+                         std::vector<Scenario>& scenarios)
+{
+  for (osmscout::MagnificationLevel level=osmscout::MagnificationLevel(std::min(args.startZoom,args.endZoom));
+       level<=osmscout::MagnificationLevel(std::max(args.startZoom,args.endZoom));
+       level++) {
+    Scenario scenario;
+
+    scenario.name="level-"+std::to_string(level.Get());
+    scenario.coordTopLeft=args.coordTopLeft;
+    scenario.coordBottomRight=args.coordBottomRight;
+    scenario.zoom=level;
+    scenario.style=args.style;
+    scenario.driver=args.driver;
+    scenario.dpi=args.dpi;
+
+    scenarios.push_back(scenario);
+  }
+}
+
+/**
+ * Context of one run of a scenario, shared by all worker threads
+ */
+struct RunContext
+{
+  const Arguments&                    args;
+  const Scenario&                     scenario;
+  osmscout::Database&                 database;
+  osmscout::MapService&               mapService;
+  const osmscout::StyleConfig&        styleConfig;
+  const osmscout::AreaSearchParameter& searchParameter;
+  const osmscout::MapParameter&       drawParameter;
+  const std::vector<osmscout::OSMTileId>& tiles;
+  bool                                measure;
+
+  std::atomic<size_t>                 nextTile{0};
+  std::atomic<size_t>                 finishedTiles{0};
+  std::mutex                          outputMutex;
+
+  RunContext(const Arguments& args,
+             const Scenario& scenario,
+             osmscout::Database& database,
+             osmscout::MapService& mapService,
+             const osmscout::StyleConfig& styleConfig,
+             const osmscout::AreaSearchParameter& searchParameter,
+             const osmscout::MapParameter& drawParameter,
+             const std::vector<osmscout::OSMTileId>& tiles,
+             bool measure)
+  : args(args),
+    scenario(scenario),
+    database(database),
+    mapService(mapService),
+    styleConfig(styleConfig),
+    searchParameter(searchParameter),
+    drawParameter(drawParameter),
+    tiles(tiles),
+    measure(measure)
+  {
+    // no code
+  }
+};
+
+/**
+ * Loads and draws tiles from the context until all tiles are processed.
+ * Called in parallel by all worker threads, each with its own backend.
+ */
+void ProcessTiles(RunContext& context,
+                  PerformanceTestBackend& backend,
+                  RunResult& result)
+{
+  const Arguments&              args=context.args;
+  osmscout::Magnification       magnification(context.scenario.zoom);
+  osmscout::TileProjection      projection;
+  osmscout::MapParameter        drawParameter(context.drawParameter);
+  size_t                        tileCount=context.tiles.size();
+  size_t                        delta=std::max(tileCount/20,(size_t)1);
+
+  if (context.measure) {
+    drawParameter.SetRenderStatisticsCallback([&result](const osmscout::RenderStatistics& renderStatistics) {
+      result.renderStatistics.push_back(renderStatistics);
+    });
+  }
+
+  size_t index;
+
+  while ((index=context.nextTile++)<tileCount) {
+    const osmscout::OSMTileId& tile=context.tiles[index];
+    osmscout::MapData          data;
+    osmscout::OSMTileIdBox     tileBox(osmscout::OSMTileId(tile.GetX()-1,tile.GetY()-1),
+                                       osmscout::OSMTileId(tile.GetX()+1,tile.GetY()+1));
+
+    projection.Set(tile,
+                   magnification,
+                   context.scenario.dpi,
+                   args.TileWidth(),
+                   args.TileHeight());
+
+    projection.SetLinearInterpolationUsage(context.scenario.zoom.Get() >= 10);
+
+    for (size_t i=0; i<args.loadRepeat; i++) {
+      data.nodes.clear();
+      data.ways.clear();
+      data.areas.clear();
+
+      osmscout::StopClock dbTimer;
+
+      osmscout::GeoBox dataBoundingBox(tileBox.GetBoundingBox(magnification));
+
+      std::list<osmscout::TileRef> tiles;
+
+      context.mapService.LookupTiles(magnification, dataBoundingBox, tiles);
+      context.mapService.LoadMissingTileData(context.searchParameter, context.styleConfig, tiles);
+      context.mapService.AddTileDataToMapData(tiles, data);
+
+      dbTimer.Stop();
+
+      if (!context.measure) {
+        continue;
+      }
+
+      result.loadTimes.push_back(dbTimer.GetMilliseconds());
+
+#if defined(HAVE_LIB_GPERFTOOLS)
+      if (args.heapProfile) {
+        std::ostringstream buff;
+        buff << "load-" << context.scenario.name << "-" << tile.GetX() << "-" << tile.GetY();
+        HeapProfilerDump(buff.str().c_str());
+      }
+      struct mallinfo alloc_info = tc_mallinfo();
+#else
+#if defined(HAVE_MALLINFO)
+      struct mallinfo alloc_info = mallinfo();
+#endif
+#endif
+#if defined(HAVE_MALLINFO) || defined(HAVE_LIB_GPERFTOOLS)
+      result.allocMax = std::max(result.allocMax, (double) alloc_info.uordblks);
+#endif
+
+      // Flushing shared caches between tiles is only meaningful without concurrent loads,
+      // see the warning in main
+      if (args.flushCache && args.threads==1) {
+        tiles.clear(); // following flush method removes only tiles with use_count() == 1
+        context.mapService.FlushTileCache();
+
+        // simplest way howto flush database caches is close it and open again
+        context.database.Close();
+        if (!context.database.Open(args.databaseDirectory)) {
+          std::cerr << "Cannot open database" << std::endl;
+        }
+      }
+
+      if (args.flushDiskCache && args.threads==1) {
+        FlushDiskCache();
+      }
+    }
+
+    for (size_t i=0; i<args.drawRepeat; i++) {
+      osmscout::StopClock drawTimer;
+      backend.DrawMap(projection, drawParameter, data);
+      drawTimer.Stop();
+
+      if (context.measure) {
+        result.drawTimes.push_back(drawTimer.GetMilliseconds());
+      }
+    }
+
+    if (context.measure) {
+      result.nodeCount+=data.nodes.size();
+      result.wayCount+=data.ways.size();
+      result.areaCount+=data.areas.size();
+      result.tileCount++;
+    }
+
+    size_t finished=++context.finishedTiles;
+
+    if (context.measure && (finished % delta)==0) {
+      std::lock_guard<std::mutex> guard(context.outputMutex);
+
+      std::cout << finished*100/tileCount << "% " << finished << std::endl;
+    }
+  }
+}
+
+/**
+ * Executes one pass over all tiles of the scenario using the given backends (one thread per backend)
+ */
+RunResult ExecutePass(RunContext& context,
+                      const std::vector<PerformanceTestBackendPtr>& backends)
+{
+  std::vector<RunResult>   results(backends.size());
+  std::vector<std::thread> threads;
+  RunResult                result;
+  osmscout::StopClock      wallClock;
+
+  for (size_t i=1; i<backends.size(); i++) {
+    threads.emplace_back(ProcessTiles,
+                         std::ref(context),
+                         std::ref(*backends[i]),
+                         std::ref(results[i]));
+  }
+
+  // The first backend runs in the main thread, some drivers depend on it
+  ProcessTiles(context,
+               *backends[0],
+               results[0]);
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  wallClock.Stop();
+
+  for (const auto& threadResult : results) {
+    result.Merge(threadResult);
+  }
+
+  result.wallTime=wallClock.GetMilliseconds();
+
+  return result;
+}
+
+bool RunScenario(BackendCache& backendCache,
+                 const Arguments& args,
+                 const Scenario& scenario,
+                 const std::string& run,
+                 osmscout::Database& database,
+                 osmscout::MapService& mapService,
+                 osmscout::MemoryMonitor& memoryMonitor,
+                 RunResult& result)
+{
+  osmscout::StyleConfigRef styleConfig=backendCache.GetStyleConfig(database.GetTypeConfig(),
+                                                                   scenario.style);
+
+  if (!styleConfig) {
+    return false;
+  }
+
+  size_t threadCount=std::max(args.threads,(size_t)1);
+
+  if (threadCount>1 && IsSingleThreadedDriver(scenario.driver)) {
+    std::cerr << "Driver '" << scenario.driver << "' does not support multiple threads, using one thread" << std::endl;
+    threadCount=1;
+  }
+
+  std::vector<PerformanceTestBackendPtr> backends;
+
+  if (!backendCache.GetBackends(args,
+                                scenario,
+                                styleConfig,
+                                threadCount,
+                                backends)) {
+    return false;
+  }
+
+  osmscout::Magnification magnification(scenario.zoom);
+  osmscout::OSMTileId     tileA(osmscout::OSMTileId::GetOSMTile(magnification,
+                                                                osmscout::GeoCoord(scenario.coordBottomRight.GetLat(),
+                                                                                   scenario.coordTopLeft.GetLon())));
+  osmscout::OSMTileId     tileB(osmscout::OSMTileId::GetOSMTile(magnification,
+                                                                osmscout::GeoCoord(scenario.coordTopLeft.GetLat(),
+                                                                                   scenario.coordBottomRight.GetLon())));
+  osmscout::OSMTileIdBox  tileArea(tileA,tileB);
+
+  std::vector<osmscout::OSMTileId> tiles(tileArea.begin(),tileArea.end());
+
+  osmscout::MapParameter        drawParameter;
+  osmscout::AreaSearchParameter searchParameter;
+
+  // TODO: Use some way to find a valid font on the system (Agg display a ton of messages otherwise)
+  drawParameter.SetFontName("/usr/share/fonts/TTF/DejaVuSans.ttf");
+  searchParameter.SetUseMultithreading(true);
+
+  std::cout << "----------" << std::endl;
+  std::cout << "Scenario " << scenario.name << " (" << run << ", " << threadCount << " thread(s)): ";
+  std::cout << "level " << scenario.zoom << ", " << tiles.size() << " tiles " << tileArea.GetDisplayText() << std::endl;
+
+  if (run=="cold") {
+    mapService.FlushTileCache();
+
+    // simplest way howto flush database caches is close it and open again
+    database.Close();
+    if (!database.Open(args.databaseDirectory)) {
+      std::cerr << "Cannot open database" << std::endl;
+      return false;
+    }
+
+    if (args.flushDiskCache) {
+      FlushDiskCache();
+    }
+  }
+
+  // set cache size almost unlimited,
+  // for better estimate of peak memory usage by tile loading
+  mapService.SetCacheSize(10000000);
+
+  if (run=="warm") {
+    RunContext primingContext(args,
+                              scenario,
+                              database,
+                              mapService,
+                              *styleConfig,
+                              searchParameter,
+                              drawParameter,
+                              tiles,
+                              false);
+
+    ExecutePass(primingContext,backends);
+  }
+
+  RunContext context(args,
+                     scenario,
+                     database,
+                     mapService,
+                     *styleConfig,
+                     searchParameter,
+                     drawParameter,
+                     tiles,
+                     true);
+
+  memoryMonitor.Reset();
+
+  result=ExecutePass(context,backends);
+
+  memoryMonitor.GetMaxValue(result.peakVMUsage,
+                            result.peakResidentSet);
+
+  // set cache size back to default
+  mapService.SetCacheSize(25);
+
+  result.scenario=scenario.name;
+  result.run=run;
+  result.threads=threadCount;
+
+  return true;
+}
+
+void DumpPercentiles(const std::string& label,
+                     const Percentiles& percentiles)
+{
+  std::cout << " " << std::setw(22) << std::left << label << std::right << ": ";
+  std::cout << "min: " << percentiles.min << " ";
+  std::cout << "avg: " << percentiles.avg << " ";
+  std::cout << "p50: " << percentiles.p50 << " ";
+  std::cout << "p90: " << percentiles.p90 << " ";
+  std::cout << "p99: " << percentiles.p99 << " ";
+  std::cout << "max: " << percentiles.max << std::endl;
+}
+
+void DumpResult(const Arguments& args,
+                const RunResult& result)
+{
+  std::cout << "Scenario: " << result.scenario << " (" << result.run << ", " << result.threads << " thread(s))" << std::endl;
+  std::cout << "Tiles: " << result.tileCount << " (load " << args.loadRepeat << "x, drawn " << args.drawRepeat << "x)";
+  std::cout << " wall time: " << result.wallTime << " ms" << std::endl;
+
+  std::cout << " Peak memory: ";
+  std::cout << "RSS: " << osmscout::ByteSizeToString(result.peakResidentSet) << " ";
+  std::cout << "VM: " << osmscout::ByteSizeToString(result.peakVMUsage) << std::endl;
+
+#if defined(HAVE_MALLINFO) || defined(HAVE_LIB_GPERFTOOLS)
+  std::cout << " Used memory: ";
+  std::cout << "max: " << formatAlloc(result.allocMax) << std::endl;
+#endif
+
+  std::cout << " Tot. data  : ";
+  std::cout << "nodes: " << result.nodeCount << " ";
+  std::cout << "way: " << result.wayCount << " ";
+  std::cout << "areas: " << result.areaCount << std::endl;
+
+  if (result.tileCount>0) {
+    std::cout << " Avg. data  : ";
+    std::cout << "nodes: " << result.nodeCount/result.tileCount << " ";
+    std::cout << "way: " << result.wayCount/result.tileCount << " ";
+    std::cout << "areas: " << result.areaCount/result.tileCount << std::endl;
+  }
+
+  if (result.threads>1) {
+    std::cout << " DB times include waiting for concurrent loads of other threads" << std::endl;
+  }
+
+  DumpPercentiles("DB",Percentiles(result.loadTimes));
+  DumpPercentiles("Map",Percentiles(result.drawTimes));
+
+  if (!result.renderStatistics.empty()) {
+    osmscout::RenderStatistics total;
+
+    for (const auto& statistics : result.renderStatistics) {
+      total+=statistics;
+    }
+
+    size_t renderCount=result.renderStatistics.size();
+
+    std::cout << " Render avg.: ";
+    std::cout << "style lookups: " << total.styleLookups/renderCount << " ";
+    std::cout << "points: " << total.transformedPoints/renderCount << " ";
+    std::cout << "culled: " << total.culledObjects/renderCount << " ";
+    std::cout << "labels placed: " << total.labelsPlaced/renderCount << " ";
+    std::cout << "rejected: " << total.labelsRejected/renderCount << std::endl;
+
+    for (size_t step=osmscout::RenderSteps::FirstStep; step<=osmscout::RenderSteps::LastStep; step++) {
+      DumpPercentiles(std::string(" ")+osmscout::GetRenderStepName((osmscout::RenderSteps)step),
+                      Percentiles(result.GetStepTimes(step)));
+    }
+  }
+}
+
+/**
+ * Escapes the given string for usage as JSON string value
+ */
+std::string EscapeJsonString(const std::string& value)
+{
+  std::ostringstream stream;
+
+  for (char c : value) {
+    switch (c) {
+    case '"':
+      stream << "\\\"";
+      break;
+    case '\\':
+      stream << "\\\\";
+      break;
+    case '\n':
+      stream << "\\n";
+      break;
+    case '\r':
+      stream << "\\r";
+      break;
+    case '\t':
+      stream << "\\t";
+      break;
+    default:
+      if ((unsigned char)c<0x20) {
+        stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (unsigned int)c;
+        stream << std::dec << std::setfill(' ');
+      }
+      else {
+        stream << c;
+      }
+    }
+  }
+
+  return stream.str();
+}
+
+std::string PercentilesToJson(const Percentiles& percentiles)
+{
+  std::ostringstream stream;
+
+  stream.imbue(std::locale::classic());
+  stream << "{\"min\":" << percentiles.min;
+  stream << ",\"avg\":" << percentiles.avg;
+  stream << ",\"p50\":" << percentiles.p50;
+  stream << ",\"p90\":" << percentiles.p90;
+  stream << ",\"p99\":" << percentiles.p99;
+  stream << ",\"max\":" << percentiles.max << "}";
+
+  return stream.str();
+}
+
+/**
+ * Writes the results as JSON. Each result is written to one line, so that the file
+ * can be read back as a baseline without a full JSON parser.
+ */
+bool WriteJson(const std::string& filename,
+               const std::list<RunResult>& results)
+{
+  std::ofstream stream(filename);
+
+  if (!stream) {
+    std::cerr << "Cannot open '" << filename << "' for writing" << std::endl;
+    return false;
+  }
+
+  stream.imbue(std::locale::classic());
+  stream << "{\"version\":1,\"results\":[" << std::endl;
+
+  for (auto result=results.begin(); result!=results.end(); ++result) {
+    stream << "{\"scenario\":\"" << EscapeJsonString(result->scenario) << "\"";
+    stream << ",\"run\":\"" << EscapeJsonString(result->run) << "\"";
+    stream << ",\"threads\":" << result->threads;
+    stream << ",\"tiles\":" << result->tileCount;
+    stream << ",\"wallTime\":" << result->wallTime;
+    stream << ",\"peakRSS\":" << (uint64_t)result->peakResidentSet;
+    stream << ",\"peakVM\":" << (uint64_t)result->peakVMUsage;
+    stream << ",\"load\":" << PercentilesToJson(Percentiles(result->loadTimes));
+    stream << ",\"draw\":" << PercentilesToJson(Percentiles(result->drawTimes));
+    stream << ",\"steps\":{";
+    for (size_t step=osmscout::RenderSteps::FirstStep; step<=osmscout::RenderSteps::LastStep; step++) {
+      if (step!=osmscout::RenderSteps::FirstStep) {
+        stream << ",";
+      }
+      stream << "\"" << osmscout::GetRenderStepName((osmscout::RenderSteps)step) << "\":";
+      stream << PercentilesToJson(Percentiles(result->GetStepTimes(step)));
+    }
+    stream << "}";
+    stream << ",\"counts\":{\"nodes\":" << result->nodeCount;
+    stream << ",\"ways\":" << result->wayCount;
+    stream << ",\"areas\":" << result->areaCount << "}";
+    stream << "}";
+
+    if (std::next(result)!=results.end()) {
+      stream << ",";
+    }
+
+    stream << std::endl;
+  }
+
+  stream << "]}" << std::endl;
+
+  return !stream.fail();
+}
+
+/**
+ * Returns the string value of the given key in the JSON line
+ */
+bool GetJsonString(const std::string& line,
+                   const std::string& key,
+                   std::string& value)
+{
+  std::string            pattern="\""+key+"\":\"";
+  std::string::size_type start=line.find(pattern);
+
+  if (start==std::string::npos) {
+    return false;
+  }
+
+  start+=pattern.length();
+
+  value.clear();
+
+  for (std::string::size_type pos=start; pos<line.length(); pos++) {
+    char c=line[pos];
+
+    if (c=='"') {
+      return true;
+    }
+
+    if (c!='\\') {
+      value+=c;
+      continue;
+    }
+
+    if (++pos>=line.length()) {
+      return false;
+    }
+
+    switch (line[pos]) {
+    case 'n':
+      value+='\n';
+      break;
+    case 'r':
+      value+='\r';
+      break;
+    case 't':
+      value+='\t';
+      break;
+    case 'u':
+      {
+        unsigned long code;
+
+        if (pos+4>=line.length()) {
+          return false;
+        }
+
+        code=std::strtoul(line.substr(pos+1,4).c_str(),nullptr,16);
+
+        // only control characters are escaped this way by EscapeJsonString
+        value+=(char)code;
+        pos+=4;
+      }
+      break;
+    default:
+      value+=line[pos];
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Returns the numeric value of the given top level key in the JSON line
+ */
+bool GetJsonNumber(const std::string& line,
+                   const std::string& key,
+                   size_t& value)
+{
+  std::string            pattern="\""+key+"\":";
+  std::string::size_type start=line.find(pattern);
+
+  if (start==std::string::npos) {
+    return false;
+  }
+
+  start+=pattern.length();
+
+  std::string::size_type end=line.find_first_of(",}",start);
+
+  return osmscout::StringToNumber(line.substr(start,end-start),value);
+}
+
+/**
+ * Returns the numeric value of the given key of the given (top level) object in the JSON line
+ */
+bool GetJsonNumber(const std::string& line,
+                   const std::string& object,
+                   const std::string& key,
+                   double& value)
+{
+  std::string::size_type objectStart=line.find("\""+object+"\":{");
+
+  if (objectStart==std::string::npos) {
+    return false;
+  }
+
+  std::string::size_type objectEnd=line.find('}',objectStart);
+  std::string            pattern="\""+key+"\":";
+  std::string::size_type start=line.find(pattern,objectStart);
+
+  if (start==std::string::npos ||
+      start>objectEnd) {
+    return false;
+  }
+
+  start+=pattern.length();
+
+  std::string::size_type end=line.find_first_of(",}",start);
+
+  return osmscout::StringToNumber(line.substr(start,end-start),value);
+}
+
+bool ReadBaseline(const std::string& filename,
+                  std::map<std::string,BaselineResult>& baseline)
+{
+  std::ifstream stream(filename);
+
+  if (!stream) {
+    std::cerr << "Cannot open baseline '" << filename << "'" << std::endl;
+    return false;
+  }
+
+  std::string line;
+
+  while (std::getline(stream,line)) {
+    std::string    scenario;
+    std::string    run;
+    size_t         threads;
+    BaselineResult result;
+
+    if (!GetJsonString(line,"scenario",scenario) ||
+        !GetJsonString(line,"run",run)) {
+      continue;
+    }
+
+    if (!GetJsonNumber(line,"threads",threads)) {
+      threads=1;
+    }
+
+    if (!GetJsonNumber(line,"load","p50",result.load.p50) ||
+        !GetJsonNumber(line,"load","p90",result.load.p90) ||
+        !GetJsonNumber(line,"draw","p50",result.draw.p50) ||
+        !GetJsonNumber(line,"draw","p90",result.draw.p90)) {
+      std::cerr << "Cannot parse baseline entry for '" << scenario << "/" << run << "/" << threads << "'" << std::endl;
+      return false;
+    }
+
+    baseline[scenario+"/"+run+"/"+std::to_string(threads)]=result;
+  }
+
+  return true;
+}
+
+/**
+ * Compares a value against its baseline, returns false if it is slower than the tolerance permits
+ */
+bool CompareValue(const std::string& label,
+                  double baseline,
+                  double value,
+                  double tolerance)
+{
+  double change=baseline>0.0 ? (value-baseline)*100.0/baseline : 0.0;
+  bool   regression=change>tolerance;
+
+  std::cout << " " << std::setw(10) << std::left << label << std::right << ": ";
+  std::cout << baseline << " => " << value << " (";
+  std::cout << std::showpos << std::fixed << std::setprecision(1) << change << "%";
+  std::cout << std::noshowpos << std::defaultfloat << std::setprecision(6) << ")";
+
+  if (regression) {
+    std::cout << " REGRESSION";
+  }
+
+  std::cout << std::endl;
+
+  return !regression;
+}
+
+/**
+ * Compares the results against the baseline, returns false if there is a regression
+ */
+bool CompareWithBaseline(const Arguments& args,
+                         const std::list<RunResult>& results,
+                         const std::map<std::string,BaselineResult>& baseline)
+{
+  bool success=true;
+
+  std::cout << "==========" << std::endl;
+  std::cout << "Comparing with baseline '" << args.baselineFile << "', tolerance " << args.tolerance << "%" << std::endl;
+
+  for (const auto& result : results) {
+    auto entry=baseline.find(result.GetKey());
+
+    if (entry==baseline.end()) {
+      std::cout << result.GetKey() << ": not in baseline" << std::endl;
+      continue;
+    }
+
+    Percentiles load(result.loadTimes);
+    Percentiles draw(result.drawTimes);
+
+    std::cout << result.GetKey() << ":" << std::endl;
+
+    success&=CompareValue("DB p50",entry->second.load.p50,load.p50,args.tolerance);
+    success&=CompareValue("DB p90",entry->second.load.p90,load.p90,args.tolerance);
+    success&=CompareValue("Map p50",entry->second.draw.p50,draw.p50,args.tolerance);
+    success&=CompareValue("Map p90",entry->second.draw.p90,draw.p90,args.tolerance);
+  }
+
+  return success;
+}
+
 int main(int argc, char* argv[])
 {
   osmscout::CmdLineParser     argParser("PerformanceTest",
@@ -540,6 +1582,43 @@ int main(int argc, char* argv[])
                       "Cache size for areas, default: " + std::to_string(databaseParameter.GetAreaDataCacheSize()),
                       false);
 
+  argParser.AddOption(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                        args.scenarioFile=value;
+                      }),
+                      "scenario",
+                      "File with benchmark scenarios, default: one scenario per zoom level of the bounding box",
+                      false);
+  argParser.AddOption(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                        args.runs=value;
+                      }),
+                      "runs",
+                      "Runs per scenario (cold|warm|cold,warm), default: " + args.runs,
+                      false);
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&args](const size_t& value) {
+                        args.threads=std::max(value,(size_t)1);
+                      }),
+                      "threads",
+                      "Number of rendering threads, default: " + std::to_string(args.threads),
+                      false);
+  argParser.AddOption(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                        args.jsonFile=value;
+                      }),
+                      "json",
+                      "Write results as JSON to the given file",
+                      false);
+  argParser.AddOption(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                        args.baselineFile=value;
+                      }),
+                      "baseline",
+                      "Compare results with the given JSON file, fail on regression",
+                      false);
+  argParser.AddOption(osmscout::CmdLineDoubleOption([&args](const double& value) {
+                        args.tolerance=value;
+                      }),
+                      "tolerance",
+                      "Permitted slowdown against the baseline in percent, default: " + std::to_string(args.tolerance),
+                      false);
+
 #if defined(HAVE_LIB_GPERFTOOLS)
   argParser.AddOption(osmscout::CmdLineStringOption([&args](const std::string& value) {
                         args.heapProfilePrefix = value;
@@ -585,186 +1664,75 @@ int main(int argc, char* argv[])
   osmscout::log.Debug(args.debug);
   //databaseParameter.SetDebugPerformance(true);
 
-  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
-  osmscout::MapServiceRef     mapService=std::make_shared<osmscout::MapService>(database);
-
-  if (!database->Open(args.databaseDirectory)) {
-    std::cerr << "Cannot open database" << std::endl;
-    return 1;
+  if (args.threads>1 &&
+      (args.flushCache || args.flushDiskCache)) {
+    std::cerr << "WARNING: With more than one thread caches are not flushed after each data load, --flush-cache and --flush-disk apply just before cold runs" << std::endl;
   }
 
-  osmscout::StyleConfigRef styleConfig=std::make_shared<osmscout::StyleConfig>(database->GetTypeConfig());
+  std::vector<std::string> runs;
 
-  if (!styleConfig->Load(args.style)) {
-    std::cerr << "Cannot open style" << std::endl;
-    return 1;
-  }
+  for (const auto& run : osmscout::SplitString(args.runs,",")) {
+    if (run!="cold" && run!="warm") {
+      std::cerr << "Unsupported run '" << run << "', expected 'cold' or 'warm'" << std::endl;
+      return 1;
+    }
 
-  PerformanceTestBackendPtr backendPtr = PrepareBackend(argc, argv, args, styleConfig);
-  if (!backendPtr){
-    return 1;
+    runs.push_back(run);
   }
 
-#if defined(HAVE_LIB_GPERFTOOLS)
-  if (args.heapProfile){
-    HeapProfilerStart(args.heapProfilePrefix.c_str());
-  }
-#endif
+  std::vector<Scenario> scenarios;
 
-  osmscout::TileProjection      projection;
-  osmscout::MapParameter        drawParameter;
-  osmscout::AreaSearchParameter searchParameter;
-  std::list<LevelStats>         statistics;
-
-  // TODO: Use some way to find a valid font on the system (Agg display a ton of messages otherwise)
-  drawParameter.SetFontName("/usr/share/fonts/TTF/DejaVuSans.ttf");
-  searchParameter.SetUseMultithreading(true);
-
-  for (osmscout::MagnificationLevel level=osmscout::MagnificationLevel(std::min(args.startZoom,args.endZoom));
-       level<=osmscout::MagnificationLevel(std::max(args.startZoom,args.endZoom));
-       level++) {
-    LevelStats              stats(level.Get());
-    osmscout::Magnification magnification(level);
-
-    osmscout::OSMTileId     tileA(osmscout::OSMTileId::GetOSMTile(magnification,
-                                                                  osmscout::GeoCoord(args.LatBottom(),args.LonLeft())));
-    osmscout::OSMTileId     tileB(osmscout::OSMTileId::GetOSMTile(magnification,
-                                                                  osmscout::GeoCoord(args.LatTop(),args.LonRight())));
-    osmscout::OSMTileIdBox  tileArea(tileA,tileB);
-
-    std::cout << "----------" << std::endl;
-    std::cout << "Drawing level " << level << ", " << tileArea.GetCount() << " tiles " << tileArea.GetDisplayText() << std::endl;
-
-    size_t current=1;
-    size_t tileCount=tileArea.GetCount();
-    size_t delta=tileCount/20;
-
-    if (delta==0) {
-      delta=1;
+  if (!args.scenarioFile.empty()) {
+    if (!ReadScenarios(args,scenarios)) {
+      return 1;
     }
+  }
+  else {
+    GetDefaultScenarios(args,scenarios);
+  }
 
-    for (const auto& tile : tileArea) {
-      osmscout::MapData       data;
-      osmscout::OSMTileIdBox  tileBox(osmscout::OSMTileId(tile.GetX()-1,tile.GetY()-1),
-                                      osmscout::OSMTileId(tile.GetX()+1,tile.GetY()+1));
-      osmscout::GeoBox        boundingBox;
-
-      if ((current % delta)==0) {
-        std::cout << current*100/tileCount << "% " << current;
-
-        if (stats.tileCount>0) {
-          std::cout << " " << stats.dbTotalTime/stats.tileCount;
-          std::cout << " " << stats.drawTotalTime/stats.tileCount;
-        }
-
-        std::cout << std::endl;
-      }
-
-      projection.Set(tile,
-                     magnification,
-                     args.dpi,
-                     args.TileWidth(),
-                     args.TileHeight());
-
-      projection.GetDimensions(boundingBox);
-      projection.SetLinearInterpolationUsage(level.Get() >= 10);
-
-      for (size_t i=0; i<args.loadRepeat; i++) {
-        data.nodes.clear();
-        data.ways.clear();
-        data.areas.clear();
-
-        osmscout::StopClock dbTimer;
-
-        osmscout::GeoBox dataBoundingBox(tileBox.GetBoundingBox(magnification));
+  std::map<std::string,BaselineResult> baseline;
 
-        std::list<osmscout::TileRef> tiles;
+  if (!args.baselineFile.empty() &&
+      !ReadBaseline(args.baselineFile,baseline)) {
+    return 1;
+  }
 
-        // set cache size almost unlimited,
-        // for better estimate of peak memory usage by tile loading
-        mapService->SetCacheSize(10000000);
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
+  osmscout::MapServiceRef     mapService=std::make_shared<osmscout::MapService>(database);
 
-        mapService->LookupTiles(magnification, dataBoundingBox, tiles);
-        mapService->LoadMissingTileData(searchParameter, *styleConfig, tiles);
-        mapService->AddTileDataToMapData(tiles, data);
+  if (!database->Open(args.databaseDirectory)) {
+    std::cerr << "Cannot open database" << std::endl;
+    return 1;
+  }
 
 #if defined(HAVE_LIB_GPERFTOOLS)
-        if (args.heapProfile) {
-          std::ostringstream buff;
-          buff << "load-" << level << "-" << tile.GetX() << "-" << tile.GetY();
-          HeapProfilerDump(buff.str().c_str());
-        }
-        struct mallinfo alloc_info = tc_mallinfo();
-#else
-#if defined(HAVE_MALLINFO)
-        struct mallinfo alloc_info = mallinfo();
-#endif
-#endif
-#if defined(HAVE_MALLINFO) || defined(HAVE_LIB_GPERFTOOLS)
-        std::cout << "memory usage: " << formatAlloc(alloc_info.uordblks) << std::endl;
-        stats.allocMax = std::max(stats.allocMax, (double) alloc_info.uordblks);
-        stats.allocSum = stats.allocSum + (double) alloc_info.uordblks;
+  if (args.heapProfile){
+    HeapProfilerStart(args.heapProfilePrefix.c_str());
+  }
 #endif
 
-        // set cache size back to default
-        mapService->SetCacheSize(25);
-        dbTimer.Stop();
-
-        double dbTime = dbTimer.GetMilliseconds();
-
-        stats.dbMinTime = std::min(stats.dbMinTime, dbTime);
-        stats.dbMaxTime = std::max(stats.dbMaxTime, dbTime);
-        stats.dbTotalTime += dbTime;
-
-        if (args.flushCache) {
-          tiles.clear(); // following flush method removes only tiles with use_count() == 1
-          mapService->FlushTileCache();
-
-          // simplest way howto flush database caches is close it and open again
-          database->Close();
-          if (!database->Open(args.databaseDirectory)) {
-            std::cerr << "Cannot open database" << std::endl;
-            return 1;
-          }
-        }
-        if (args.flushDiskCache) {
-          // Linux specific
-          if (osmscout::ExistsInFilesystem("/proc/sys/vm/drop_caches")){
-            osmscout::FileWriter f;
-            try {
-              f.Open("/proc/sys/vm/drop_caches");
-              f.Write(std::string("3"));
-              f.Close();
-            }catch(const osmscout::IOException &e){
-              std::cerr << "Can't flush disk cache: " << e.what() << std::endl;
-            }
-          }else{
-            std::cerr << "Can't flush disk cache, \"/proc/sys/vm/drop_caches\" file don't exists" << std::endl;
-          }
-        }
-      }
-
-      stats.nodeCount+=data.nodes.size();
-      stats.wayCount+=data.ways.size();
-      stats.areaCount+=data.areas.size();
-
-      stats.tileCount++;
-      for (size_t i=0; i<args.drawRepeat; i++) {
-        osmscout::StopClock drawTimer;
-        backendPtr->DrawMap(projection, drawParameter, data);
-        drawTimer.Stop();
-
-        double drawTime = drawTimer.GetMilliseconds();
-
-        stats.drawMinTime = std::min(stats.drawMinTime, drawTime);
-        stats.drawMaxTime = std::max(stats.drawMaxTime, drawTime);
-        stats.drawTotalTime += drawTime;
+  osmscout::MemoryMonitor memoryMonitor;
+  BackendCache            backendCache(argc,argv);
+  std::list<RunResult>    results;
+
+  for (const auto& scenario : scenarios) {
+    for (const auto& run : runs) {
+      RunResult result;
+
+      if (!RunScenario(backendCache,
+                       args,
+                       scenario,
+                       run,
+                       *database,
+                       *mapService,
+                       memoryMonitor,
+                       result)) {
+        return 1;
       }
 
-      current++;
+      results.push_back(result);
     }
-
-    statistics.push_back(stats);
   }
 
 #if defined(HAVE_LIB_GPERFTOOLS)
@@ -775,46 +1743,21 @@ int main(int argc, char* argv[])
 
   std::cout << "==========" << std::endl;
 
-  for (const auto& stats : statistics) {
-    std::cout << "Level: " << stats.level << std::endl;
-    std::cout << "Tiles: " << stats.tileCount << " (load " << args.loadRepeat << "x, drawn " << args.drawRepeat << "x)" << std::endl;
-
-#if defined(HAVE_MALLINFO) || defined(HAVE_LIB_GPERFTOOLS)
-    std::cout << " Used memory: ";
-    std::cout << "max: " << formatAlloc(stats.allocMax) << " ";
-    std::cout << "avg: " << formatAlloc(stats.allocSum / (stats.tileCount * args.loadRepeat)) << std::endl;
-#endif
-
-    std::cout << " Tot. data  : ";
-    std::cout << "nodes: " << stats.nodeCount << " ";
-    std::cout << "way: " << stats.wayCount << " ";
-    std::cout << "areas: " << stats.areaCount << std::endl;
-
-    if (stats.tileCount>0) {
-      std::cout << " Avg. data  : ";
-      std::cout << "nodes: " << stats.nodeCount/stats.tileCount << " ";
-      std::cout << "way: " << stats.wayCount/stats.tileCount << " ";
-      std::cout << "areas: " << stats.areaCount/stats.tileCount << std::endl;
-    }
+  for (const auto& result : results) {
+    DumpResult(args,result);
+  }
 
-    std::cout << " DB         : ";
-    std::cout << "total: " << stats.dbTotalTime << " ";
-    std::cout << "min: " << stats.dbMinTime << " ";
-    if (stats.tileCount>0) {
-      std::cout << "avg: " << stats.dbTotalTime/(stats.tileCount * args.loadRepeat) << " ";
-    }
-    std::cout << "max: " << stats.dbMaxTime << " " << std::endl;
+  database->Close();
 
-    std::cout << " Map        : ";
-    std::cout << "total: " << stats.drawTotalTime << " ";
-    std::cout << "min: " << stats.drawMinTime << " ";
-    if (stats.tileCount>0) {
-      std::cout << "avg: " << stats.drawTotalTime/(stats.tileCount * args.drawRepeat) << " ";
-    }
-    std::cout << "max: " << stats.drawMaxTime << std::endl;
+  if (!args.jsonFile.empty() &&
+      !WriteJson(args.jsonFile,results)) {
+    return 1;
   }
 
-  database->Close();
+  if (!args.baselineFile.empty() &&
+      !CompareWithBaseline(args,results,baseline)) {
+    return 2;
+  }
 
   return 0;
 }
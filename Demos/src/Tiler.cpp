@@ -293,6 +293,8 @@ int main(int argc, char* argv[])
     double maxTime=0.0;
     double totalTime=0.0;
 
+    osmscout::RenderStatistics renderStatistics;
+
     osmscout::MapService::TypeDefinition typeDefinition;
 
     for (const auto& type : database->GetTypeConfig()->GetTypes()) {
@@ -406,6 +408,8 @@ int main(int argc, char* argv[])
 
         timer.Stop();
 
+        renderStatistics+=painter.GetRenderStatistics();
+
         double time=timer.GetMilliseconds();
 
         minTime=std::min(minTime,time);
@@ -434,6 +438,13 @@ int main(int argc, char* argv[])
     std::cout << "min: " << minTime << " msec ";
     std::cout << "avg: " << totalTime/(xTileCount*yTileCount) << " msec ";
     std::cout << "max: " << maxTime << " msec" << std::endl;
+
+    std::cout << "=> Render: ";
+    std::cout << "areas: " << renderStatistics.stepTime[osmscout::RenderSteps::DrawAreas] << " msec ";
+    std::cout << "ways: " << renderStatistics.stepTime[osmscout::RenderSteps::DrawWays] << " msec ";
+    std::cout << "labels: " << renderStatistics.stepTime[osmscout::RenderSteps::DrawLabels] << " msec ";
+    std::cout << "placed: " << renderStatistics.labelsPlaced << " ";
+    std::cout << "rejected: " << renderStatistics.labelsRejected << std::endl;
   }
 
   database->Close();
@@ -85,6 +85,8 @@ void DumpHelp(osmscout::ImportParameter& parameter)
 
   std::cout << " --rawCoordBlockSize <number>         number of raw coords resolved in block (default: " << parameter.GetRawCoordBlockSize() << ")" << std::endl;
 
+  std::cout << " --allDataMemoryMaped true|false      memory maped access for all data files (default: " << osmscout::BoolToString(parameter.GetAllDataMemoryMaped()) << ")" << std::endl;
+
   std::cout << " --rawNodeDataMemoryMaped true|false  memory maped raw node data file access (default: " << osmscout::BoolToString(parameter.GetRawNodeDataMemoryMaped()) << ")" << std::endl;
 
   std::cout << " --rawWayIndexMemoryMaped true|false  memory maped raw way index file access (default: " << osmscout::BoolToString(parameter.GetRawWayIndexMemoryMaped()) << ")" << std::endl;
@@ -109,6 +111,10 @@ void DumpHelp(osmscout::ImportParameter& parameter)
   std::cout << " --wayDataCacheSize <number>          way data cache size (default: " << parameter.GetWayDataCacheSize() << ")" << std::endl;
 
   std::cout << " --routeNodeBlockSize <number>        number of route nodes resolved in block (default: " << parameter.GetRouteNodeBlockSize() << ")" << std::endl;
+
+  std::cout << " --lodData true|false                 generate simplified way and area geometries (default: " << osmscout::BoolToString(parameter.GetLODData()) << ")" << std::endl;
+  std::cout << " --lodMinMag <number>                 magnification of coarsest simplified geometries (default: " << parameter.GetLODMinMag().Get() << ")" << std::endl;
+  std::cout << " --lodMaxMag <number>                 magnification of finest simplified geometries (default: " << parameter.GetLODMaxMag().Get() << ")" << std::endl;
   std::cout << std::endl;
   std::cout << " --langOrder <#|lang1[,#|lang2]..>    language order when parsing lang[:language] and place_name[:language] tags" << std::endl
             << "                                      # is the default language (no :language) (default: #)" << std::endl;
@@ -272,6 +278,9 @@ static void DumpParameter(const osmscout::ImportParameter& parameter,
   progress.Info(std::string("RawCoordBlockSize: ")+
                 std::to_string(parameter.GetRawCoordBlockSize()));
 
+  progress.Info(std::string("AllDataMemoryMaped: ")+
+                (parameter.GetAllDataMemoryMaped() ? "true" : "false"));
+
   progress.Info(std::string("RawNodeDataMemoryMaped: ")+
                 (parameter.GetRawNodeDataMemoryMaped() ? "true" : "false"));
 
@@ -323,6 +332,13 @@ static void DumpParameter(const osmscout::ImportParameter& parameter,
   progress.Info(std::string("RouteNodeBlockSize: ")+
                 std::to_string(parameter.GetRouteNodeBlockSize()));
 
+  progress.Info(std::string("LODData: ")+
+                (parameter.GetLODData() ? "true" : "false"));
+  progress.Info("LODMinMag: "+
+                std::to_string(parameter.GetLODMinMag().Get()));
+  progress.Info("LODMaxMag: "+
+                std::to_string(parameter.GetLODMaxMag().Get()));
+
 
   progress.Info(std::string("MaxAdminLevel: ")+
                 std::to_string(parameter.GetMaxAdminLevel()));
@@ -585,6 +601,19 @@ int main(int argc, char* argv[])
         parameterError=true;
       }
     }
+    else if (strcmp(argv[i],"--allDataMemoryMaped")==0) {
+      bool allDataMemoryMaped;
+
+      if (osmscout::ParseBoolArgument(argc,
+                                      argv,
+                                      i,
+                                      allDataMemoryMaped)) {
+        parameter.SetAllDataMemoryMaped(allDataMemoryMaped);
+      }
+      else {
+        parameterError=true;
+      }
+    }
     else if (strcmp(argv[i],"--rawNodeDataMemoryMaped")==0) {
       bool rawNodeDataMemoryMaped;
 
@@ -798,6 +827,45 @@ int main(int argc, char* argv[])
         parameterError=true;
       }
     }
+    else if (strcmp(argv[i],"--lodData")==0) {
+      bool lodData;
+
+      if (osmscout::ParseBoolArgument(argc,
+                                      argv,
+                                      i,
+                                      lodData)) {
+        parameter.SetLODData(lodData);
+      }
+      else {
+        parameterError=true;
+      }
+    }
+    else if (strcmp(argv[i],"--lodMinMag")==0) {
+      uint32_t lodMinMag;
+
+      if (osmscout::ParseUInt32Argument(argc,
+                                        argv,
+                                        i,
+                                        lodMinMag)) {
+        parameter.SetLODMinMag(osmscout::MagnificationLevel(lodMinMag));
+      }
+      else {
+        parameterError=true;
+      }
+    }
+    else if (strcmp(argv[i],"--lodMaxMag")==0) {
+      uint32_t lodMaxMag;
+
+      if (osmscout::ParseUInt32Argument(argc,
+                                        argv,
+                                        i,
+                                        lodMaxMag)) {
+        parameter.SetLODMaxMag(osmscout::MagnificationLevel(lodMaxMag));
+      }
+      else {
+        parameterError=true;
+      }
+    }
     else if (strcmp(argv[i],"--langOrder")==0) {
         std::vector<std::string> langOrder;
 
@@ -0,0 +1,297 @@
+/*
+  AreaWayIndex - a test program for libosmscout
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <algorithm>
+#include <random>
+
+#include <osmscout/AreaWayIndex.h>
+#include <osmscout/WayDataFile.h>
+
+#include <osmscout/import/GenAreaWayIndex.h>
+
+#include <osmscout/util/File.h>
+#include <osmscout/util/FileWriter.h>
+
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+static const osmscout::MagnificationLevel minLevel(10);
+static const osmscout::MagnificationLevel maxLevel(11);
+
+/**
+ * Writes a ways.dat to the current directory and indexes it:
+ *
+ * - "test_sparse" ways are spread over most of the world, but leave out
+ *   a band of latitudes. Its tile box is too big for a presence summary
+ *   with one bit per tile.
+ * - "test_local" ways cover a small region, they are indexed at the same
+ *   level as "test_sparse".
+ * - "test_dense" ways are all placed in the same tile, the type is moved
+ *   to the next index level.
+ */
+class TestData
+{
+public:
+  struct WayEntry
+  {
+    osmscout::FileOffset  offset;
+    osmscout::TypeInfoRef type;
+    osmscout::GeoBox      boundingBox;
+  };
+
+  osmscout::TypeConfigRef typeConfig;
+  osmscout::TypeInfoRef   sparseType;
+  osmscout::TypeInfoRef   localType;
+  osmscout::TypeInfoRef   denseType;
+  std::vector<WayEntry>   ways;
+
+private:
+  void AddWay(osmscout::FileWriter& writer,
+              const osmscout::TypeInfoRef& type,
+              const osmscout::GeoCoord& from,
+              const osmscout::GeoCoord& to)
+  {
+    osmscout::Way way;
+
+    way.SetType(type);
+    way.nodes.emplace_back(0,from);
+    way.nodes.emplace_back(0,to);
+
+    ways.push_back({writer.GetPos(),type,way.GetBoundingBox()});
+
+    way.Write(*typeConfig,writer);
+  }
+
+public:
+  TestData()
+  : typeConfig(std::make_shared<osmscout::TypeConfig>())
+  {
+    sparseType=std::make_shared<osmscout::TypeInfo>("test_sparse");
+    localType=std::make_shared<osmscout::TypeInfo>("test_local");
+    denseType=std::make_shared<osmscout::TypeInfo>("test_dense");
+
+    for (const auto& type : {sparseType,localType,denseType}) {
+      type->CanBeWay(true);
+      typeConfig->RegisterType(type);
+    }
+
+    osmscout::FileWriter writer;
+    std::mt19937         random(4711);
+
+    std::uniform_real_distribution<double> lonDistribution(-170.0,170.0);
+    std::uniform_real_distribution<double> latDistribution(-70.0,70.0);
+    std::uniform_real_distribution<double> localDistribution(0.0,1.0);
+    std::uniform_real_distribution<double> lengthDistribution(0.0,0.5);
+
+    writer.Open(osmscout::WayDataFile::WAYS_DAT);
+    writer.Write((uint32_t)0);
+
+    for (size_t i=0; i<2000; i++) {
+      double lat=latDistribution(random);
+
+      // leave a band without any data
+      if (lat>10.0 && lat<30.0) {
+        continue;
+      }
+
+      double lon=lonDistribution(random);
+
+      AddWay(writer,
+             sparseType,
+             osmscout::GeoCoord(lat,lon),
+             osmscout::GeoCoord(lat+lengthDistribution(random),lon+lengthDistribution(random)));
+    }
+
+    for (size_t i=0; i<300; i++) {
+      double lat=50.0+localDistribution(random);
+      double lon=8.0+localDistribution(random);
+
+      AddWay(writer,
+             localType,
+             osmscout::GeoCoord(lat,lon),
+             osmscout::GeoCoord(lat+0.01,lon+0.01));
+    }
+
+    for (size_t i=0; i<200; i++) {
+      AddWay(writer,
+             denseType,
+             osmscout::GeoCoord(-40.001,-60.001),
+             osmscout::GeoCoord(-40.002,-60.002));
+    }
+
+    writer.SetPos(0);
+    writer.Write((uint32_t)ways.size());
+    writer.Close();
+
+    osmscout::ImportParameter       parameter;
+    osmscout::SilentProgress        progress;
+    osmscout::AreaWayIndexGenerator generator;
+
+    parameter.SetDestinationDirectory(".");
+    parameter.SetAreaWayMinMag(minLevel);
+    parameter.SetAreaWayIndexMaxLevel(maxLevel);
+
+    REQUIRE(generator.Import(typeConfig,
+                             parameter,
+                             progress));
+  }
+
+  ~TestData()
+  {
+    osmscout::RemoveFile(osmscout::WayDataFile::WAYS_DAT);
+    osmscout::RemoveFile(osmscout::AreaWayIndex::AREA_WAY_IDX);
+  }
+
+  /**
+   * Offsets of all ways of the given types, whose tiles at the index level of
+   * their type intersect the tiles of the given area.
+   */
+  std::vector<osmscout::FileOffset> GetExpectedOffsets(const osmscout::GeoBox& boundingBox,
+                                                       const osmscout::TypeInfoSet& types) const
+  {
+    std::vector<osmscout::FileOffset> offsets;
+
+    for (const auto& way : ways) {
+      if (!types.IsSet(way.type)) {
+        continue;
+      }
+
+      osmscout::Magnification magnification(way.type==denseType ? maxLevel : minLevel);
+      osmscout::TileIdBox     wayTileBox(magnification,way.boundingBox);
+      osmscout::TileIdBox     queryTileBox(magnification,boundingBox);
+
+      if (wayTileBox.Intersects(queryTileBox)) {
+        offsets.push_back(way.offset);
+      }
+    }
+
+    return offsets;
+  }
+};
+
+static void CheckOffsets(const TestData& data,
+                         const osmscout::AreaWayIndex& index,
+                         const osmscout::GeoBox& boundingBox,
+                         const osmscout::TypeInfoSet& types)
+{
+  std::vector<osmscout::FileOffset> offsets;
+  osmscout::TypeInfoSet             loadedTypes;
+
+  REQUIRE(index.GetOffsets(boundingBox,
+                           types,
+                           offsets,
+                           loadedTypes));
+
+  REQUIRE(offsets==data.GetExpectedOffsets(boundingBox,types));
+  REQUIRE(loadedTypes==types);
+}
+
+TEST_CASE("Random areas match an unfiltered scan")
+{
+  TestData               data;
+  osmscout::AreaWayIndex index;
+
+  REQUIRE(index.Open(data.typeConfig,".",false));
+
+  std::vector<osmscout::TypeInfoSet> typeSets;
+
+  for (const auto& types : std::vector<std::vector<osmscout::TypeInfoRef>>{{data.sparseType},
+                                                                          {data.localType},
+                                                                          {data.denseType},
+                                                                          {data.sparseType,data.localType},
+                                                                          {data.sparseType,data.localType,data.denseType}}) {
+    osmscout::TypeInfoSet typeSet(*data.typeConfig);
+
+    for (const auto& type : types) {
+      typeSet.Set(type);
+    }
+
+    typeSets.push_back(typeSet);
+  }
+
+  std::mt19937                           random(815);
+  std::uniform_real_distribution<double> latDistribution(-85.0,85.0);
+  std::uniform_real_distribution<double> lonDistribution(-180.0,180.0);
+  std::uniform_real_distribution<double> sizeDistribution(0.0,40.0);
+
+  for (size_t i=0; i<200; i++) {
+    osmscout::GeoCoord minCoord(latDistribution(random),lonDistribution(random));
+    osmscout::GeoCoord maxCoord(std::min(85.0,minCoord.GetLat()+sizeDistribution(random)),
+                                std::min(180.0,minCoord.GetLon()+sizeDistribution(random)));
+
+    for (const auto& types : typeSets) {
+      CheckOffsets(data,
+                   index,
+                   osmscout::GeoBox(minCoord,maxCoord),
+                   types);
+    }
+  }
+}
+
+TEST_CASE("Areas at the edge of the data and in empty rows match an unfiltered scan")
+{
+  TestData               data;
+  osmscout::AreaWayIndex index;
+
+  REQUIRE(index.Open(data.typeConfig,".",false));
+
+  osmscout::TypeInfoSet types(*data.typeConfig);
+
+  types.Set(data.sparseType);
+  types.Set(data.localType);
+
+  osmscout::GeoBox emptyBand(osmscout::GeoCoord(13.0,-170.0),
+                             osmscout::GeoCoord(27.0,170.0));
+
+  CheckOffsets(data,index,emptyBand,types);
+  REQUIRE(data.GetExpectedOffsets(emptyBand,types).empty());
+
+  osmscout::GeoBox sparseBox;
+  osmscout::GeoBox localBox;
+
+  for (const auto& way : data.ways) {
+    if (way.type==data.sparseType) {
+      sparseBox.Include(way.boundingBox);
+    }
+    else if (way.type==data.localType) {
+      localBox.Include(way.boundingBox);
+    }
+  }
+
+  // Thin areas along each edge of the data, hitting the first and the last row and column
+  for (const auto& box : {sparseBox,localBox}) {
+    double latDelta=0.001;
+    double lonDelta=0.001;
+
+    CheckOffsets(data,index,osmscout::GeoBox(box.GetMinCoord(),
+                                             osmscout::GeoCoord(box.GetMinLat()+latDelta,box.GetMaxLon())),types);
+    CheckOffsets(data,index,osmscout::GeoBox(osmscout::GeoCoord(box.GetMaxLat()-latDelta,box.GetMinLon()),
+                                             box.GetMaxCoord()),types);
+    CheckOffsets(data,index,osmscout::GeoBox(box.GetMinCoord(),
+                                             osmscout::GeoCoord(box.GetMaxLat(),box.GetMinLon()+lonDelta)),types);
+    CheckOffsets(data,index,osmscout::GeoBox(osmscout::GeoCoord(box.GetMinLat(),box.GetMaxLon()-lonDelta),
+                                             box.GetMaxCoord()),types);
+    CheckOffsets(data,index,box,types);
+  }
+
+  // Areas crossing the empty band
+  CheckOffsets(data,index,osmscout::GeoBox(osmscout::GeoCoord(5.0,-20.0),
+                                           osmscout::GeoCoord(35.0,20.0)),types);
+  CheckOffsets(data,index,osmscout::GeoBox(osmscout::GeoCoord(-85.0,-180.0),
+                                           osmscout::GeoCoord(85.0,180.0)),types);
+}
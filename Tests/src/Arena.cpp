@@ -0,0 +1,247 @@
+/*
+  Arena - a test program for libosmscout
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <cstdint>
+#include <cstring>
+
+#include <osmscout/TypeConfig.h>
+#include <osmscout/TypeFeatures.h>
+
+#include <osmscout/util/Arena.h>
+
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+static osmscout::TypeInfoRef CreateType(osmscout::TypeConfig& typeConfig)
+{
+  osmscout::TypeInfoRef type=std::make_shared<osmscout::TypeInfo>("test_way");
+
+  type->CanBeWay(true);
+  type->AddFeature(typeConfig.GetFeature(osmscout::NameFeature::NAME));
+  type->AddFeature(typeConfig.GetFeature(osmscout::LayerFeature::NAME));
+
+  return typeConfig.RegisterType(type);
+}
+
+static void SetName(osmscout::FeatureValueBuffer& buffer,
+                    const std::string& name)
+{
+  size_t idx;
+
+  REQUIRE(buffer.GetType()->GetFeature(osmscout::NameFeature::NAME,idx));
+
+  auto* value=dynamic_cast<osmscout::NameFeatureValue*>(buffer.AllocateValue(idx));
+
+  REQUIRE(value!=nullptr);
+
+  value->SetName(name);
+}
+
+static std::string GetName(const osmscout::FeatureValueBuffer& buffer)
+{
+  size_t idx;
+
+  REQUIRE(buffer.GetType()->GetFeature(osmscout::NameFeature::NAME,idx));
+  REQUIRE(buffer.HasFeature(idx));
+
+  return dynamic_cast<osmscout::NameFeatureValue*>(buffer.GetValue(idx))->GetName();
+}
+
+TEST_CASE("Allocations respect the requested alignment")
+{
+  osmscout::Arena arena(1024);
+
+  for (size_t alignment : {1,2,4,8,16}) {
+    for (size_t size=1; size<=33; size++) {
+      void* p=arena.Allocate(size,alignment);
+
+      REQUIRE(p!=nullptr);
+      REQUIRE(reinterpret_cast<std::uintptr_t>(p)%alignment==0);
+
+      // memory must be writable
+      std::memset(p,0xff,size);
+    }
+  }
+
+  void* p=arena.Allocate(3);
+
+  REQUIRE(reinterpret_cast<std::uintptr_t>(p)%alignof(std::max_align_t)==0);
+}
+
+TEST_CASE("Allocations are served from blocks")
+{
+  osmscout::Arena arena(1024);
+
+  REQUIRE(arena.GetBlockCount()==0);
+
+  char* first=static_cast<char*>(arena.Allocate(16,1));
+  char* second=static_cast<char*>(arena.Allocate(16,1));
+
+  REQUIRE(arena.GetBlockCount()==1);
+  REQUIRE(second==first+16);
+
+  // Fill the block, next allocation requires a new block
+  for (size_t i=0; i<1024/16; i++) {
+    arena.Allocate(16,1);
+  }
+
+  REQUIRE(arena.GetBlockCount()==2);
+  REQUIRE(arena.GetAllocationCount()==2+1024/16);
+  REQUIRE(arena.GetAllocatedBytes()==16*(2+1024/16));
+}
+
+TEST_CASE("Oversize allocations get their own block")
+{
+  osmscout::Arena arena(1024);
+
+  char* small=static_cast<char*>(arena.Allocate(16,1));
+  char* big=static_cast<char*>(arena.Allocate(4096,1));
+
+  REQUIRE(arena.GetBlockCount()==2);
+
+  std::memset(big,0xff,4096);
+
+  // the current block is still used for small allocations
+  char* next=static_cast<char*>(arena.Allocate(16,1));
+
+  REQUIRE(next==small+16);
+  REQUIRE(arena.GetBlockCount()==2);
+}
+
+TEST_CASE("Scopes can be nested")
+{
+  osmscout::ArenaRef outer=std::make_shared<osmscout::Arena>();
+  osmscout::ArenaRef inner=std::make_shared<osmscout::Arena>();
+
+  REQUIRE(osmscout::ArenaScope::GetCurrentArena()==nullptr);
+
+  {
+    osmscout::ArenaScope outerScope(outer);
+
+    REQUIRE(osmscout::ArenaScope::GetCurrentArena()==outer);
+
+    {
+      osmscout::ArenaScope innerScope(inner);
+
+      REQUIRE(osmscout::ArenaScope::GetCurrentArena()==inner);
+
+      {
+        osmscout::ArenaScope disabledScope(nullptr);
+
+        REQUIRE(osmscout::ArenaScope::GetCurrentArena()==nullptr);
+      }
+
+      REQUIRE(osmscout::ArenaScope::GetCurrentArena()==inner);
+    }
+
+    REQUIRE(osmscout::ArenaScope::GetCurrentArena()==outer);
+  }
+
+  REQUIRE(osmscout::ArenaScope::GetCurrentArena()==nullptr);
+}
+
+TEST_CASE("Feature value buffers use the arena only while its scope is active")
+{
+  osmscout::TypeConfig         typeConfig;
+  osmscout::TypeInfoRef        type=CreateType(typeConfig);
+  osmscout::ArenaRef           arena=std::make_shared<osmscout::Arena>();
+  osmscout::FeatureValueBuffer buffer;
+
+  {
+    osmscout::ArenaScope scope(arena);
+
+    buffer.SetType(type);
+  }
+
+  size_t allocationCount=arena->GetAllocationCount();
+
+  REQUIRE(allocationCount>0);
+
+  // The value buffer is allocated lazily after the scope has ended, it must come from the heap
+  SetName(buffer,"Main Street");
+
+  REQUIRE(arena->GetAllocationCount()==allocationCount);
+  REQUIRE(GetName(buffer)=="Main Street");
+
+  {
+    osmscout::ArenaScope         scope(arena);
+    osmscout::FeatureValueBuffer scopedBuffer;
+
+    scopedBuffer.SetType(type);
+    SetName(scopedBuffer,"Side Street");
+
+    REQUIRE(arena->GetAllocationCount()==allocationCount+2);
+    REQUIRE(GetName(scopedBuffer)=="Side Street");
+  }
+}
+
+TEST_CASE("Feature value buffers can be copied across arenas")
+{
+  osmscout::TypeConfig  typeConfig;
+  osmscout::TypeInfoRef type=CreateType(typeConfig);
+  osmscout::ArenaRef    first=std::make_shared<osmscout::Arena>();
+  osmscout::ArenaRef    second=std::make_shared<osmscout::Arena>();
+
+  osmscout::FeatureValueBuffer heapCopy;
+  osmscout::FeatureValueBuffer assigned;
+
+  {
+    osmscout::ArenaScope scope(second);
+
+    assigned.SetType(type);
+    SetName(assigned,"Old Street");
+  }
+
+  {
+    osmscout::FeatureValueBuffer original;
+
+    {
+      osmscout::ArenaScope scope(first);
+
+      original.SetType(type);
+      SetName(original,"Main Street");
+    }
+
+    size_t secondAllocations=second->GetAllocationCount();
+
+    {
+      osmscout::ArenaScope scope(second);
+
+      assigned=original;
+    }
+
+    REQUIRE(second->GetAllocationCount()>secondAllocations);
+
+    size_t firstAllocations=first->GetAllocationCount();
+
+    heapCopy=original;
+
+    REQUIRE(first->GetAllocationCount()==firstAllocations);
+  }
+
+  // Copies stay valid after the original and its arena are gone
+  first=nullptr;
+
+  REQUIRE(GetName(heapCopy)=="Main Street");
+  REQUIRE(GetName(assigned)=="Main Street");
+
+  second=nullptr;
+
+  // The buffer keeps its arena alive
+  REQUIRE(GetName(assigned)=="Main Street");
+}
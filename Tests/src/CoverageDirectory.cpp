@@ -0,0 +1,327 @@
+/*
+  CoverageDirectory - a test program for libosmscout
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <set>
+
+#if defined(_WIN32)
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+#include <osmscout/CoverageDirectory.h>
+
+#include <osmscout/util/File.h>
+#include <osmscout/util/FileWriter.h>
+
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+static void MakeDirectory(const std::string& directory)
+{
+#if defined(_WIN32)
+  _mkdir(directory.c_str());
+#else
+  mkdir(directory.c_str(),0755);
+#endif
+}
+
+/**
+ * Writes a coverage index in the format of the import, with the bitmap
+ * width aligned to whole bytes.
+ */
+static void WriteCoverageIndex(const std::string& directory,
+                               uint32_t cellLevel,
+                               const std::set<osmscout::Pixel>& cells)
+{
+  osmscout::Pixel minCell(cells.begin()->x,cells.begin()->y);
+  osmscout::Pixel maxCell(minCell);
+
+  for (const auto& cell : cells) {
+    minCell.x=std::min(minCell.x,cell.x);
+    minCell.y=std::min(minCell.y,cell.y);
+    maxCell.x=std::max(maxCell.x,cell.x);
+    maxCell.y=std::max(maxCell.y,cell.y);
+  }
+
+  uint32_t width=((maxCell.x-minCell.x+1+7)/8)*8;
+  uint32_t height=maxCell.y-minCell.y+1;
+
+  maxCell.x=minCell.x+width-1;
+
+  std::vector<uint8_t> bitmap((width*height)/8,0);
+
+  for (const auto& cell : cells) {
+    size_t bit=(cell.y-minCell.y)*width+cell.x-minCell.x;
+
+    bitmap[bit/8]|=(uint8_t)(1 << (bit%8));
+  }
+
+  osmscout::FileWriter writer;
+
+  MakeDirectory(directory);
+
+  writer.Open(osmscout::AppendFileToDir(directory,
+                                        osmscout::CoverageIndex::COVERAGE_IDX));
+  writer.Write(cellLevel);
+  writer.Write(minCell.x);
+  writer.Write(minCell.y);
+  writer.Write(maxCell.x);
+  writer.Write(maxCell.y);
+
+  for (auto b : bitmap) {
+    writer.Write(b);
+  }
+
+  writer.Close();
+}
+
+/**
+ * Databases covering areas along the poles and the antimeridian, with cells
+ * smaller and bigger than the leaf cells of the directory, and a database
+ * without coverage index.
+ */
+class TestData
+{
+public:
+  struct Database
+  {
+    osmscout::DatabaseId       id;
+    std::string                directory;
+    osmscout::CoverageIndexRef index;
+  };
+
+  std::vector<Database>       databases;
+  osmscout::CoverageDirectory directory;
+
+private:
+  void AddDatabase(osmscout::DatabaseId id,
+                   const std::string& directoryName,
+                   uint32_t cellLevel,
+                   const std::set<osmscout::Pixel>& cells)
+  {
+    Database database{id,directoryName,std::make_shared<osmscout::CoverageIndex>()};
+
+    WriteCoverageIndex(directoryName,
+                       cellLevel,
+                       cells);
+
+    REQUIRE(database.index->Open(directoryName));
+
+    databases.push_back(database);
+    directory.AddDatabase(id,database.index);
+  }
+
+public:
+  TestData()
+  {
+    std::mt19937                random(4711);
+    std::bernoulli_distribution covered(0.3);
+    std::set<osmscout::Pixel>   northCells;
+    std::set<osmscout::Pixel>   southCells;
+    std::set<osmscout::Pixel>   middleCells;
+
+    // Along the north pole on both sides of the antimeridian
+    for (uint32_t y=1000; y<1024; y++) {
+      for (uint32_t x=0; x<1024; x++) {
+        if ((x<24 || x>=1000) && covered(random)) {
+          northCells.insert(osmscout::Pixel(x,y));
+        }
+      }
+    }
+
+    // Along the south pole, cells bigger than the leaf cells
+    for (uint32_t y=0; y<2; y++) {
+      for (uint32_t x=0; x<64; x++) {
+        if (covered(random)) {
+          southCells.insert(osmscout::Pixel(x,y));
+        }
+      }
+    }
+
+    // Somewhere in the middle, small cells
+    for (uint32_t y=2000; y<2100; y++) {
+      for (uint32_t x=3000; x<3200; x++) {
+        if (covered(random)) {
+          middleCells.insert(osmscout::Pixel(x,y));
+        }
+      }
+    }
+
+    AddDatabase(1,"CoverageDirectoryNorth",10,northCells);
+    AddDatabase(2,"CoverageDirectorySouth",6,southCells);
+    AddDatabase(3,"CoverageDirectoryMiddle",12,middleCells);
+
+    directory.AddDatabase(4,nullptr);
+  }
+
+  ~TestData()
+  {
+    for (auto& database : databases) {
+      database.index->Close();
+      osmscout::RemoveFile(osmscout::AppendFileToDir(database.directory,
+                                                     osmscout::CoverageIndex::COVERAGE_IDX));
+    }
+  }
+
+  std::vector<osmscout::DatabaseId> GetExpectedDatabases(const osmscout::GeoCoord& coord) const
+  {
+    std::vector<osmscout::DatabaseId> result{4};
+
+    for (const auto& database : databases) {
+      if (database.index->IsCovered(coord)) {
+        result.push_back(database.id);
+      }
+    }
+
+    std::sort(result.begin(),result.end());
+
+    return result;
+  }
+
+  /**
+   * Databases with at least one covered cell intersecting the leaf cells of
+   * the directory, that contain the corners of the given bounding box.
+   */
+  std::vector<osmscout::DatabaseId> GetExpectedDatabases(const osmscout::GeoBox& boundingBox) const
+  {
+    std::vector<osmscout::DatabaseId> result{4};
+    double                            leafCount=std::pow(2.0,osmscout::CoverageDirectory::DEFAULT_LEVEL);
+    double                            leafWidth=360.0/leafCount;
+    double                            leafHeight=180.0/leafCount;
+    double                            minLeafX=std::min(leafCount-1,std::floor((boundingBox.GetMinLon()+180.0)/leafWidth));
+    double                            maxLeafX=std::min(leafCount-1,std::floor((boundingBox.GetMaxLon()+180.0)/leafWidth));
+    double                            minLeafY=std::min(leafCount-1,std::floor((boundingBox.GetMinLat()+90.0)/leafHeight));
+    double                            maxLeafY=std::min(leafCount-1,std::floor((boundingBox.GetMaxLat()+90.0)/leafHeight));
+    double                            minLon=minLeafX*leafWidth-180.0;
+    double                            maxLon=(maxLeafX+1)*leafWidth-180.0;
+    double                            minLat=minLeafY*leafHeight-90.0;
+    double                            maxLat=(maxLeafY+1)*leafHeight-90.0;
+
+    for (const auto& database : databases) {
+      const osmscout::CoverageIndex& index=*database.index;
+      double                         cellCount=std::pow(2.0,index.GetCellLevel());
+      double                         cellWidth=360.0/cellCount;
+      double                         cellHeight=180.0/cellCount;
+      bool                           found=false;
+
+      for (uint32_t y=index.GetMinCell().y; y<=index.GetMaxCell().y && !found; y++) {
+        for (uint32_t x=index.GetMinCell().x; x<=index.GetMaxCell().x && !found; x++) {
+          found=index.IsCovered(osmscout::Pixel(x,y)) &&
+                x*cellWidth-180.0<maxLon &&
+                (x+1)*cellWidth-180.0>minLon &&
+                y*cellHeight-90.0<maxLat &&
+                (y+1)*cellHeight-90.0>minLat;
+        }
+      }
+
+      if (found) {
+        result.push_back(database.id);
+      }
+    }
+
+    std::sort(result.begin(),result.end());
+
+    return result;
+  }
+};
+
+static void CheckCoord(const TestData& data,
+                       const osmscout::GeoCoord& coord)
+{
+  std::vector<osmscout::DatabaseId> result;
+
+  data.directory.GetDatabases(coord,result);
+
+  REQUIRE(result==data.GetExpectedDatabases(coord));
+}
+
+static void CheckBox(const TestData& data,
+                     const osmscout::GeoBox& boundingBox)
+{
+  std::vector<osmscout::DatabaseId> result;
+
+  data.directory.GetDatabases(boundingBox,result);
+
+  REQUIRE(result==data.GetExpectedDatabases(boundingBox));
+}
+
+TEST_CASE("Coordinates match a scan of all coverage indexes")
+{
+  TestData                               data;
+  std::mt19937                           random(815);
+  std::uniform_real_distribution<double> latDistribution(-90.0,90.0);
+  std::uniform_real_distribution<double> lonDistribution(-180.0,180.0);
+  std::uniform_real_distribution<double> northDistribution(80.0,90.0);
+  std::uniform_real_distribution<double> southDistribution(-90.0,-80.0);
+  std::uniform_real_distribution<double> westDistribution(-180.0,-170.0);
+  std::uniform_real_distribution<double> eastDistribution(170.0,180.0);
+
+  for (size_t i=0; i<2000; i++) {
+    CheckCoord(data,osmscout::GeoCoord(latDistribution(random),lonDistribution(random)));
+    CheckCoord(data,osmscout::GeoCoord(northDistribution(random),westDistribution(random)));
+    CheckCoord(data,osmscout::GeoCoord(northDistribution(random),eastDistribution(random)));
+    CheckCoord(data,osmscout::GeoCoord(southDistribution(random),lonDistribution(random)));
+    CheckCoord(data,osmscout::GeoCoord(latDistribution(random)/30.0,92.0+lonDistribution(random)/30.0));
+  }
+
+  for (double lat : {-90.0,-89.9,0.0,89.9,90.0}) {
+    for (double lon : {-180.0,-179.9,0.0,179.9,180.0}) {
+      CheckCoord(data,osmscout::GeoCoord(lat,lon));
+    }
+  }
+}
+
+TEST_CASE("Bounding boxes match a scan of all coverage indexes")
+{
+  TestData                               data;
+  std::mt19937                           random(4712);
+  std::uniform_real_distribution<double> latDistribution(-90.0,90.0);
+  std::uniform_real_distribution<double> lonDistribution(-180.0,180.0);
+  std::uniform_real_distribution<double> sizeDistribution(0.0,5.0);
+
+  for (size_t i=0; i<2000; i++) {
+    osmscout::GeoCoord minCoord(latDistribution(random),lonDistribution(random));
+    osmscout::GeoCoord maxCoord(std::min(90.0,minCoord.GetLat()+sizeDistribution(random)),
+                                std::min(180.0,minCoord.GetLon()+sizeDistribution(random)));
+
+    CheckBox(data,osmscout::GeoBox(minCoord,maxCoord));
+  }
+
+  // Boxes touching the poles and the antimeridian
+  for (double size : {0.0,0.1,1.0,10.0}) {
+    CheckBox(data,osmscout::GeoBox(osmscout::GeoCoord(90.0-size,-180.0),
+                                   osmscout::GeoCoord(90.0,-180.0+size)));
+    CheckBox(data,osmscout::GeoBox(osmscout::GeoCoord(90.0-size,180.0-size),
+                                   osmscout::GeoCoord(90.0,180.0)));
+    CheckBox(data,osmscout::GeoBox(osmscout::GeoCoord(-90.0,-180.0),
+                                   osmscout::GeoCoord(-90.0+size,-180.0+size)));
+    CheckBox(data,osmscout::GeoBox(osmscout::GeoCoord(-90.0,180.0-size),
+                                   osmscout::GeoCoord(-90.0+size,180.0)));
+    CheckBox(data,osmscout::GeoBox(osmscout::GeoCoord(-size,-180.0),
+                                   osmscout::GeoCoord(size,-180.0+size)));
+    CheckBox(data,osmscout::GeoBox(osmscout::GeoCoord(-size,180.0-size),
+                                   osmscout::GeoCoord(size,180.0)));
+  }
+
+  CheckBox(data,osmscout::GeoBox(osmscout::GeoCoord(-90.0,-180.0),
+                                 osmscout::GeoCoord(90.0,180.0)));
+}
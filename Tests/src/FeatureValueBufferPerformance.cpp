@@ -0,0 +1,192 @@
+/*
+  FeatureValueBufferPerformance - a test program for libosmscout
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <vector>
+
+#include <osmscout/TypeConfig.h>
+#include <osmscout/TypeFeatures.h>
+
+#include <osmscout/util/Arena.h>
+#include <osmscout/util/FileScanner.h>
+#include <osmscout/util/FileWriter.h>
+#include <osmscout/util/StopClock.h>
+
+/**
+  Check performance of decoding feature value buffers
+  * with feature bits and values allocated on the heap
+  * with feature bits and values allocated from a common arena
+
+  Number of heap allocations is counted by replacing the global operator new.
+*/
+
+static std::atomic<size_t> allocationCount(0);
+
+void* operator new(size_t size)
+{
+  allocationCount++;
+
+  void* p=std::malloc(size==0 ? 1 : size);
+
+  if (p==nullptr) {
+    throw std::bad_alloc();
+  }
+
+  return p;
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, size_t /*size*/) noexcept
+{
+  std::free(p);
+}
+
+static const size_t bufferCount=100000;
+
+static const char* filename="FeatureValueBufferPerformance.dat";
+
+osmscout::TypeInfoRef CreateType(osmscout::TypeConfig& typeConfig)
+{
+  osmscout::TypeInfoRef type=std::make_shared<osmscout::TypeInfo>("test_way");
+
+  type->CanBeWay(true);
+  type->AddFeature(typeConfig.GetFeature(osmscout::NameFeature::NAME));
+  type->AddFeature(typeConfig.GetFeature(osmscout::RefFeature::NAME));
+  type->AddFeature(typeConfig.GetFeature(osmscout::LayerFeature::NAME));
+  type->AddFeature(typeConfig.GetFeature(osmscout::BridgeFeature::NAME));
+
+  return typeConfig.RegisterType(type);
+}
+
+void WriteBuffers(const osmscout::TypeInfoRef& type)
+{
+  osmscout::FileWriter writer;
+
+  writer.Open(filename);
+
+  for (size_t i=0; i<bufferCount; i++) {
+    osmscout::FeatureValueBuffer buffer;
+    size_t                       idx;
+
+    buffer.SetType(type);
+
+    if (type->GetFeature(osmscout::NameFeature::NAME,idx)) {
+      auto* value=dynamic_cast<osmscout::NameFeatureValue*>(buffer.AllocateValue(idx));
+      value->SetName("Street "+std::to_string(i));
+    }
+
+    if (i%3==0 &&
+        type->GetFeature(osmscout::RefFeature::NAME,idx)) {
+      auto* value=dynamic_cast<osmscout::RefFeatureValue*>(buffer.AllocateValue(idx));
+      value->SetRef("B"+std::to_string(i%100));
+    }
+
+    if (i%5==0 &&
+        type->GetFeature(osmscout::LayerFeature::NAME,idx)) {
+      auto* value=dynamic_cast<osmscout::LayerFeatureValue*>(buffer.AllocateValue(idx));
+      value->SetLayer(1);
+    }
+
+    if (i%7==0 &&
+        type->GetFeature(osmscout::BridgeFeature::NAME,idx)) {
+      buffer.AllocateValue(idx);
+    }
+
+    buffer.Write(writer);
+  }
+
+  writer.Close();
+}
+
+void ReadBuffers(const osmscout::TypeInfoRef& type,
+                 bool useArena)
+{
+  std::vector<osmscout::FeatureValueBuffer> buffers(bufferCount);
+  osmscout::FileScanner                     scanner;
+  osmscout::ArenaRef                        arena;
+
+  scanner.Open(filename,osmscout::FileScanner::Sequential,true);
+
+  size_t              decodeAllocations=allocationCount;
+  osmscout::StopClock decodeTimer;
+
+  {
+    if (useArena) {
+      arena=std::make_shared<osmscout::Arena>();
+    }
+
+    osmscout::ArenaScope arenaScope(arena);
+
+    for (auto& buffer : buffers) {
+      buffer.SetType(type);
+      buffer.Read(scanner);
+    }
+  }
+
+  decodeTimer.Stop();
+  decodeAllocations=allocationCount-decodeAllocations;
+
+  scanner.Close();
+
+  size_t arenaBlocks=arena ? arena->GetBlockCount() : 0;
+
+  arena=nullptr;
+
+  osmscout::StopClock releaseTimer;
+
+  buffers.clear();
+
+  releaseTimer.Stop();
+
+  std::cout << (useArena ? "Arena:" : "Heap: ") << " decoding " << bufferCount << " buffers took " << decodeTimer;
+  std::cout << " with " << decodeAllocations << " allocations";
+  if (useArena) {
+    std::cout << " (" << arenaBlocks << " arena blocks)";
+  }
+  std::cout << ", release took " << releaseTimer << std::endl;
+}
+
+int main(int /*argc*/, char* /*argv*/[])
+{
+  osmscout::TypeConfig  typeConfig;
+  osmscout::TypeInfoRef type=CreateType(typeConfig);
+
+  try {
+    WriteBuffers(type);
+
+    ReadBuffers(type,false);
+    ReadBuffers(type,true);
+  }
+  catch (osmscout::IOException& e) {
+    std::cerr << e.GetDescription() << std::endl;
+    std::remove(filename);
+    return 1;
+  }
+
+  std::remove(filename);
+
+  return 0;
+}
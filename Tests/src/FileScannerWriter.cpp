@@ -546,6 +546,155 @@ int main()
     errors++;
   }
 
+  // Write-behind mode with a small buffer, so that many buffers are written in background
+  try {
+    osmscout::FileWriter behindWriter;
+    osmscout::FileOffset patchOffset;
+    osmscout::FileOffset endOffset;
+
+    behindWriter.Open("test.dat",64);
+
+    // placeholder, patched after the buffer got written
+    behindWriter.Write((uint32_t)0);
+
+    for (uint32_t i=0; i<10000; i++) {
+      behindWriter.WriteNumber(i);
+    }
+
+    // placeholder, patched while still in the buffer
+    patchOffset=behindWriter.GetPos();
+    behindWriter.Write((uint32_t)0);
+    behindWriter.Write(std::string("end"));
+
+    endOffset=behindWriter.GetPos();
+
+    behindWriter.SetPos(patchOffset);
+    behindWriter.Write((uint32_t)4711);
+    behindWriter.GotoBegin();
+    behindWriter.Write((uint32_t)10000);
+    behindWriter.SetPos(endOffset);
+    behindWriter.Write((uint8_t)42);
+
+    behindWriter.Close();
+
+    scanner.Open("test.dat",osmscout::FileScanner::Sequential,false);
+
+    uint32_t    count;
+    uint32_t    patched;
+    std::string end;
+    uint8_t     last;
+
+    scanner.Read(count);
+
+    if (count!=10000) {
+      std::cerr << "Write-behind: Expected 10000, got " << count << std::endl;
+      errors++;
+    }
+
+    for (uint32_t i=0; i<count; i++) {
+      uint32_t value;
+
+      scanner.ReadNumber(value);
+
+      if (value!=i) {
+        std::cerr << "Write-behind: Expected " << i << ", got " << value << std::endl;
+        errors++;
+        break;
+      }
+    }
+
+    scanner.Read(patched);
+    scanner.Read(end);
+    scanner.Read(last);
+
+    if (patched!=4711 || end!="end" || last!=42) {
+      std::cerr << "Write-behind: Patched data does not match" << std::endl;
+      errors++;
+    }
+
+    scanner.Close();
+  }
+  catch (osmscout::IOException& e) {
+    std::cerr << e.GetDescription() << std::endl;
+    errors++;
+  }
+
+  // Positional reads with independent cursors, with and without memory mapping
+  for (bool useMmap : {false,true}) {
+    try {
+      osmscout::FileWriter              cursorWriter;
+      std::vector<osmscout::FileOffset> offsets;
+      osmscout::GeoCoord                outCoord(51.57231,7.46418);
+      osmscout::GeoCoord                inCoord;
+
+      cursorWriter.Open("test.dat");
+
+      for (uint32_t i=0; i<10000; i++) {
+        offsets.push_back(cursorWriter.GetPos());
+        cursorWriter.WriteNumber(i*(uint64_t)1000003);
+        cursorWriter.WriteFileOffset(i,3);
+        cursorWriter.WriteCoord(outCoord);
+      }
+
+      cursorWriter.Close();
+
+      scanner.Open("test.dat",osmscout::FileScanner::FastRandom,useMmap);
+
+      osmscout::FileOffset scannerPos=scanner.GetPos();
+      osmscout::FileCursor forward(scanner);
+      osmscout::FileCursor backward(scanner);
+
+      for (uint32_t i=0; i<10000; i++) {
+        uint32_t             j=10000-1-i;
+        uint64_t             forwardNumber;
+        uint64_t             backwardNumber;
+        osmscout::FileOffset forwardOffset;
+        osmscout::GeoCoord   backwardCoord;
+
+        forward.ReadNumber(forwardNumber);
+        forward.ReadFileOffset(forwardOffset,3);
+        forward.ReadCoord(inCoord);
+
+        backward.SetPos(offsets[j]);
+        backward.ReadNumber(backwardNumber);
+
+        if (forwardNumber!=i*(uint64_t)1000003 ||
+            forwardOffset!=i ||
+            inCoord.GetDisplayText()!=outCoord.GetDisplayText() ||
+            backwardNumber!=j*(uint64_t)1000003) {
+          std::cerr << "Cursor: Data does not match at entry " << i << std::endl;
+          errors++;
+          break;
+        }
+      }
+
+      if (scanner.GetPos()!=scannerPos) {
+        std::cerr << "Cursor: Position of scanner changed" << std::endl;
+        errors++;
+      }
+
+      bool thrown=false;
+
+      try {
+        forward.ReadCoord(inCoord);
+      }
+      catch (osmscout::IOException& /*e*/) {
+        thrown=true;
+      }
+
+      if (!thrown || scanner.HasError()) {
+        std::cerr << "Cursor: Reading beyond end of file not detected correctly" << std::endl;
+        errors++;
+      }
+
+      scanner.Close();
+    }
+    catch (osmscout::IOException& e) {
+      std::cerr << e.GetDescription() << std::endl;
+      errors++;
+    }
+  }
+
   if (errors!=0) {
     return 1;
   }
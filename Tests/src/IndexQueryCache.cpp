@@ -0,0 +1,149 @@
+/*
+  IndexQueryCache - a test program for libosmscout
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <memory>
+#include <vector>
+
+#include <osmscout/IndexQueryCache.h>
+#include <osmscout/TypeConfig.h>
+
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+class TestData
+{
+public:
+  osmscout::TypeConfig  typeConfig;
+  osmscout::TypeInfoSet roads;
+  osmscout::TypeInfoSet rivers;
+  std::shared_ptr<int>  index;
+
+public:
+  TestData()
+  : index(std::make_shared<int>(0))
+  {
+    osmscout::TypeInfoRef road=std::make_shared<osmscout::TypeInfo>("road");
+    osmscout::TypeInfoRef river=std::make_shared<osmscout::TypeInfo>("river");
+
+    road->CanBeWay(true);
+    river->CanBeWay(true);
+
+    typeConfig.RegisterType(road);
+    typeConfig.RegisterType(river);
+
+    roads.Set(road);
+    rivers.Set(river);
+  }
+};
+
+static osmscout::TileKey GetKey(uint32_t x)
+{
+  return osmscout::TileKey(osmscout::Magnification(osmscout::MagnificationLevel(14)),
+                           osmscout::TileId(x,0));
+}
+
+TEST_CASE("Results are cached by tile, level and types")
+{
+  TestData                                        test;
+  osmscout::IndexQueryCache<osmscout::FileOffset> cache(10);
+  std::vector<osmscout::FileOffset>               offsets;
+  osmscout::TypeInfoSet                           loadedTypes;
+
+  REQUIRE(!cache.Get(test.index,GetKey(1),0,test.roads,offsets,loadedTypes));
+
+  cache.Set(test.index,GetKey(1),0,test.roads,{1,2,3},test.roads);
+  cache.Set(test.index,GetKey(1),0,test.rivers,{4},test.rivers);
+  cache.Set(test.index,GetKey(1),5,test.roads,{5},test.roads);
+
+  REQUIRE(cache.GetSize()==3);
+
+  REQUIRE(cache.Get(test.index,GetKey(1),0,test.roads,offsets,loadedTypes));
+  REQUIRE(offsets==std::vector<osmscout::FileOffset>({1,2,3}));
+  REQUIRE(loadedTypes==test.roads);
+
+  REQUIRE(cache.Get(test.index,GetKey(1),0,test.rivers,offsets,loadedTypes));
+  REQUIRE(offsets==std::vector<osmscout::FileOffset>({4}));
+
+  REQUIRE(cache.Get(test.index,GetKey(1),5,test.roads,offsets,loadedTypes));
+  REQUIRE(offsets==std::vector<osmscout::FileOffset>({5}));
+
+  REQUIRE(!cache.Get(test.index,GetKey(2),0,test.roads,offsets,loadedTypes));
+
+  // Updating an entry replaces it
+  cache.Set(test.index,GetKey(1),0,test.roads,{6},test.roads);
+
+  REQUIRE(cache.GetSize()==3);
+  REQUIRE(cache.Get(test.index,GetKey(1),0,test.roads,offsets,loadedTypes));
+  REQUIRE(offsets==std::vector<osmscout::FileOffset>({6}));
+}
+
+TEST_CASE("Least recently used entries are evicted")
+{
+  TestData                                        test;
+  osmscout::IndexQueryCache<osmscout::FileOffset> cache(2);
+  std::vector<osmscout::FileOffset>               offsets;
+  osmscout::TypeInfoSet                           loadedTypes;
+
+  cache.Set(test.index,GetKey(1),0,test.roads,{1},test.roads);
+  cache.Set(test.index,GetKey(2),0,test.roads,{2},test.roads);
+
+  // Use the first entry, so that the second is the oldest one
+  REQUIRE(cache.Get(test.index,GetKey(1),0,test.roads,offsets,loadedTypes));
+
+  cache.Set(test.index,GetKey(3),0,test.roads,{3},test.roads);
+
+  REQUIRE(cache.GetSize()==2);
+  REQUIRE(cache.Get(test.index,GetKey(1),0,test.roads,offsets,loadedTypes));
+  REQUIRE(!cache.Get(test.index,GetKey(2),0,test.roads,offsets,loadedTypes));
+  REQUIRE(cache.Get(test.index,GetKey(3),0,test.roads,offsets,loadedTypes));
+
+  cache.SetMaxSize(1);
+
+  REQUIRE(cache.GetSize()==1);
+  REQUIRE(cache.Get(test.index,GetKey(3),0,test.roads,offsets,loadedTypes));
+
+  cache.SetMaxSize(0);
+  cache.Set(test.index,GetKey(1),0,test.roads,{1},test.roads);
+
+  REQUIRE(cache.GetSize()==0);
+}
+
+TEST_CASE("Entries are dropped for another index instance")
+{
+  TestData                                        test;
+  osmscout::IndexQueryCache<osmscout::FileOffset> cache(10);
+  std::vector<osmscout::FileOffset>               offsets;
+  osmscout::TypeInfoSet                           loadedTypes;
+
+  cache.Set(test.index,GetKey(1),0,test.roads,{1},test.roads);
+
+  // The database was opened again
+  std::shared_ptr<int> reopenedIndex=std::make_shared<int>(0);
+
+  REQUIRE(!cache.Get(reopenedIndex,GetKey(1),0,test.roads,offsets,loadedTypes));
+  REQUIRE(cache.GetSize()==0);
+
+  cache.Set(reopenedIndex,GetKey(1),0,test.roads,{2},test.roads);
+
+  REQUIRE(cache.Get(reopenedIndex,GetKey(1),0,test.roads,offsets,loadedTypes));
+  REQUIRE(offsets==std::vector<osmscout::FileOffset>({2}));
+
+  cache.Flush();
+
+  REQUIRE(cache.GetSize()==0);
+}
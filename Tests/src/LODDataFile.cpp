@@ -0,0 +1,359 @@
+/*
+  LODDataFile - a test program for libosmscout
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <cmath>
+#include <unordered_map>
+
+#include <osmscout/AreaDataFile.h>
+#include <osmscout/LODDataFile.h>
+#include <osmscout/WayDataFile.h>
+
+#include <osmscout/import/GenLODDat.h>
+
+#include <osmscout/util/File.h>
+#include <osmscout/util/FileWriter.h>
+
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+static const size_t objectCount=600;
+
+/**
+ * Writes a ways.dat and an areas.dat to the current directory. Every second
+ * object has a detailed geometry, that can be simplified, the other objects
+ * are trivial and cannot be simplified.
+ */
+class TestData
+{
+public:
+  osmscout::TypeConfigRef                   typeConfig;
+  std::vector<osmscout::FileOffset>         wayOffsets;
+  std::vector<osmscout::FileOffset>         areaOffsets;
+
+private:
+  static bool IsDetailed(size_t i)
+  {
+    return i%2==0;
+  }
+
+  void WriteWays(const osmscout::TypeInfoRef& type)
+  {
+    osmscout::FileWriter writer;
+
+    writer.Open(osmscout::WayDataFile::WAYS_DAT);
+    writer.Write((uint32_t)objectCount);
+
+    for (size_t i=0; i<objectCount; i++) {
+      osmscout::WayRef way=std::make_shared<osmscout::Way>();
+      double           lat=50.0+i*0.01;
+
+      way->SetType(type);
+
+      if (IsDetailed(i)) {
+        // a long line with tiny zig-zags
+        for (size_t n=0; n<200; n++) {
+          way->nodes.emplace_back(0,osmscout::GeoCoord(lat+(n%2)*0.000001,10.0+n*0.0005));
+        }
+      }
+      else {
+        way->nodes.emplace_back(0,osmscout::GeoCoord(lat,10.0));
+        way->nodes.emplace_back(0,osmscout::GeoCoord(lat,10.1));
+      }
+
+      wayOffsets.push_back(writer.GetPos());
+      way->Write(*typeConfig,writer);
+    }
+
+    writer.Close();
+  }
+
+  void WriteAreas(const osmscout::TypeInfoRef& type)
+  {
+    osmscout::FileWriter writer;
+
+    writer.Open(osmscout::AreaDataFile::AREAS_DAT);
+    writer.Write((uint32_t)objectCount);
+
+    for (size_t i=0; i<objectCount; i++) {
+      osmscout::AreaRef area=std::make_shared<osmscout::Area>();
+      osmscout::GeoCoord center(-30.0+i*0.01,20.0);
+
+      area->rings.resize(1);
+      area->rings[0].SetType(type);
+      area->rings[0].MarkAsOuterRing();
+
+      if (IsDetailed(i)) {
+        // a circle
+        for (size_t n=0; n<400; n++) {
+          double angle=2*M_PI*n/400;
+
+          area->rings[0].nodes.emplace_back(0,osmscout::GeoCoord(center.GetLat()+0.004*std::sin(angle),
+                                                                 center.GetLon()+0.004*std::cos(angle)));
+        }
+      }
+      else {
+        area->rings[0].nodes.emplace_back(0,center);
+        area->rings[0].nodes.emplace_back(0,osmscout::GeoCoord(center.GetLat(),center.GetLon()+0.004));
+        area->rings[0].nodes.emplace_back(0,osmscout::GeoCoord(center.GetLat()+0.004,center.GetLon()));
+      }
+
+      areaOffsets.push_back(writer.GetPos());
+      area->Write(*typeConfig,writer);
+    }
+
+    writer.Close();
+  }
+
+public:
+  TestData()
+  : typeConfig(std::make_shared<osmscout::TypeConfig>())
+  {
+    osmscout::TypeInfoRef wayType=std::make_shared<osmscout::TypeInfo>("test_way");
+    osmscout::TypeInfoRef areaType=std::make_shared<osmscout::TypeInfo>("test_area");
+
+    wayType->CanBeWay(true);
+    areaType->CanBeArea(true);
+
+    typeConfig->RegisterType(wayType);
+    typeConfig->RegisterType(areaType);
+
+    WriteWays(wayType);
+    WriteAreas(areaType);
+  }
+
+  ~TestData()
+  {
+    osmscout::RemoveFile(osmscout::WayDataFile::WAYS_DAT);
+    osmscout::RemoveFile(osmscout::AreaDataFile::AREAS_DAT);
+    osmscout::RemoveFile(osmscout::WayLODDataFile::WAYSLOD_DAT);
+    osmscout::RemoveFile(osmscout::AreaLODDataFile::AREASLOD_DAT);
+  }
+
+  bool Import(bool lodData) const
+  {
+    osmscout::ImportParameter  parameter;
+    osmscout::SilentProgress   progress;
+    osmscout::LODDataGenerator generator;
+
+    parameter.SetDestinationDirectory(".");
+    parameter.SetLODData(lodData);
+
+    return generator.Import(typeConfig,
+                            parameter,
+                            progress);
+  }
+};
+
+/**
+ * Compares the given ways with the ways in the data file, that have the same
+ * file offset.
+ */
+static void CheckWays(const TestData& data,
+                      const osmscout::WayDataFile& wayDataFile,
+                      const std::vector<osmscout::WayRef>& ways,
+                      bool simplified)
+{
+  std::unordered_map<osmscout::FileOffset,osmscout::WayRef> originals;
+
+  REQUIRE(wayDataFile.GetByOffset(data.wayOffsets.begin(),
+                                  data.wayOffsets.end(),
+                                  data.wayOffsets.size(),
+                                  originals));
+  REQUIRE(ways.size()==data.wayOffsets.size());
+
+  for (const auto& way : ways) {
+    auto original=originals.find(way->GetFileOffset());
+
+    REQUIRE(original!=originals.end());
+
+    const auto& originalNodes=original->second->nodes;
+
+    REQUIRE(way->nodes.front().GetCoord()==originalNodes.front().GetCoord());
+    REQUIRE(way->nodes.back().GetCoord()==originalNodes.back().GetCoord());
+
+    if (simplified && originalNodes.size()>2) {
+      REQUIRE(way->nodes.size()*4<=originalNodes.size()*3);
+    }
+    else {
+      REQUIRE(way->nodes.size()==originalNodes.size());
+    }
+  }
+}
+
+/**
+ * Compares the given areas with the areas in the data file, that have the same
+ * file offset.
+ */
+static void CheckAreas(const TestData& data,
+                       const osmscout::AreaDataFile& areaDataFile,
+                       const std::vector<osmscout::AreaRef>& areas,
+                       size_t expectedCount,
+                       bool simplified)
+{
+  std::unordered_map<osmscout::FileOffset,osmscout::AreaRef> originals;
+
+  REQUIRE(areaDataFile.GetByOffset(data.areaOffsets.begin(),
+                                   data.areaOffsets.end(),
+                                   data.areaOffsets.size(),
+                                   originals));
+  REQUIRE(areas.size()==expectedCount);
+
+  for (const auto& area : areas) {
+    auto original=originals.find(area->GetFileOffset());
+
+    REQUIRE(original!=originals.end());
+    REQUIRE(area->rings.size()==original->second->rings.size());
+
+    const auto& originalNodes=original->second->rings[0].nodes;
+
+    REQUIRE(area->rings[0].nodes.size()>=3);
+
+    if (simplified && originalNodes.size()>3) {
+      REQUIRE(area->rings[0].nodes.size()*4<=originalNodes.size()*3);
+    }
+    else {
+      REQUIRE(area->rings[0].nodes.size()==originalNodes.size());
+    }
+  }
+}
+
+TEST_CASE("Simplified ways replace the original ways up to the finest level")
+{
+  TestData data;
+
+  REQUIRE(data.Import(true));
+
+  osmscout::WayDataFile    wayDataFile(0);
+  osmscout::WayLODDataFile wayLODDataFile(100);
+
+  REQUIRE(wayDataFile.Open(data.typeConfig,".",false));
+  REQUIRE(wayLODDataFile.Open(data.typeConfig,".",false));
+
+  osmscout::Magnification magnification10(osmscout::MagnificationLevel(10));
+  osmscout::Magnification magnification11(osmscout::MagnificationLevel(11));
+  osmscout::Magnification magnification12(osmscout::MagnificationLevel(12));
+  osmscout::Magnification magnification15(osmscout::MagnificationLevel(15));
+
+  REQUIRE(wayLODDataFile.HasLevel(magnification10));
+  REQUIRE(!wayLODDataFile.HasLevel(magnification15));
+  REQUIRE(wayLODDataFile.HasSameLevel(magnification11,magnification12));
+  REQUIRE(!wayLODDataFile.HasSameLevel(magnification10,magnification11));
+
+  for (const auto& magnification : {magnification10,magnification11}) {
+    std::vector<osmscout::WayRef> ways;
+
+    REQUIRE(wayLODDataFile.GetByOffset(data.wayOffsets.begin(),
+                                       data.wayOffsets.end(),
+                                       data.wayOffsets.size(),
+                                       magnification,
+                                       wayDataFile,
+                                       ways));
+
+    CheckWays(data,wayDataFile,ways,true);
+
+    // repeated request is served from the cache
+    ways.clear();
+
+    REQUIRE(wayLODDataFile.GetByOffset(data.wayOffsets.begin(),
+                                       data.wayOffsets.end(),
+                                       data.wayOffsets.size(),
+                                       magnification,
+                                       wayDataFile,
+                                       ways));
+
+    CheckWays(data,wayDataFile,ways,true);
+  }
+
+  std::vector<osmscout::WayRef> ways;
+
+  REQUIRE(wayLODDataFile.GetByOffset(data.wayOffsets.begin(),
+                                     data.wayOffsets.end(),
+                                     data.wayOffsets.size(),
+                                     magnification15,
+                                     wayDataFile,
+                                     ways));
+
+  CheckWays(data,wayDataFile,ways,false);
+}
+
+TEST_CASE("Simplified areas are resolved for block spans across pages")
+{
+  TestData data;
+
+  REQUIRE(data.Import(true));
+
+  osmscout::AreaDataFile    areaDataFile(0);
+  osmscout::AreaLODDataFile areaLODDataFile(0);
+
+  REQUIRE(areaDataFile.Open(data.typeConfig,".",false));
+  REQUIRE(areaLODDataFile.Open(data.typeConfig,".",false));
+
+  osmscout::Magnification    magnification(osmscout::MagnificationLevel(10));
+  std::vector<osmscout::DataBlockSpan> spans;
+  std::vector<osmscout::AreaRef> areas;
+
+  spans.push_back({data.areaOffsets[0],(uint32_t)objectCount});
+
+  REQUIRE(areaLODDataFile.GetByBlockSpans(spans.begin(),
+                                          spans.end(),
+                                          magnification,
+                                          areaDataFile,
+                                          areas));
+
+  CheckAreas(data,areaDataFile,areas,objectCount,true);
+
+  // Spans starting within a page and crossing page boundaries
+  spans.clear();
+  areas.clear();
+
+  spans.push_back({data.areaOffsets[250],20});
+  spans.push_back({data.areaOffsets[511],3});
+
+  REQUIRE(areaLODDataFile.GetByBlockSpans(spans.begin(),
+                                          spans.end(),
+                                          magnification,
+                                          areaDataFile,
+                                          areas));
+
+  CheckAreas(data,areaDataFile,areas,23,true);
+
+  // Spans beyond the end of the data file are rejected
+  spans.clear();
+  areas.clear();
+
+  spans.push_back({data.areaOffsets[objectCount-1],2});
+
+  REQUIRE(!areaLODDataFile.GetByBlockSpans(spans.begin(),
+                                           spans.end(),
+                                           magnification,
+                                           areaDataFile,
+                                           areas));
+}
+
+TEST_CASE("Disabled LOD import removes stale files")
+{
+  TestData data;
+
+  REQUIRE(data.Import(true));
+  REQUIRE(osmscout::ExistsInFilesystem(osmscout::WayLODDataFile::WAYSLOD_DAT));
+  REQUIRE(osmscout::ExistsInFilesystem(osmscout::AreaLODDataFile::AREASLOD_DAT));
+
+  REQUIRE(data.Import(false));
+  REQUIRE(!osmscout::ExistsInFilesystem(osmscout::WayLODDataFile::WAYSLOD_DAT));
+  REQUIRE(!osmscout::ExistsInFilesystem(osmscout::AreaLODDataFile::AREASLOD_DAT));
+}
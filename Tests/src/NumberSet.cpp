@@ -1,4 +1,7 @@
+#include <cstdio>
 #include <iostream>
+#include <random>
+#include <set>
 
 #include <osmscout/util/NumberSet.h>
 
@@ -48,6 +51,92 @@ int main()
     }
   }
 
+  if (set.GetNodeUsedCount()!=256*256-256+2) {
+    std::cerr << "Wrong count " << set.GetNodeUsedCount() << "!" << std::endl;
+    errors++;
+  }
+
+  // Sparse ids in random order, with duplicates
+  osmscout::NumberSet    sparseSet;
+  std::set<osmscout::Id> expected;
+  std::mt19937_64        generator(4711);
+
+  for (size_t i=0; i<100000; i++) {
+    osmscout::Id id=generator()%10000000000;
+
+    if (i%10==0 && !expected.empty()) {
+      id=*expected.begin();
+    }
+
+    bool isNew=expected.insert(id).second;
+
+    // Set reports, if the id is new
+    if (sparseSet.Set(id)!=isNew) {
+      std::cerr << id << " not correctly reported as " << (isNew ? "new" : "known") << "!" << std::endl;
+      errors++;
+    }
+  }
+
+  if (sparseSet.GetNodeUsedCount()!=expected.size()) {
+    std::cerr << "Wrong sparse count " << sparseSet.GetNodeUsedCount() << "!" << std::endl;
+    errors++;
+  }
+
+  for (auto id : expected) {
+    if (!sparseSet.IsSet(id) ||
+        sparseSet.IsSet(id+1)!=(expected.find(id+1)!=expected.end())) {
+      std::cerr << id << " not correctly found in sparse set!" << std::endl;
+      errors++;
+    }
+  }
+
+  // Write and read back both sets
+  const char* filename="NumberSet.dat";
+
+  try {
+    osmscout::FileWriter writer;
+
+    writer.Open(filename);
+    set.Write(writer);
+    sparseSet.Write(writer);
+    writer.Close();
+
+    osmscout::NumberSet  readSet;
+    osmscout::NumberSet  readSparseSet;
+    osmscout::FileScanner scanner;
+
+    scanner.Open(filename,osmscout::FileScanner::Sequential,false);
+    readSet.Read(scanner);
+    readSparseSet.Read(scanner);
+    scanner.Close();
+
+    if (readSet.GetNodeUsedCount()!=set.GetNodeUsedCount() ||
+        readSparseSet.GetNodeUsedCount()!=sparseSet.GetNodeUsedCount()) {
+      std::cerr << "Wrong count after reading!" << std::endl;
+      errors++;
+    }
+
+    for (size_t i=0; i<256*256+10; i++) {
+      if (readSet.IsSet(i)!=set.IsSet(i)) {
+        std::cerr << i << " not correctly read!" << std::endl;
+        errors++;
+      }
+    }
+
+    for (auto id : expected) {
+      if (!readSparseSet.IsSet(id)) {
+        std::cerr << id << " not correctly read in sparse set!" << std::endl;
+        errors++;
+      }
+    }
+  }
+  catch (osmscout::IOException& e) {
+    std::cerr << e.GetDescription() << std::endl;
+    errors++;
+  }
+
+  std::remove(filename);
+
   if (errors!=0) {
     return 1;
   }
@@ -17,6 +17,7 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 */
 
+#include <algorithm>
 #include <iostream>
 #include <limits>
 #include <random>
@@ -32,10 +33,14 @@
 /**
   Generate a number of random potential node ids in the range 0...max(long)
   and check the performance of std::set<unsigned long> against NumberSet.
+  Afterwards check insert and lookup performance and memory usage for sparse
+  ids against std::unordered_set.
 */
 
 size_t       ID_COUNT=50000000; // Number of insert/find tests bases on random numbers
 osmscout::Id UPPER_LIMIT=100000;//std::numeric_limits<osmscout::Id>::max(); // upper range for test values
+size_t       SPARSE_ID_COUNT=10000000; // Number of sparse ids
+osmscout::Id SPARSE_UPPER_LIMIT=10000000000; // upper range for sparse ids, roughly the planet node id range
 
 int main(int /*argc*/, char* /*argv*/[])
 {
@@ -131,6 +136,68 @@ int main(int /*argc*/, char* /*argv*/[])
   std::cout << "Testing " << ID_COUNT << " ids in std::set took " << stestsetTimer << std::endl;
   std::cout << "Testing " << ID_COUNT << " ids in std::unordered_set took " << stestusetTimer << std::endl;
   std::cout << "Testing " << ID_COUNT << " ids in NumberSet took " << stestnsetTimer << std::endl;
+  std::cout << "NumberSet uses " << nset.GetMemoryUsage()/1024 << " KiB for " << nset.GetNodeUsedCount() << " ids" << std::endl;
+
+  // Sparse ids, like node ids of a regional extract out of the planet id range
+  std::uniform_int_distribution<osmscout::Id> sparseDis(1, SPARSE_UPPER_LIMIT);
+
+  ids.resize(SPARSE_ID_COUNT);
+
+  for (auto& id : ids) {
+    id=sparseDis(gen);
+  }
+
+  std::sort(ids.begin(),ids.end());
+
+  std::cout << "Inserting sorted sparse ids into std::unordered_set..." << std::endl;
+
+  osmscout::StopClock insertSparseUsetTimer;
+
+  std::unordered_set<osmscout::Id> sparseUset;
+
+  for (auto id : ids) {
+    sparseUset.insert(id);
+  }
+
+  insertSparseUsetTimer.Stop();
+
+  std::cout << "Inserting sorted sparse ids into NumberSet..." << std::endl;
+
+  osmscout::StopClock insertSparseNsetTimer;
+
+  osmscout::NumberSet sparseNset;
+
+  sparseNset.Set(ids.begin(),ids.end());
+
+  insertSparseNsetTimer.Stop();
+
+  std::shuffle(ids.begin(),ids.end(),gen);
+
+  osmscout::StopClock testSparseUsetTimer;
+
+  for (auto id : ids) {
+    if (sparseUset.find(id)==sparseUset.end()) {
+      std::cerr << "unordered_set error!" << std::endl;
+    }
+  }
+
+  testSparseUsetTimer.Stop();
+
+  osmscout::StopClock testSparseNsetTimer;
+
+  for (auto id : ids) {
+    if (!sparseNset.IsSet(id)) {
+      std::cerr << "NumberSet error!" << std::endl;
+    }
+  }
+
+  testSparseNsetTimer.Stop();
+
+  std::cout << "Inserting " << SPARSE_ID_COUNT << " sparse ids into std::unordered_set took " << insertSparseUsetTimer << std::endl;
+  std::cout << "Inserting " << SPARSE_ID_COUNT << " sparse ids into NumberSet took " << insertSparseNsetTimer << std::endl;
+  std::cout << "Testing " << SPARSE_ID_COUNT << " sparse ids in std::unordered_set took " << testSparseUsetTimer << std::endl;
+  std::cout << "Testing " << SPARSE_ID_COUNT << " sparse ids in NumberSet took " << testSparseNsetTimer << std::endl;
+  std::cout << "NumberSet uses " << sparseNset.GetMemoryUsage()/1024 << " KiB for " << sparseNset.GetNodeUsedCount() << " sparse ids" << std::endl;
 
   return 0;
 }
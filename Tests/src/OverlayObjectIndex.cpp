@@ -0,0 +1,223 @@
+/*
+  OverlayObjectIndex - a test program for libosmscout
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <vector>
+
+#include <osmscout/OverlayObjectIndex.h>
+
+#include <osmscout/util/Projection.h>
+
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+static osmscout::GeoBox CreateBox(double latMin, double lonMin,
+                                  double latMax, double lonMax)
+{
+  return osmscout::GeoBox(osmscout::GeoCoord(std::max(latMin,-90.0),std::max(lonMin,-180.0)),
+                          osmscout::GeoCoord(std::min(latMax,90.0),std::min(lonMax,180.0)));
+}
+
+static osmscout::OverlayObjectRef CreateWay(const osmscout::GeoBox& box)
+{
+  std::vector<osmscout::Point> nodes;
+
+  nodes.emplace_back(0,box.GetMinCoord());
+  nodes.emplace_back(0,box.GetMaxCoord());
+
+  return std::make_shared<osmscout::OverlayWay>(nodes);
+}
+
+/**
+ * Returns all objects intersecting the given box in id order,
+ * like OverlayObjectIndex::GetObjects does
+ */
+static std::vector<osmscout::OverlayObjectRef> LinearScan(const std::map<int,osmscout::OverlayObjectRef>& objects,
+                                                          const osmscout::GeoBox& box)
+{
+  std::vector<osmscout::OverlayObjectRef> result;
+
+  for (const auto& entry : objects) {
+    if (box.Intersects(entry.second->boundingBox())) {
+      result.push_back(entry.second);
+    }
+  }
+
+  return result;
+}
+
+static void CheckIndex(const osmscout::OverlayObjectIndex& index,
+                       const std::map<int,osmscout::OverlayObjectRef>& objects,
+                       const std::vector<osmscout::GeoBox>& queries)
+{
+  REQUIRE(index.Size()==objects.size());
+
+  for (const auto& query : queries) {
+    std::vector<osmscout::OverlayObjectRef> expected=LinearScan(objects,query);
+    std::vector<osmscout::OverlayObjectRef> result;
+
+    index.GetObjects(query,result);
+
+    REQUIRE(result==expected);
+    REQUIRE(index.Intersects(query)==!expected.empty());
+  }
+}
+
+TEST_CASE("Overlay index matches linear scan")
+{
+  osmscout::OverlayObjectIndex              index;
+  std::map<int,osmscout::OverlayObjectRef>  objects;
+  std::vector<osmscout::GeoBox>             boxes;
+  std::mt19937                              generator(4711);
+  std::uniform_real_distribution<double>    latDistribution(-90.0,90.0);
+  std::uniform_real_distribution<double>    lonDistribution(-180.0,180.0);
+  std::uniform_int_distribution<int>        sizeDistribution(-6,2);
+
+  // Random boxes of all sizes, so objects end up on all index levels
+  for (size_t i=0; i<2000; i++) {
+    double lat=latDistribution(generator);
+    double lon=lonDistribution(generator);
+    double size=std::pow(10.0,sizeDistribution(generator));
+
+    boxes.push_back(CreateBox(lat,lon,lat+size,lon+size));
+  }
+
+  // Boxes at the antimeridian and the poles, touching the edges of the world
+  boxes.push_back(CreateBox(10.0,179.9,10.1,180.0));
+  boxes.push_back(CreateBox(10.0,-180.0,10.1,-179.9));
+  boxes.push_back(CreateBox(-10.0,179.0,10.0,180.0));
+  boxes.push_back(CreateBox(-10.0,-180.0,10.0,-179.0));
+  boxes.push_back(CreateBox(89.9,0.0,90.0,0.1));
+  boxes.push_back(CreateBox(-90.0,0.0,-89.9,0.1));
+  boxes.push_back(CreateBox(89.0,-180.0,90.0,180.0));
+  boxes.push_back(CreateBox(-90.0,-180.0,-89.0,180.0));
+  boxes.push_back(CreateBox(89.99999,179.99999,90.0,180.0));
+  boxes.push_back(CreateBox(-90.0,-180.0,-89.99999,-179.99999));
+  boxes.push_back(CreateBox(-90.0,-180.0,90.0,180.0));
+
+  for (size_t i=0; i<boxes.size(); i++) {
+    osmscout::OverlayObjectRef object=CreateWay(boxes[i]);
+
+    objects[int(i)]=object;
+    index.Insert(int(i),object);
+  }
+
+  // Query with the same kind of boxes, including all edge cases
+  std::vector<osmscout::GeoBox> queries(boxes.begin(),boxes.begin()+500);
+
+  queries.insert(queries.end(),boxes.end()-11,boxes.end());
+  queries.push_back(CreateBox(0.0,179.999,0.001,180.0));
+  queries.push_back(CreateBox(89.999,-0.001,90.0,0.001));
+  queries.push_back(CreateBox(-90.0,-0.001,-89.999,0.001));
+
+  CheckIndex(index,objects,queries);
+
+  REQUIRE(index.GetBoundingBox().GetMinCoord()==osmscout::GeoCoord(-90.0,-180.0));
+  REQUIRE(index.GetBoundingBox().GetMaxCoord()==osmscout::GeoCoord(90.0,180.0));
+
+  // Remove every second object and replace some others
+  for (size_t i=0; i<boxes.size(); i+=2) {
+    objects.erase(int(i));
+    index.Remove(int(i));
+  }
+
+  for (size_t i=1; i<boxes.size(); i+=10) {
+    osmscout::OverlayObjectRef object=CreateWay(boxes[(i+7)%boxes.size()]);
+
+    objects[int(i)]=object;
+    index.Insert(int(i),object);
+  }
+
+  CheckIndex(index,objects,queries);
+
+  REQUIRE(index.GetObjects().size()==objects.size());
+
+  index.Clear();
+  objects.clear();
+
+  CheckIndex(index,objects,queries);
+  REQUIRE(index.IsEmpty());
+  REQUIRE(!index.GetBoundingBox().IsValid());
+}
+
+TEST_CASE("Simplified geometry is cached per magnification level")
+{
+  osmscout::TypeConfig  typeConfig;
+  osmscout::TypeInfoRef type=std::make_shared<osmscout::TypeInfo>("_route");
+
+  type->CanBeWay(true);
+  typeConfig.RegisterType(type);
+
+  // A long way with many nodes in small zig-zag steps
+  std::vector<osmscout::Point> nodes;
+
+  for (size_t i=0; i<1000; i++) {
+    nodes.emplace_back(0,osmscout::GeoCoord(50.0+i*0.0001+(i%2)*0.00001,14.0+i*0.0001));
+  }
+
+  osmscout::OverlayWay         overlayWay(nodes);
+  osmscout::MercatorProjection lowZoom;
+  osmscout::MercatorProjection highZoom;
+
+  REQUIRE(lowZoom.Set(osmscout::GeoCoord(50.05,14.05),
+                      osmscout::Magnification(osmscout::MagnificationLevel(8)),
+                      96.0,
+                      256,256));
+  REQUIRE(highZoom.Set(osmscout::GeoCoord(50.05,14.05),
+                       osmscout::Magnification(osmscout::MagnificationLevel(20)),
+                       96.0,
+                       256,256));
+
+  osmscout::WayRef full=std::make_shared<osmscout::Way>();
+  osmscout::WayRef low=std::make_shared<osmscout::Way>();
+  osmscout::WayRef lowAgain=std::make_shared<osmscout::Way>();
+  osmscout::WayRef high=std::make_shared<osmscout::Way>();
+
+  REQUIRE(overlayWay.toWay(full,typeConfig));
+  REQUIRE(overlayWay.toWay(low,typeConfig,lowZoom));
+  REQUIRE(overlayWay.toWay(lowAgain,typeConfig,lowZoom));
+  REQUIRE(overlayWay.toWay(high,typeConfig,highZoom));
+
+  REQUIRE(full->nodes.size()==nodes.size());
+  REQUIRE(low->nodes.size()>=2);
+  REQUIRE(low->nodes.size()<full->nodes.size());
+  REQUIRE(low->nodes.size()<=high->nodes.size());
+  REQUIRE(!low->segments.empty());
+
+  // cached geometry is the same
+  REQUIRE(lowAgain->nodes.size()==low->nodes.size());
+
+  for (size_t i=0; i<low->nodes.size(); i++) {
+    REQUIRE(lowAgain->nodes[i].GetCoord()==low->nodes[i].GetCoord());
+  }
+
+  // end points are kept
+  REQUIRE(low->nodes.front().GetCoord()==nodes.front().GetCoord());
+  REQUIRE(low->nodes.back().GetCoord()==nodes.back().GetCoord());
+
+  // changing the geometry invalidates the cache
+  overlayWay.addPoint(50.2,14.2);
+
+  osmscout::WayRef changed=std::make_shared<osmscout::Way>();
+
+  REQUIRE(overlayWay.toWay(changed,typeConfig,lowZoom));
+  REQUIRE(changed->nodes.back().GetCoord()==osmscout::GeoCoord(50.2,14.2));
+}
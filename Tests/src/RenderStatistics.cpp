@@ -0,0 +1,141 @@
+/*
+  RenderStatistics - a test program for libosmscout
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <vector>
+
+#include <osmscout/MapPainterNoOp.h>
+
+#include <osmscout/util/TileId.h>
+
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+static const size_t wayCount=1000;
+
+class TestData
+{
+public:
+  osmscout::TypeConfigRef        typeConfig;
+  osmscout::StyleConfigRef       styleConfig;
+  osmscout::MapData              data;
+  osmscout::TileProjection       projection;
+  osmscout::MapParameter         parameter;
+  std::vector<osmscout::RenderStatistics> statistics;
+  bool                           styleLoaded;
+
+public:
+  TestData()
+  : typeConfig(std::make_shared<osmscout::TypeConfig>())
+  {
+    osmscout::TypeInfoRef   type=std::make_shared<osmscout::TypeInfo>("test_way");
+    osmscout::Magnification magnification(osmscout::MagnificationLevel(15));
+    osmscout::GeoCoord      center(50.08,14.41);
+
+    type->CanBeWay(true);
+    typeConfig->RegisterType(type);
+
+    styleConfig=std::make_shared<osmscout::StyleConfig>(typeConfig);
+    styleLoaded=styleConfig->LoadContent("OSS\n"
+                                         "STYLE\n"
+                                         "  [TYPE test_way] WAY { color: #ff0000; displayWidth: 0.5mm; }\n"
+                                         "END\n");
+
+    for (size_t i=0; i<wayCount; i++) {
+      osmscout::WayRef way=std::make_shared<osmscout::Way>();
+
+      way->SetType(type);
+      way->nodes.emplace_back(0,osmscout::GeoCoord(center.GetLat()+i*0.00001,center.GetLon()));
+      way->nodes.emplace_back(0,osmscout::GeoCoord(center.GetLat()+i*0.00001,center.GetLon()+0.001));
+
+      data.ways.push_back(way);
+    }
+
+    projection.Set(osmscout::OSMTileId::GetOSMTile(magnification,center),
+                   magnification,
+                   96.0,
+                   256,
+                   256);
+
+    parameter.SetRenderStatisticsCallback([this](const osmscout::RenderStatistics& renderStatistics) {
+      statistics.push_back(renderStatistics);
+    });
+  }
+};
+
+TEST_CASE("Statistics are reported once for a complete render")
+{
+  TestData                 test;
+  osmscout::MapPainterNoOp painter(test.styleConfig);
+
+  REQUIRE(test.styleLoaded);
+  REQUIRE(painter.Draw(test.projection,
+                       test.parameter,
+                       test.data));
+
+  REQUIRE(test.statistics.size()==1);
+
+  const osmscout::RenderStatistics& statistics=test.statistics.front();
+
+  REQUIRE(statistics.styleLookups>=wayCount);
+  REQUIRE(statistics.transformedPoints>0);
+  REQUIRE(statistics.stepTime[osmscout::RenderSteps::PreprocessData]>0.0);
+  REQUIRE(statistics.GetTotalTime()>0.0);
+
+  for (size_t step=osmscout::RenderSteps::FirstStep; step<=osmscout::RenderSteps::LastStep; step++) {
+    REQUIRE(statistics.stepTime[step]>=0.0);
+  }
+
+  REQUIRE(painter.GetRenderStatistics().styleLookups==statistics.styleLookups);
+}
+
+TEST_CASE("Statistics are reported for each partial render")
+{
+  TestData                 test;
+  osmscout::MapPainterNoOp painter(test.styleConfig);
+
+  REQUIRE(test.styleLoaded);
+  REQUIRE(painter.Draw(test.projection,
+                       test.parameter,
+                       test.data,
+                       osmscout::RenderSteps::FirstStep,
+                       osmscout::RenderSteps::Prerender));
+  REQUIRE(painter.Draw(test.projection,
+                       test.parameter,
+                       test.data,
+                       osmscout::RenderSteps::DrawBaseMapTiles,
+                       osmscout::RenderSteps::LastStep));
+
+  REQUIRE(test.statistics.size()==2);
+
+  const osmscout::RenderStatistics& first=test.statistics[0];
+  const osmscout::RenderStatistics& second=test.statistics[1];
+
+  // Ways are prepared during preprocessing, that is part of the first call only
+  REQUIRE(first.styleLookups>=wayCount);
+  REQUIRE(first.stepTime[osmscout::RenderSteps::PreprocessData]>0.0);
+  REQUIRE(second.styleLookups<first.styleLookups);
+
+  for (size_t step=osmscout::RenderSteps::FirstStep; step<=osmscout::RenderSteps::LastStep; step++) {
+    if (step<=osmscout::RenderSteps::Prerender) {
+      REQUIRE(second.stepTime[step]==0.0);
+    }
+    else {
+      REQUIRE(first.stepTime[step]==0.0);
+    }
+  }
+}
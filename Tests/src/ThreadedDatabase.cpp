@@ -479,6 +479,16 @@ int main(int argc, char* argv[])
 
   std::cout << "Done." << std::endl;
 
+  std::cout << "Warming up database..." << std::endl;
+
+  if (!database->Warmup().get()) {
+    std::cerr << "Cannot warm up database" << std::endl;
+
+    return 1;
+  }
+
+  std::cout << "Done." << std::endl;
+
   // Style Config
 
   std::cout << "Loading style config..." << std::endl;
@@ -0,0 +1,296 @@
+/*
+  TypeConfigLookup - a test program for libosmscout
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <osmscout/TypeConfig.h>
+
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+/**
+ * Result of classifying one tag map as node, way/area and relation
+ */
+struct Classification
+{
+  std::string node;
+  std::string way;
+  std::string area;
+  std::string relation;
+
+  bool operator==(const Classification& other) const
+  {
+    return node==other.node &&
+           way==other.way &&
+           area==other.area &&
+           relation==other.relation;
+  }
+};
+
+std::ostream& operator<<(std::ostream& stream, const Classification& classification)
+{
+  stream << "node: " << classification.node;
+  stream << " way: " << classification.way;
+  stream << " area: " << classification.area;
+  stream << " relation: " << classification.relation;
+
+  return stream;
+}
+
+class TestConfig
+{
+public:
+  osmscout::TypeConfig typeConfig;
+
+  osmscout::TagId tagAmenity;
+  osmscout::TagId tagHighway;
+  osmscout::TagId tagLanduse;
+  osmscout::TagId tagNatural;
+  osmscout::TagId tagShop;
+  osmscout::TagId tagName;
+  osmscout::TagId tagBuilding;
+  osmscout::TagId tagRoute;
+  osmscout::TagId tagType;
+  osmscout::TagId tagLayer;
+  osmscout::TagId tagAccess;
+  osmscout::TagId tagOther;
+
+private:
+  osmscout::TagConditionRef Equals(osmscout::TagId tag,
+                                   const std::string& value)
+  {
+    return std::make_shared<osmscout::TagBinaryCondition>(tag,
+                                                          osmscout::operatorEqual,
+                                                          value);
+  }
+
+  osmscout::TagConditionRef Exists(osmscout::TagId tag)
+  {
+    return std::make_shared<osmscout::TagExistsCondition>(tag);
+  }
+
+  void AddType(const std::string& name,
+               unsigned char types,
+               const osmscout::TagConditionRef& condition)
+  {
+    osmscout::TypeInfoRef type=std::make_shared<osmscout::TypeInfo>(name);
+
+    type->CanBeNode(types & osmscout::TypeInfo::typeNode);
+    type->CanBeWay(types & osmscout::TypeInfo::typeWay);
+    type->CanBeArea(types & osmscout::TypeInfo::typeArea);
+    type->CanBeRelation(types & osmscout::TypeInfo::typeRelation);
+    type->AddCondition(types,condition);
+
+    typeConfig.RegisterType(type);
+  }
+
+public:
+  TestConfig()
+  {
+    osmscout::TagRegistry& registry=typeConfig.GetTagRegistry();
+
+    tagAmenity=registry.RegisterTag("amenity");
+    tagHighway=registry.RegisterTag("highway");
+    tagLanduse=registry.RegisterTag("landuse");
+    tagNatural=registry.RegisterTag("natural");
+    tagShop=registry.RegisterTag("shop");
+    tagName=registry.RegisterTag("name");
+    tagBuilding=registry.RegisterTag("building");
+    tagRoute=registry.RegisterTag("route");
+    tagType=registry.GetTagId("type");
+    tagLayer=registry.RegisterTag("layer");
+    tagAccess=registry.RegisterTag("access");
+    tagOther=registry.RegisterTag("other");
+
+    AddType("amenity_restaurant",
+            osmscout::TypeInfo::typeNode | osmscout::TypeInfo::typeArea,
+            Equals(tagAmenity,"restaurant"));
+
+    AddType("highway_residential",
+            osmscout::TypeInfo::typeWay,
+            Equals(tagHighway,"residential"));
+
+    osmscout::TagIsInConditionRef majorRoad=std::make_shared<osmscout::TagIsInCondition>(tagHighway);
+
+    majorRoad->AddTagValue("primary");
+    majorRoad->AddTagValue("secondary");
+
+    AddType("highway_major",
+            osmscout::TypeInfo::typeWay,
+            majorRoad);
+
+    // Multi-condition: one of the tags must match
+    osmscout::TagBoolConditionRef wood=std::make_shared<osmscout::TagBoolCondition>(osmscout::TagBoolCondition::boolOr);
+
+    wood->AddCondition(Equals(tagLanduse,"forest"));
+    wood->AddCondition(Equals(tagNatural,"wood"));
+
+    AddType("wood",
+            osmscout::TypeInfo::typeArea,
+            wood);
+
+    // Multi-condition: all of the tags must match
+    osmscout::TagBoolConditionRef namedShop=std::make_shared<osmscout::TagBoolCondition>(osmscout::TagBoolCondition::boolAnd);
+
+    namedShop->AddCondition(Exists(tagShop));
+    namedShop->AddCondition(Exists(tagName));
+
+    AddType("shop_named",
+            osmscout::TypeInfo::typeNode | osmscout::TypeInfo::typeArea,
+            namedShop);
+
+    AddType("shop",
+            osmscout::TypeInfo::typeNode | osmscout::TypeInfo::typeArea,
+            Exists(tagShop));
+
+    AddType("building",
+            osmscout::TypeInfo::typeArea,
+            Exists(tagBuilding));
+
+    AddType("layer_not_zero",
+            osmscout::TypeInfo::typeWay,
+            std::make_shared<osmscout::TagBinaryCondition>(tagLayer,
+                                                           osmscout::operatorNotEqual,
+                                                           "0"));
+
+    osmscout::TagBoolConditionRef route=std::make_shared<osmscout::TagBoolCondition>(osmscout::TagBoolCondition::boolAnd);
+
+    route->AddCondition(Equals(tagType,"route"));
+    route->AddCondition(std::make_shared<osmscout::TagNotCondition>(Equals(tagRoute,"ferry")));
+
+    AddType("route_not_ferry",
+            osmscout::TypeInfo::typeRelation,
+            route);
+
+    // A condition without any trigger tag, it must be evaluated for every object
+    AddType("no_access",
+            osmscout::TypeInfo::typeNode | osmscout::TypeInfo::typeWay,
+            std::make_shared<osmscout::TagNotCondition>(Exists(tagAccess)));
+  }
+
+  Classification Classify(const osmscout::TagMap& tagMap) const
+  {
+    Classification        result;
+    osmscout::TypeInfoRef wayType;
+    osmscout::TypeInfoRef areaType;
+
+    typeConfig.GetWayAreaType(tagMap,
+                              wayType,
+                              areaType);
+
+    result.node=typeConfig.GetNodeType(tagMap)->GetName();
+    result.way=wayType->GetName();
+    result.area=areaType->GetName();
+    result.relation=typeConfig.GetRelationType(tagMap)->GetName();
+
+    return result;
+  }
+};
+
+TEST_CASE("Compiled type lookup matches linear condition scan")
+{
+  TestConfig                          config;
+  std::vector<osmscout::TagMap>       tagMaps;
+  std::vector<Classification>         expected;
+
+  // Explicit cases: matching, not matching and multi-condition tag sets
+  tagMaps.push_back({{config.tagAmenity,"restaurant"}});
+  tagMaps.push_back({{config.tagAmenity,"bar"},{config.tagAccess,"no"}});
+  tagMaps.push_back({{config.tagOther,"value"},{config.tagAccess,"yes"}});
+  tagMaps.push_back({{config.tagHighway,"secondary"},{config.tagLayer,"1"}});
+  tagMaps.push_back({{config.tagNatural,"wood"},{config.tagAccess,"private"}});
+  tagMaps.push_back({{config.tagShop,"bakery"},{config.tagName,"Baker"}});
+  tagMaps.push_back({{config.tagShop,"bakery"},{config.tagAccess,"yes"}});
+  tagMaps.push_back({{config.tagType,"multipolygon"},{config.tagLanduse,"forest"}});
+  tagMaps.push_back({{config.tagType,"route"},{config.tagRoute,"ferry"}});
+  tagMaps.push_back({{config.tagType,"route"},{config.tagRoute,"bus"}});
+
+  // Random tag sets over all tags and a few values per tag
+  std::vector<osmscout::TagId> tags={config.tagAmenity,
+                                     config.tagHighway,
+                                     config.tagLanduse,
+                                     config.tagNatural,
+                                     config.tagShop,
+                                     config.tagName,
+                                     config.tagBuilding,
+                                     config.tagRoute,
+                                     config.tagType,
+                                     config.tagLayer,
+                                     config.tagAccess,
+                                     config.tagOther};
+  std::vector<std::string>     values={"restaurant","residential","primary","secondary",
+                                       "forest","wood","yes","0","1",
+                                       "multipolygon","route","ferry"};
+  std::mt19937                 generator(4711);
+
+  for (size_t i=0; i<10000; i++) {
+    osmscout::TagMap tagMap;
+    size_t           tagCount=generator()%5;
+
+    for (size_t t=0; t<tagCount; t++) {
+      tagMap[tags[generator()%tags.size()]]=values[generator()%values.size()];
+    }
+
+    tagMaps.push_back(tagMap);
+  }
+
+  // Lookup tables are not built for programmatically created configurations
+  for (const auto& tagMap : tagMaps) {
+    expected.push_back(config.Classify(tagMap));
+  }
+
+  config.typeConfig.CompileLookupTables();
+
+  for (size_t i=0; i<tagMaps.size(); i++) {
+    REQUIRE(config.Classify(tagMaps[i])==expected[i]);
+  }
+
+  REQUIRE(expected[0].node=="amenity_restaurant");
+  REQUIRE(expected[0].area=="amenity_restaurant");
+  REQUIRE(expected[1].node==config.typeConfig.typeInfoIgnore->GetName());
+  REQUIRE(expected[1].way==config.typeConfig.typeInfoIgnore->GetName());
+  REQUIRE(expected[2].node==config.typeConfig.typeInfoIgnore->GetName());
+  REQUIRE(expected[2].way==config.typeConfig.typeInfoIgnore->GetName());
+  REQUIRE(expected[3].node=="no_access");
+  REQUIRE(expected[3].way=="highway_major");
+  REQUIRE(expected[4].area=="wood");
+  REQUIRE(expected[5].node=="shop_named");
+  REQUIRE(expected[6].node=="shop");
+  REQUIRE(expected[7].relation=="wood");
+  REQUIRE(expected[8].relation==config.typeConfig.typeInfoIgnore->GetName());
+  REQUIRE(expected[9].relation=="route_not_ferry");
+}
+
+TEST_CASE("Compiled tag lookup matches registered tags")
+{
+  TestConfig config;
+
+  config.typeConfig.CompileLookupTables();
+
+  const osmscout::TagRegistry& registry=config.typeConfig.GetTagRegistry();
+
+  REQUIRE(registry.GetTagId("amenity")==config.tagAmenity);
+  REQUIRE(registry.GetTagId("highway")==config.tagHighway);
+  REQUIRE(registry.GetTagId("name")==config.tagName);
+  REQUIRE(registry.GetTagId("type")==config.tagType);
+  REQUIRE(registry.GetTagId("other")==config.tagOther);
+  REQUIRE(registry.GetTagId("unknown")==osmscout::tagIgnore);
+  REQUIRE(registry.GetTagId("")==osmscout::tagIgnore);
+}
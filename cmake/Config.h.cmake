@@ -85,6 +85,11 @@
 #cmakedefine HAVE_MMX 1
 #endif
 
+/* Define to 1 if you have the `pread' function. */
+#ifndef HAVE_PREAD
+#cmakedefine HAVE_PREAD 1
+#endif
+
 /* Define to 1 if you have the `posix_fadvise' function. */
 #ifndef HAVE_POSIX_FADVISE
 #cmakedefine HAVE_POSIX_FADVISE 1
@@ -23,6 +23,7 @@
 #include <QObject>
 #include <QMutex>
 #include <QDebug>
+#include <QList>
 #include <QMap>
 #include <QThread>
 
@@ -40,15 +41,20 @@ namespace osmscout {
 
 /**
  * \ingroup QtAPI
+ *
+ * Breaker may have parent breakers, it is aborted when it is broken
+ * itself or when any of its parents is aborted.
  */
 class OSMSCOUT_CLIENT_QT_API QBreaker : public osmscout::Breaker
 {
 private:
-  mutable QMutex mutex;
-  bool           aborted;
+  mutable QMutex                  mutex;
+  bool                            aborted;
+  QList<osmscout::BreakerRef>     parents;
 
 public:
   QBreaker();
+  explicit QBreaker(const QList<osmscout::BreakerRef> &parents);
 
   void Break();
   bool IsAborted() const;
@@ -101,6 +107,13 @@ private:
 public slots:
   void onThreadFinished();
 
+signals:
+  /**
+   * Emitted by CancelDataLoading. Jobs waiting for data of aborted loading
+   * have to release their database lock, aborted tiles are never completed.
+   */
+  void dataLoadingCancelled();
+
 public: // TODO: make it private, ensure thread safety
   QString                                 path;
   osmscout::DatabaseRef                   database;
@@ -108,7 +121,7 @@ public: // TODO: make it private, ensure thread safety
   osmscout::LocationServiceRef            locationService;
   osmscout::LocationDescriptionServiceRef locationDescriptionService;
   osmscout::MapServiceRef                 mapService;
-  osmscout::BreakerRef                    dataLoadingBreaker;
+  osmscout::BreakerRef                    dataLoadingBreaker; //!< breaker of current data loading epoch, use GetDataLoadingBreaker
 
   osmscout::StyleConfigRef          styleConfig;
 
@@ -134,6 +147,18 @@ public: // TODO: make it private, ensure thread safety
     close();
   };
 
+  /**
+   * Breaker of the current data loading epoch.
+   * It is aborted when data loading is cancelled by CancelDataLoading.
+   */
+  osmscout::BreakerRef GetDataLoadingBreaker();
+
+  /**
+   * Abort all data loading started with breaker of the current epoch
+   * and start new epoch
+   */
+  void CancelDataLoading();
+
   bool LoadStyle(QString stylesheetFilename,
                  std::unordered_map<std::string,bool> stylesheetFlags,
                  QList<StyleError> &errors);
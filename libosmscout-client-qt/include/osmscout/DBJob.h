@@ -59,6 +59,7 @@ class OSMSCOUT_CLIENT_QT_API DBLoadJob : public DBJob{
   Q_OBJECT
 protected:
   bool                                            closeOnFinish;
+  bool                                            aborted;         //!< loading was aborted or failed, missing tiles will not be completed
   osmscout::BreakerRef                            breaker;
   osmscout::MercatorProjection                    lookupProjection;
   osmscout::AreaSearchParameter                   searchParameter;
@@ -70,6 +71,7 @@ protected:
 
 protected slots:
   void onTileStateChanged(QString dbPath,const osmscout::TileRef tile);
+  void onDataLoadingCancelled();
 
 signals:
   /**
@@ -94,6 +96,14 @@ public:
   virtual void Close();
 
   bool IsFinished() const;
+
+  /**
+   * Loading was aborted (by Close or by cancelling data loading of some database)
+   * or failed. Job is closed already and finished signal was emitted
+   * with tiles loaded so far.
+   */
+  bool IsAborted() const;
+
   QMap<QString,QMap<osmscout::TileKey,osmscout::TileRef>> GetAllTiles() const;
 
   /**
@@ -157,6 +157,10 @@ protected:
 
 protected:
 
+  /**
+   * Abort data loading of all running jobs. Data loading started
+   * later is not affected.
+   */
   void CancelCurrentDataLoading();
 
   bool isInitializedInternal();
@@ -29,6 +29,7 @@
 
 #include <osmscout/ClientQtImportExport.h>
 #include <osmscout/OverlayObject.h>
+#include <osmscout/OverlayObjectIndex.h>
 
 namespace osmscout {
 
@@ -88,7 +89,7 @@ protected:
   QString     units;
 
   mutable QMutex                 overlayLock;
-  std::map<int,OverlayObjectRef> overlayObjectMap; // <! map guarded by overlayLock, OverlayWay object is multithread
+  OverlayObjectIndex             overlayObjectIndex; // <! index guarded by overlayLock, OverlayWay object is multithread
 
 signals:
   void Redraw();
@@ -115,6 +116,11 @@ protected:
 
   osmscout::GeoBox overlayObjectsBox() const;
 
+  /**
+   * Check if some overlay object intersects given box
+   */
+  bool hasOverlayObjects(const osmscout::GeoBox &requestBox) const;
+
   void getOverlayObjects(std::vector<OverlayObjectRef> &objs,
                          osmscout::GeoBox requestBox) const;
 
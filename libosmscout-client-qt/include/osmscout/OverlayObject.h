@@ -29,8 +29,11 @@
 #include <osmscout/Area.h>
 #include <osmscout/Node.h>
 #include <osmscout/util/GeoBox.h>
+#include <osmscout/util/Projection.h>
 #include <osmscout/ClientQtImportExport.h>
 
+#include <map>
+
 namespace osmscout {
 
 /**
@@ -49,9 +52,20 @@ class OSMSCOUT_CLIENT_QT_API OverlayObject : public QObject
   Q_PROPERTY(QString name READ getName WRITE setName)
 
 protected:
+  /**
+   * Geometry simplified for rendering on one magnification level
+   */
+  struct SimplifiedGeometry
+  {
+    double                       dpi{0};        //!< DPI the geometry was simplified for
+    std::vector<osmscout::Point> nodes;         //!< Nodes visible on the magnification level
+    std::vector<SegmentGeoBox>   segmentsBoxes; //!< Segment boxes of the simplified nodes
+  };
+
   QString                             typeName;
   std::vector<osmscout::Point>        nodes;
   mutable std::vector<SegmentGeoBox>  segmentsBoxes;
+  mutable std::map<uint32_t,SimplifiedGeometry> simplifiedGeometry; //!< Cache of simplified geometry by magnification level
   mutable osmscout::GeoBox            box;
   int8_t                              layer{std::numeric_limits<int8_t>::max()};
   QString                             name;
@@ -141,6 +155,10 @@ protected:
 
   // internal, lock have to be acquired
   std::vector<SegmentGeoBox> segments() const;
+
+  // internal, lock have to be acquired
+  const SimplifiedGeometry& simplified(const osmscout::Projection &projection,
+                                       bool area) const;
 };
 
 
@@ -163,6 +181,14 @@ public:
 
   bool toArea(osmscout::AreaRef &area,
               const osmscout::TypeConfig &typeConfig) const;
+
+  /**
+   * Create area with geometry simplified for given projection.
+   * Simplified geometry is cached per magnification level.
+   */
+  bool toArea(osmscout::AreaRef &area,
+              const osmscout::TypeConfig &typeConfig,
+              const osmscout::Projection &projection) const;
 };
 
 class OSMSCOUT_CLIENT_QT_API OverlayWay : public OverlayObject
@@ -184,6 +210,14 @@ public:
 
   bool toWay(osmscout::WayRef &way,
              const osmscout::TypeConfig &typeConfig) const;
+
+  /**
+   * Create way with geometry simplified for given projection.
+   * Simplified geometry is cached per magnification level.
+   */
+  bool toWay(osmscout::WayRef &way,
+             const osmscout::TypeConfig &typeConfig,
+             const osmscout::Projection &projection) const;
 };
 
 class OSMSCOUT_CLIENT_QT_API OverlayNode : public OverlayObject
@@ -0,0 +1,101 @@
+#ifndef OSMSCOUT_CLIENT_QT_OVERLAYOBJECTINDEX_H
+#define OSMSCOUT_CLIENT_QT_OVERLAYOBJECTINDEX_H
+
+/*
+ OSMScout - a Qt backend for libosmscout and libosmscout-map
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+ */
+
+#include <osmscout/OverlayObject.h>
+
+#include <osmscout/util/GeoBox.h>
+#include <osmscout/util/TileId.h>
+
+#include <osmscout/ClientQtImportExport.h>
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace osmscout {
+
+/**
+ * \ingroup QtAPI
+ *
+ * Spatial index of overlay objects. Every object is placed to the cell
+ * of the deepest magnification level where its bounding box spans
+ * at most 2x2 cells. Lookup visits just cells that may intersect
+ * the requested box, so only visible objects are returned.
+ *
+ * Index is not thread safe, caller is responsible for locking.
+ */
+class OSMSCOUT_CLIENT_QT_API OverlayObjectIndex
+{
+public:
+  static const uint32_t MaxLevel=16; //!< Deepest magnification level used for cells
+
+private:
+  struct Entry
+  {
+    OverlayObjectRef object;
+    osmscout::GeoBox box;
+    uint32_t         level;
+    osmscout::TileId tile;
+  };
+
+  using Cell=std::vector<int>;
+  using CellMap=std::unordered_map<osmscout::TileId,Cell,osmscout::TileIdHasher>;
+
+  std::map<int,Entry>      entries;           //!< All objects by their id
+  std::vector<CellMap>     levels;            //!< Cells with object ids for each magnification level
+  mutable osmscout::GeoBox boundingBox;       //!< Cached bounding box of all objects
+  mutable bool             boundingBoxValid;  //!< If the cached bounding box is valid
+
+private:
+  void Unlink(int id, const Entry& entry);
+  void CollectIds(const osmscout::GeoBox& box,
+                  std::vector<int>& ids) const;
+
+public:
+  OverlayObjectIndex();
+
+  void Insert(int id, const OverlayObjectRef& object);
+  void Remove(int id);
+  void Clear();
+
+  inline bool IsEmpty() const
+  {
+    return entries.empty();
+  }
+
+  inline size_t Size() const
+  {
+    return entries.size();
+  }
+
+  osmscout::GeoBox GetBoundingBox() const;
+
+  bool Intersects(const osmscout::GeoBox& box) const;
+
+  void GetObjects(const osmscout::GeoBox& box,
+                  std::vector<OverlayObjectRef>& objects) const;
+
+  std::map<int,OverlayObjectRef> GetObjects() const;
+};
+
+}
+
+#endif /* OSMSCOUT_CLIENT_QT_OVERLAYOBJECTINDEX_H */
@@ -27,6 +27,7 @@
 #include <QMutex>
 #include <QHash>
 #include <QMap>
+#include <QList>
 #include <QSet>
 #include <QTime>
 #include <QElapsedTimer>
@@ -106,10 +107,27 @@ public:
    */
   void clearPendingRequests();
   bool startRequestProcess(uint32_t zoomLevel, uint32_t x, uint32_t y);
+
+  /**
+   * Start pending requests with the same zoom level around the given (already started) one.
+   * Merged area is returned in xFrom..xTo, yFrom..yTo, requests started by this call
+   * (including the origin request) are returned in startedRequests.
+   * Area may contain tiles that are not requested or processed by other jobs.
+   */
   void mergeAndStartRequests(uint32_t zoomLevel, uint32_t xtile, uint32_t ytile, 
-    uint32_t &xFrom, uint32_t &xTo, uint32_t &yFrom, uint32_t &yTo, uint32_t maxWidth, uint32_t maxHeight);
+    uint32_t &xFrom, uint32_t &xTo, uint32_t &yFrom, uint32_t &yTo, uint32_t maxWidth, uint32_t maxHeight,
+    QList<TileCacheKey> &startedRequests);
   bool isRequestQueueEmpty() const;
 
+  /**
+   * Lookup pending request with the smallest distance to the given coordinate.
+   * Distance is measured in tiles of the request zoom level.
+   *
+   * @return true if there is some pending request
+   */
+  bool nearestPendingRequest(const osmscout::GeoCoord &coord,
+                             uint32_t &zoomLevel, uint32_t &x, uint32_t &y) const;
+
   /**
    * try to create new tile request. 
    * If this request don't exists already, it emit signal tileRequested and return 
@@ -22,7 +22,9 @@
  */
 
 #include <QObject>
+#include <QList>
 #include <QSettings>
+#include <QThreadPool>
 
 #include <osmscout/DataTileCache.h>
 #include <osmscout/DBThread.h>
@@ -64,14 +66,30 @@ private:
   int                           screenWidth;
   int                           screenHeight;
 
-  // data loading request
-  DBLoadJob                     *loadJob;
-  uint32_t                      loadXFrom;
-  uint32_t                      loadXTo;
-  uint32_t                      loadYFrom;
-  uint32_t                      loadYTo;
-  MagnificationLevel            loadZ;
-  size_t                        loadEpoch; // guarded by lock
+  /**
+   * Offline tiles loaded and rendered together
+   */
+  struct TileLoadRequest
+  {
+    DBLoadJob           *loadJob;
+    uint32_t            xFrom;
+    uint32_t            xTo;
+    uint32_t            yFrom;
+    uint32_t            yTo;
+    MagnificationLevel  zoom;
+    size_t              epoch;
+    QList<TileCacheKey> tiles; // requests started for this area, other tiles in the area may be owned by other requests
+  };
+
+  // data loading requests
+  QList<TileLoadRequest>        loadRequests;   // guarded by lock
+  size_t                        renderingCount; // count of requests being rendered, guarded by lock
+
+  // offline tiles are rendered in parallel by worker threads,
+  // each thread is using its own MapPainterQt (see DBInstance::GetPainter)
+  QThreadPool                   renderPool;
+
+  osmscout::GeoCoord            viewCenter; // center of last rendered view, guarded by tileCacheMutex
 
   QColor                        unknownColor;
 
@@ -85,17 +103,41 @@ public slots:
   void tileDownloaded(uint32_t zoomLevel, uint32_t x, uint32_t y, QImage image, QByteArray downloadedData);
   void tileDownloadFailed(uint32_t zoomLevel, uint32_t x, uint32_t y, bool zoomLevelOutOfRange);
   void onDatabaseLoaded(osmscout::GeoBox boundingBox);
-  void onLoadJobFinished(QMap<QString,QMap<osmscout::TileKey,osmscout::TileRef>>);
 
   void onlineTileProviderChanged();
   void onlineTilesEnabledChanged(bool);
 
   void onOfflineMapChanged(bool);
 
+private slots:
+  /**
+   * Cancel load requests started before the last epoch change
+   * and remove their tiles from the request queue.
+   * Load jobs are owned by the renderer thread, it have to be called from it.
+   */
+  void cancelStaleRequests();
+
 private:
 
   DatabaseCoverage databaseCoverageOfTile(uint32_t zoomLevel, uint32_t xtile, uint32_t ytile);
 
+  /**
+   * Called when data for the given load job are loaded,
+   * it schedules rendering of the tiles in the render pool
+   */
+  void onLoadJobFinished(DBLoadJob *job, QMap<QString,QMap<osmscout::TileKey,osmscout::TileRef>> tiles);
+
+  /**
+   * Render loaded tiles and put them to the offline cache.
+   * It is called from the render pool threads.
+   */
+  void renderTiles(const TileLoadRequest &request,
+                   const QMap<QString,QMap<osmscout::TileKey,osmscout::TileRef>> &tiles,
+                   osmscout::MapParameter drawParameter,
+                   const std::vector<OverlayObjectRef> &overlayObjects,
+                   bool renderBasemap,
+                   double dpi);
+
 public:
   TiledMapRenderer(QThread *thread,
                    SettingsRef settings,
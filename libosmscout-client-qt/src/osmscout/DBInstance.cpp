@@ -29,6 +29,13 @@ QBreaker::QBreaker()
 {
 }
 
+QBreaker::QBreaker(const QList<osmscout::BreakerRef> &parents)
+  : osmscout::Breaker(),
+    aborted(false),
+    parents(parents)
+{
+}
+
 void QBreaker::Break()
 {
   QMutexLocker locker(&mutex);
@@ -38,9 +45,21 @@ void QBreaker::Break()
 
 bool QBreaker::IsAborted() const
 {
-  QMutexLocker locker(&mutex);
+  {
+    QMutexLocker locker(&mutex);
+
+    if (aborted) {
+      return true;
+    }
+  }
+
+  for (const auto &parent:parents){
+    if (parent && parent->IsAborted()){
+      return true;
+    }
+  }
 
-  return aborted;
+  return false;
 }
 
 void QBreaker::Reset()
@@ -141,6 +160,23 @@ bool DBInstance::LoadStyle(QString stylesheetFilename,
   return true;
 }
 
+osmscout::BreakerRef DBInstance::GetDataLoadingBreaker()
+{
+  QMutexLocker locker(&mutex);
+  return dataLoadingBreaker;
+}
+
+void DBInstance::CancelDataLoading()
+{
+  {
+    QMutexLocker locker(&mutex);
+    dataLoadingBreaker->Break();
+    dataLoadingBreaker=std::make_shared<QBreaker>();
+  }
+
+  emit dataLoadingCancelled();
+}
+
 osmscout::MapPainterQt* DBInstance::GetPainter()
 {
   QMutexLocker locker(&mutex);
@@ -149,8 +185,11 @@ osmscout::MapPainterQt* DBInstance::GetPainter()
 
   if (!painterHolder.contains(QThread::currentThread())){
     painterHolder[QThread::currentThread()]=new osmscout::MapPainterQt(styleConfig);
+    // onThreadFinished have to be called in the finishing thread,
+    // with queued connection it would remove painter of the wrong thread
     connect(QThread::currentThread(), &QThread::finished,
-            this, &DBInstance::onThreadFinished);
+            this, &DBInstance::onThreadFinished,
+            Qt::DirectConnection);
   }
   return painterHolder[QThread::currentThread()];
 }
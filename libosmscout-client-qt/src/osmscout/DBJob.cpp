@@ -68,6 +68,7 @@ DBLoadJob::DBLoadJob(osmscout::MercatorProjection lookupProjection,
                      bool closeOnFinish):
   DBJob(),
   closeOnFinish(closeOnFinish),
+  aborted(false),
   breaker(std::make_shared<QBreaker>()),
   lookupProjection(lookupProjection)
 {
@@ -136,10 +137,25 @@ void DBLoadJob::Run(const osmscout::BasemapDatabaseRef& basemapDatabase,
     allTiles[db->path]=tileMap;
     loadingTiles[db->path]=tileMap;
 
+    // loading is aborted when this job is closed
+    // or when data loading of the database is cancelled,
+    // in the second case the job has to be finished on its own
+    connect(db.get(), &DBInstance::dataLoadingCancelled,
+            this, &DBLoadJob::onDataLoadingCancelled,
+            Qt::QueuedConnection);
+
+    osmscout::AreaSearchParameter dbSearchParameter(searchParameter);
+    dbSearchParameter.SetBreaker(std::make_shared<QBreaker>(QList<osmscout::BreakerRef>{breaker,
+                                                                                        db->GetDataLoadingBreaker()}));
+
     // load tiles asynchronous
-    db->mapService->LoadMissingTileDataAsync(searchParameter,
-                                             *db->styleConfig,
-                                             tiles);
+    if (!db->mapService->LoadMissingTileDataAsync(dbSearchParameter,
+                                                  *db->styleConfig,
+                                                  tiles)) {
+      // aborted tasks don't complete their tiles, so tile callbacks never finish this job
+      aborted=true;
+      break;
+    }
 
     // process already completed tiles (state callback is not called in such case)
     for (auto &tile:tiles){
@@ -149,6 +165,14 @@ void DBLoadJob::Run(const osmscout::BasemapDatabaseRef& basemapDatabase,
     }
 
   }
+  if (aborted){
+    // release the database lock immediately, DBThread may wait for it
+    // (see DBThread::CancelCurrentDataLoading)
+    qDebug() << "Loading aborted:" << this;
+    Close();
+    emit finished(loadedTiles);
+    return;
+  }
   if (relevantDatabases.empty()){
     emit finished(loadedTiles);
     //qDebug() << "Loaded completely (no relevant databases):" << this << "in" << QThread::currentThread();
@@ -163,6 +187,9 @@ void DBLoadJob::onTileStateChanged(QString dbPath,const osmscout::TileRef tile)
   if (!tile->IsComplete()){
     return; // ignore incomplete
   }
+  if (aborted){
+    return; // finished already
+  }
   // qDebug() << "Callback:" << this << "in" << QThread::currentThread();
   if (thread!=QThread::currentThread()){
     qWarning() << "Tile callback" << this << "from non Job thread" << thread << " in " << QThread::currentThread();
@@ -202,6 +229,8 @@ void DBLoadJob::Close()
 
   // deregister callbacks
   for (auto &db:databases){
+    disconnect(db.get(), &DBInstance::dataLoadingCancelled,
+               this, &DBLoadJob::onDataLoadingCancelled);
     if (callbacks.contains(db->path)){
       //qDebug() << "Remove callback for job:" << this << ":" << callbacks[db->path] << "in" << QThread::currentThread();
       db->mapService->DeregisterTileStateCallback(callbacks[db->path]);
@@ -212,11 +241,30 @@ void DBLoadJob::Close()
   DBJob::Close();
 }
 
+void DBLoadJob::onDataLoadingCancelled()
+{
+  if (locker==nullptr || aborted || IsFinished()){
+    return; // closed or finished already
+  }
+
+  // aborted MapService tasks never complete their tiles,
+  // release the database lock, DBThread is waiting for it
+  qDebug() << "Loading cancelled:" << this;
+  aborted=true;
+  Close();
+  emit finished(loadedTiles);
+}
+
 bool DBLoadJob::IsFinished() const
 {
   return loadingTiles.isEmpty();
 }
 
+bool DBLoadJob::IsAborted() const
+{
+  return aborted;
+}
+
 QMap<QString,QMap<osmscout::TileKey,osmscout::TileRef>> DBLoadJob::GetAllTiles() const
 {
   return allTiles;
@@ -196,6 +196,10 @@ void DBThread::Initialize()
 
 void DBThread::onDatabaseListChanged(QList<QDir> databaseDirectories)
 {
+  // running jobs are holding read lock, abort them
+  // to acquire write lock without waiting for data loading
+  CancelCurrentDataLoading();
+
   QWriteLocker locker(&lock);
 
   if (basemapDatabase) {
@@ -351,8 +355,9 @@ void DBThread::onDatabaseListChanged(QList<QDir> databaseDirectories)
 
 void DBThread::CancelCurrentDataLoading()
 {
+  QReadLocker locker(&lock);
   for (auto db:databases){
-    db->dataLoadingBreaker->Break();
+    db->CancelDataLoading();
   }
 }
 
@@ -406,6 +411,9 @@ void DBThread::LoadStyle(QString stylesheetFilename,
                          std::unordered_map<std::string,bool> stylesheetFlags,
                          const QString &suffix)
 {
+  // data loaded for previous style are not usable anymore
+  CancelCurrentDataLoading();
+
   QWriteLocker locker(&lock);
 
   this->stylesheetFilename = stylesheetFilename;
@@ -145,7 +145,7 @@ void MapRenderer::addOverlayObject(int id, OverlayObjectRef obj)
 {
   {
     QMutexLocker locker(&overlayLock);
-    overlayObjectMap[id]=obj;
+    overlayObjectIndex.Insert(id,obj);
   }
   InvalidateVisualCache();
   emit Redraw();
@@ -155,7 +155,7 @@ void MapRenderer::removeOverlayObject(int id)
 {
   {
     QMutexLocker locker(&overlayLock);
-    overlayObjectMap.erase(id);
+    overlayObjectIndex.Remove(id);
   }
   InvalidateVisualCache();
   emit Redraw();
@@ -166,8 +166,8 @@ void MapRenderer::removeAllOverlayObjects()
   bool change;
   {
     QMutexLocker locker(&overlayLock);
-    change=!overlayObjectMap.empty();
-    overlayObjectMap.clear();
+    change=!overlayObjectIndex.IsEmpty();
+    overlayObjectIndex.Clear();
   }
   if (change) {
     InvalidateVisualCache();
@@ -179,7 +179,7 @@ std::map<int,OverlayObjectRef> MapRenderer::getOverlayObjects() const
 {
   {
     QMutexLocker locker(&overlayLock);
-    return overlayObjectMap;
+    return overlayObjectIndex.GetObjects();
   }
 }
 
@@ -187,32 +187,21 @@ osmscout::GeoBox MapRenderer::overlayObjectsBox() const
 {
   {
     QMutexLocker locker(&overlayLock);
-    osmscout::GeoBox box;
-    for (auto &p:overlayObjectMap){
-      osmscout::GeoBox wayBox=p.second->boundingBox();
-      if (wayBox.IsValid()){
-        if (box.IsValid()){
-          box.Include(wayBox);
-        } else {
-          box=wayBox;
-        }
-      }
-    }
-    return box;
+    return overlayObjectIndex.GetBoundingBox();
   }
 }
 
+bool MapRenderer::hasOverlayObjects(const osmscout::GeoBox &requestBox) const
+{
+  QMutexLocker locker(&overlayLock);
+  return overlayObjectIndex.Intersects(requestBox);
+}
+
 void MapRenderer::getOverlayObjects(std::vector<OverlayObjectRef> &objs,
                                     osmscout::GeoBox requestBox) const
 {
   QMutexLocker locker(&overlayLock);
-  objs.clear();
-  objs.reserve(overlayObjectMap.size());
-  for (auto &p:overlayObjectMap){
-    if (requestBox.Intersects(p.second->boundingBox())){
-      objs.push_back(p.second);
-    }
-  }
+  overlayObjectIndex.GetObjects(requestBox,objs);
 }
 
 DBRenderJob::DBRenderJob(osmscout::MercatorProjection renderProjection,
@@ -331,7 +320,7 @@ void DBRenderJob::Run(const osmscout::BasemapDatabaseRef& basemapDatabase,
           OverlayWay *ow=dynamic_cast<OverlayWay*>(o.get());
           if (ow != nullptr) {
             osmscout::WayRef w = std::make_shared<osmscout::Way>();
-            if (ow->toWay(w, *typeConfig)) {
+            if (ow->toWay(w, *typeConfig, renderProjection)) {
               data->poiWays.push_back(w);
             }
           }
@@ -339,7 +328,7 @@ void DBRenderJob::Run(const osmscout::BasemapDatabaseRef& basemapDatabase,
           OverlayArea *oa=dynamic_cast<OverlayArea*>(o.get());
           if (oa != nullptr) {
             osmscout::AreaRef a = std::make_shared<osmscout::Area>();
-            if (oa->toArea(a, *typeConfig)) {
+            if (oa->toArea(a, *typeConfig, renderProjection)) {
               data->poiAreas.push_back(a);
             }
           }
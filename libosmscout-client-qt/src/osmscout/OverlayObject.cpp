@@ -21,12 +21,18 @@
 #include <osmscout/OverlayObject.h>
 #include <osmscout/util/Geometry.h>
 #include <osmscout/util/Logger.h>
+#include <osmscout/util/Transformation.h>
 #include <osmscout/TypeFeatures.h>
 
 #include <iostream>
 
 namespace osmscout {
 
+/**
+ * Error tolerance (in pixels) used for simplification of overlay geometry
+ */
+static const double SimplificationTolerance=0.5;
+
 OverlayObject::OverlayObject(QObject *parent):
   QObject(parent),
   typeName("_route")
@@ -63,6 +69,8 @@ void OverlayObject::clear()
   QMutexLocker locker(&lock);
   nodes.clear();
   box.Invalidate();
+  segmentsBoxes.clear();
+  simplifiedGeometry.clear();
 }
 
 void OverlayObject::addPoint(double lat, double lon)
@@ -71,6 +79,7 @@ void OverlayObject::addPoint(double lat, double lon)
   nodes.push_back(osmscout::Point(0,osmscout::GeoCoord(lat,lon)));
   box.Invalidate();
   segmentsBoxes.clear();
+  simplifiedGeometry.clear();
 }
 
 osmscout::GeoBox OverlayObject::boundingBox() const
@@ -95,6 +104,68 @@ std::vector<SegmentGeoBox> OverlayObject::segments() const
   return segmentsBoxes;
 }
 
+const OverlayObject::SimplifiedGeometry& OverlayObject::simplified(const osmscout::Projection &projection,
+                                                                   bool area) const
+{
+  uint32_t           level=projection.GetMagnification().GetLevel();
+  SimplifiedGeometry &geometry=simplifiedGeometry[level];
+
+  if (geometry.dpi==projection.GetDPI() &&
+      !geometry.nodes.empty()){
+    return geometry;
+  }
+
+  geometry.dpi=projection.GetDPI();
+  geometry.nodes.clear();
+  geometry.segmentsBoxes.clear();
+
+  size_t minNodes=area ? 3 : 2;
+
+  // Simplify for the next magnification level,
+  // so the result is precise enough for fractional magnifications too
+  osmscout::MercatorProjection simplifyProjection;
+  osmscout::Magnification      magnification(osmscout::MagnificationLevel(level+1));
+
+  if (nodes.size()>minNodes &&
+      simplifyProjection.Set(boundingBoxInternal().GetCenter(),
+                             magnification,
+                             projection.GetDPI(),
+                             256,256)){
+    osmscout::TransPolygon polygon;
+
+    if (area){
+      polygon.TransformArea(simplifyProjection,
+                            osmscout::TransPolygon::quality,
+                            nodes,
+                            SimplificationTolerance);
+    }
+    else {
+      polygon.TransformWay(simplifyProjection,
+                           osmscout::TransPolygon::quality,
+                           nodes,
+                           SimplificationTolerance);
+    }
+
+    geometry.nodes.reserve(polygon.GetLength());
+    for (size_t i=polygon.GetStart(); i<=polygon.GetEnd(); i++){
+      if (polygon.points[i].draw){
+        geometry.nodes.push_back(nodes[i]);
+      }
+    }
+  }
+
+  if (geometry.nodes.size()<minNodes){
+    geometry.nodes=nodes;
+  }
+
+  osmscout::ComputeSegmentBoxes(geometry.nodes,
+                                geometry.segmentsBoxes,
+                                geometry.nodes.size(),
+                                1000);
+
+  return geometry;
+}
+
 void OverlayObject::setupFeatures(const osmscout::TypeInfoRef &type,
                                   osmscout::FeatureValueBuffer &features) const
 {
@@ -153,6 +224,31 @@ bool OverlayWay::toWay(osmscout::WayRef &way,
   return true;
 }
 
+bool OverlayWay::toWay(osmscout::WayRef &way,
+                       const osmscout::TypeConfig &typeConfig,
+                       const osmscout::Projection &projection) const
+{
+  QMutexLocker locker(&lock);
+  osmscout::TypeInfoRef type=typeConfig.GetTypeInfo(typeName.toStdString());
+  if (!type){
+    // see OSMScoutQtBuilder::AddCustomPoiType
+    osmscout::log.Warn() << "Type " << typeName.toStdString() << " is not registered for way";
+    return false;
+  }
+
+  way->SetType(type);
+
+  osmscout::FeatureValueBuffer features;
+  setupFeatures(type, features);
+  way->SetFeatures(features);
+
+  const SimplifiedGeometry &geometry=simplified(projection,false);
+  way->nodes=geometry.nodes;
+  way->bbox=boundingBoxInternal();
+  way->segments=geometry.segmentsBoxes;
+  return true;
+}
+
 OverlayArea::OverlayArea(QObject *parent):
   OverlayObject(parent){}
 
@@ -191,6 +287,36 @@ bool OverlayArea::toArea(osmscout::AreaRef &area,
   return true;
 }
 
+bool OverlayArea::toArea(osmscout::AreaRef &area,
+                         const osmscout::TypeConfig &typeConfig,
+                         const osmscout::Projection &projection) const
+{
+  QMutexLocker locker(&lock);
+  osmscout::TypeInfoRef type=typeConfig.GetTypeInfo(typeName.toStdString());
+  if (!type){
+    // see OSMScoutQtBuilder::AddCustomPoiType
+    osmscout::log.Warn() << "Type " << typeName.toStdString() << " is not registered for area";
+    return false;
+  }
+
+  const SimplifiedGeometry &geometry=simplified(projection,true);
+
+  osmscout::Area::Ring outerRing;
+  outerRing.SetType(type);
+  outerRing.MarkAsOuterRing();
+  outerRing.nodes=geometry.nodes;
+  outerRing.bbox=boundingBoxInternal();
+  outerRing.segments=geometry.segmentsBoxes;
+
+  osmscout::FeatureValueBuffer features;
+  setupFeatures(type, features);
+  outerRing.SetFeatures(features);
+
+  area->rings.push_back(std::move(outerRing));
+
+  return true;
+}
+
 OverlayNode::OverlayNode(QObject *parent):
   OverlayObject(parent){}
 
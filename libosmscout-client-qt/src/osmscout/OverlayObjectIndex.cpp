@@ -0,0 +1,227 @@
+/*
+ OSMScout - a Qt backend for libosmscout and libosmscout-map
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+ */
+
+#include <osmscout/OverlayObjectIndex.h>
+
+#include <osmscout/util/Magnification.h>
+
+#include <algorithm>
+
+namespace osmscout {
+
+OverlayObjectIndex::OverlayObjectIndex():
+  levels(MaxLevel+1),
+  boundingBoxValid(true)
+{
+}
+
+void OverlayObjectIndex::Insert(int id, const OverlayObjectRef& object)
+{
+  Remove(id);
+
+  Entry entry{object,object->boundingBox(),0,osmscout::TileId(0,0)};
+
+  if (entry.box.IsValid()){
+    // find the deepest level where the object spans at most 2x2 cells
+    uint32_t level=MaxLevel;
+    while (level>0){
+      osmscout::TileIdBox tileBox(osmscout::Magnification(osmscout::MagnificationLevel(level)),
+                                  entry.box);
+      if (tileBox.GetWidth()<=2 && tileBox.GetHeight()<=2){
+        break;
+      }
+      level--;
+    }
+
+    entry.level=level;
+    entry.tile=osmscout::TileId::GetTile(osmscout::MagnificationLevel(level),
+                                         entry.box.GetMinCoord());
+    levels[level][entry.tile].push_back(id);
+
+    if (boundingBoxValid){
+      if (boundingBox.IsValid()){
+        boundingBox.Include(entry.box);
+      } else {
+        boundingBox=entry.box;
+      }
+    }
+  }
+
+  entries.emplace(id,std::move(entry));
+}
+
+void OverlayObjectIndex::Unlink(int id, const Entry& entry)
+{
+  if (!entry.box.IsValid()){
+    return;
+  }
+
+  CellMap &cells=levels[entry.level];
+  auto    cell=cells.find(entry.tile);
+  if (cell==cells.end()){
+    return;
+  }
+
+  cell->second.erase(std::remove(cell->second.begin(),cell->second.end(),id),
+                     cell->second.end());
+  if (cell->second.empty()){
+    cells.erase(cell);
+  }
+
+  // bounding box may shrink, recompute it lazily
+  boundingBoxValid=false;
+}
+
+void OverlayObjectIndex::Remove(int id)
+{
+  auto it=entries.find(id);
+  if (it==entries.end()){
+    return;
+  }
+
+  Unlink(id,it->second);
+  entries.erase(it);
+}
+
+void OverlayObjectIndex::Clear()
+{
+  entries.clear();
+  for (auto &cells:levels){
+    cells.clear();
+  }
+  boundingBox.Invalidate();
+  boundingBoxValid=true;
+}
+
+osmscout::GeoBox OverlayObjectIndex::GetBoundingBox() const
+{
+  if (!boundingBoxValid){
+    boundingBox.Invalidate();
+    for (const auto &entry:entries){
+      if (entry.second.box.IsValid()){
+        if (boundingBox.IsValid()){
+          boundingBox.Include(entry.second.box);
+        } else {
+          boundingBox=entry.second.box;
+        }
+      }
+    }
+    boundingBoxValid=true;
+  }
+
+  return boundingBox;
+}
+
+void OverlayObjectIndex::CollectIds(const osmscout::GeoBox& box,
+                                    std::vector<int>& ids) const
+{
+  if (!box.IsValid()){
+    return;
+  }
+
+  for (uint32_t level=0; level<=MaxLevel; level++){
+    const CellMap &cells=levels[level];
+    if (cells.empty()){
+      continue;
+    }
+
+    osmscout::TileIdBox tileBox(osmscout::Magnification(osmscout::MagnificationLevel(level)),
+                                box);
+
+    // objects are registered in the cell of their minimum coordinate
+    // and span up to one cell more, so the box is extended by one cell
+    uint32_t minX=tileBox.GetMinX()>0 ? tileBox.GetMinX()-1 : 0;
+    uint32_t minY=tileBox.GetMinY()>0 ? tileBox.GetMinY()-1 : 0;
+    uint32_t maxX=tileBox.GetMaxX();
+    uint32_t maxY=tileBox.GetMaxY();
+
+    auto checkCell=[&](const Cell& cell) {
+      for (int id : cell){
+        if (box.Intersects(entries.at(id).box)){
+          ids.push_back(id);
+        }
+      }
+    };
+
+    uint64_t cellCount=uint64_t(maxX-minX+1)*uint64_t(maxY-minY+1);
+    if (cellCount>cells.size()){
+      for (const auto &cell:cells){
+        if (cell.first.GetX()>=minX && cell.first.GetX()<=maxX &&
+            cell.first.GetY()>=minY && cell.first.GetY()<=maxY){
+          checkCell(cell.second);
+        }
+      }
+    } else {
+      for (uint32_t y=minY; y<=maxY; y++){
+        for (uint32_t x=minX; x<=maxX; x++){
+          auto cell=cells.find(osmscout::TileId(x,y));
+          if (cell!=cells.end()){
+            checkCell(cell->second);
+          }
+        }
+      }
+    }
+  }
+}
+
+bool OverlayObjectIndex::Intersects(const osmscout::GeoBox& box) const
+{
+  if (entries.empty() ||
+      !GetBoundingBox().Intersects(box)){
+    return false;
+  }
+
+  std::vector<int> ids;
+  CollectIds(box,ids);
+
+  return !ids.empty();
+}
+
+void OverlayObjectIndex::GetObjects(const osmscout::GeoBox& box,
+                                    std::vector<OverlayObjectRef>& objects) const
+{
+  objects.clear();
+
+  if (entries.empty()){
+    return;
+  }
+
+  std::vector<int> ids;
+  CollectIds(box,ids);
+
+  // keep the order of object ids, it defines the rendering order
+  std::sort(ids.begin(),ids.end());
+
+  objects.reserve(ids.size());
+  for (int id : ids){
+    objects.push_back(entries.at(id).object);
+  }
+}
+
+std::map<int,OverlayObjectRef> OverlayObjectIndex::GetObjects() const
+{
+  std::map<int,OverlayObjectRef> result;
+
+  for (const auto &entry:entries){
+    result.emplace_hint(result.end(),entry.first,entry.second.object);
+  }
+
+  return result;
+}
+
+}
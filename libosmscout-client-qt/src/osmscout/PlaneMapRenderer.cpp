@@ -314,6 +314,12 @@ void PlaneMapRenderer::DrawMap()
     if (thread!=QThread::currentThread()){
       osmscout::log.Warn() << "Incorrect thread!";
     }
+    if (loadJob->IsAborted()){
+      // data are incomplete, don't replace finished image by them
+      loadJob->deleteLater();
+      loadJob=nullptr;
+      return;
+    }
 
     if (currentImage==nullptr ||
         currentImage->width()!=(int)currentWidth ||
@@ -471,6 +477,8 @@ void PlaneMapRenderer::TriggerMapRendering(const MapViewStruct& request, size_t
     QMutexLocker locker(&lock);
     if (loadJob!=nullptr){
       // TODO: check if job contains same tiles...
+      // stop loading of superseded job immediately, not when it is deleted
+      loadJob->Close();
       loadJob->deleteLater();
       loadJob=nullptr;
     }
@@ -27,6 +27,8 @@
 #include <osmscout/TileCache.h>
 #include <osmscout/OSMTile.h>
 
+#include <osmscout/util/Projection.h>
+
 namespace osmscout {
 
 using namespace std;
@@ -88,14 +90,18 @@ bool TileCache::isRequestQueueEmpty() const
 
 void TileCache::mergeAndStartRequests(uint32_t zoomLevel, uint32_t xtile, uint32_t ytile, 
                                       uint32_t &xFrom, uint32_t &xTo, uint32_t &yFrom, uint32_t &yTo,
-                                      uint32_t maxWidth, uint32_t maxHeight)
+                                      uint32_t maxWidth, uint32_t maxHeight,
+                                      QList<TileCacheKey> &startedRequests)
 {
     xFrom = xtile;
     xTo = xtile;
     yFrom = ytile;
     yTo = ytile;
 
-    TileCacheKey key = {zoomLevel, xtile, ytile};
+    // origin request is started by the caller already
+    startedRequests.clear();
+    startedRequests << TileCacheKey{zoomLevel, xtile, ytile};
+
     QMutableHashIterator<TileCacheKey, RequestState> it(requests);
     while (it.hasNext()){
         it.next();
@@ -111,9 +117,43 @@ void TileCache::mergeAndStartRequests(uint32_t zoomLevel, uint32_t xtile, uint32
             yFrom = std::min(yFrom, req.ytile);
             yTo = std::max(yTo, req.ytile);
             state.pending = false;
-            requests.insert(key, state);
+            it.setValue(state);
+            startedRequests << req;
+        }
+    }
+}
+
+bool TileCache::nearestPendingRequest(const osmscout::GeoCoord &coord,
+                                      uint32_t &zoomLevel, uint32_t &x, uint32_t &y) const
+{
+    bool found = false;
+    double minDistance = 0;
+    // keep the coordinate inside the Mercator projection, log is infinite at the poles
+    double lat = std::max(osmscout::MercatorProjection::MinLat,
+                          std::min(osmscout::MercatorProjection::MaxLat, coord.GetLat()));
+    double sinLat = std::sin(lat * GRAD_TO_RAD);
+    // fractional tile coordinates on zoom level 0
+    double worldX = (coord.GetLon() + 180.0) / 360.0;
+    double worldY = 0.5 - std::log((1.0 + sinLat) / (1.0 - sinLat)) / (4.0 * M_PI);
+
+    for (auto it = requests.constBegin(); it != requests.constEnd(); ++it){
+        if (!it.value().pending){
+            continue;
+        }
+        const TileCacheKey &req = it.key();
+        double worldRes = OSMTile::worldRes(req.zoomLevel);
+        double dx = (double)req.xtile + 0.5 - worldX * worldRes;
+        double dy = (double)req.ytile + 0.5 - worldY * worldRes;
+        double distance = dx * dx + dy * dy;
+        if (!found || distance < minDistance){
+            found = true;
+            minDistance = distance;
+            zoomLevel = req.zoomLevel;
+            x = req.xtile;
+            y = req.ytile;
         }
     }
+    return found;
 }
 
 bool TileCache::startRequestProcess(uint32_t zoomLevel, uint32_t x, uint32_t y)
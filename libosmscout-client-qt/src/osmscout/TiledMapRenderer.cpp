@@ -26,7 +26,35 @@
 #include <osmscout/system/Math.h>
 #include <osmscout/util/Logger.h>
 
+#include <QRunnable>
+
+#include <algorithm>
+#include <functional>
+
 namespace osmscout {
+
+namespace {
+/**
+ * Runnable executing given function in the render pool
+ */
+class TileRenderTask : public QRunnable
+{
+private:
+  std::function<void()> function;
+
+public:
+  explicit TileRenderTask(const std::function<void()> &function):
+    function(function)
+  {
+  }
+
+  void run() override
+  {
+    function();
+  }
+};
+}
+
 TiledMapRenderer::TiledMapRenderer(QThread *thread,
                                    SettingsRef settings,
                                    DBThreadRef dbThread,
@@ -39,13 +67,17 @@ TiledMapRenderer::TiledMapRenderer(QThread *thread,
   onlineTileCache(onlineTileCacheSize), // online tiles can be loaded from disk cache easily
   offlineTileCache(offlineTileCacheSize), // render offline tile is expensive
   tileDownloader(nullptr), // it will be created in different thread
-  loadJob(nullptr),
+  renderingCount(0),
   unknownColor(QColor::fromRgbF(1.0,1.0,1.0)) // white
 {
   QScreen *srn=QGuiApplication::primaryScreen();
   screenWidth=srn->availableSize().width();
   screenHeight=srn->availableSize().height();
 
+  // painters are cached per thread by DBInstance,
+  // keep pool threads alive to avoid creating new painters
+  renderPool.setExpiryTimeout(-1);
+  renderPool.setMaxThreadCount(std::max(1, QThread::idealThreadCount()));
 
   onlineTilesEnabled = settings->GetOnlineTilesEnabled();
   offlineTilesEnabled = settings->GetOfflineMap();
@@ -83,9 +115,11 @@ TiledMapRenderer::~TiledMapRenderer()
   if (tileDownloader != nullptr){
     delete tileDownloader;
   }
-  if (loadJob!=nullptr){
-    delete loadJob;
+  renderPool.waitForDone();
+  for (auto &request:loadRequests){
+    delete request.loadJob;
   }
+  loadRequests.clear();
 }
 
 void TiledMapRenderer::Initialize()
@@ -155,9 +189,37 @@ void TiledMapRenderer::InvalidateVisualCache()
     QMutexLocker locker(&tileCacheMutex);
     offlineTileCache.incEpoch();
   }
+  // it may be called from any thread (overlay object changes are called from UI thread),
+  // but load jobs are owned by the renderer thread, cancel them there
+  QMetaObject::invokeMethod(this, "cancelStaleRequests", Qt::QueuedConnection);
   emit Redraw();
 }
 
+void TiledMapRenderer::cancelStaleRequests()
+{
+  QMutexLocker locker(&lock);
+  QMutexLocker cacheLocker(&tileCacheMutex);
+  size_t epoch=offlineTileCache.getEpoch();
+
+  auto it=loadRequests.begin();
+  while (it!=loadRequests.end()){
+    if (it->epoch==epoch){
+      ++it;
+      continue;
+    }
+
+    // stop asynchronous loading
+    it->loadJob->Close();
+    it->loadJob->deleteLater();
+
+    for (const auto &tile:it->tiles){
+      offlineTileCache.removeRequest(tile.zoomLevel, tile.xtile, tile.ytile);
+    }
+
+    it=loadRequests.erase(it);
+  }
+}
+
 /**
  * Render map defined by request to painter
  * @param painter
@@ -184,6 +246,7 @@ bool TiledMapRenderer::RenderMap(QPainter& painter,
   }
   onlineTileCache.clearPendingRequests();
   offlineTileCache.clearPendingRequests();
+  viewCenter=request.coord;
 
   if (!TiledRenderingHelper::RenderTiles(painter,request,layerCaches,unknownColor)){
     return false;
@@ -199,7 +262,7 @@ DatabaseCoverage TiledMapRenderer::databaseCoverageOfTile(uint32_t zoomLevel, ui
   Magnification magnification(level);
   DatabaseCoverage state=dbThread->databaseCoverage(magnification,tileBoundingBox);
   if (state==DatabaseCoverage::Outside &&
-      overlayObjectsBox().Intersects(tileBoundingBox)){
+      hasOverlayObjects(tileBoundingBox)){
     return DatabaseCoverage::Intersects;
   }
   return state;
@@ -246,20 +309,27 @@ void TiledMapRenderer::onlineTileRequest(uint32_t zoomLevel, uint32_t xtile, uin
     }
 }
 
-void TiledMapRenderer::offlineTileRequest(uint32_t zoomLevel, uint32_t xtile, uint32_t ytile)
+void TiledMapRenderer::offlineTileRequest(uint32_t /*zoomLevel*/, uint32_t /*xtile*/, uint32_t /*ytile*/)
 {
     // just start loading
     QMutexLocker locker(&lock);
-    if (loadJob!=nullptr){
-        // wait until previous loading is not finished
+    if ((size_t)loadRequests.size() + renderingCount >= (size_t)renderPool.maxThreadCount()){
+        // wait until some running job is finished, requests are reemitted then
         return;
     }
+
+    uint32_t zoomLevel;
+    uint32_t xtile;
+    uint32_t ytile;
+    TileLoadRequest request;
     {
         QMutexLocker locker(&tileCacheMutex);
-        if (!offlineTileCache.startRequestProcess(zoomLevel, xtile, ytile)) // request was canceled or started already
+        // process requests from the view center first, requested tile is not important
+        if (!offlineTileCache.nearestPendingRequest(viewCenter, zoomLevel, xtile, ytile))
             return;
 
-        loadEpoch = offlineTileCache.getEpoch();
+        offlineTileCache.startRequestProcess(zoomLevel, xtile, ytile);
+        request.epoch = offlineTileCache.getEpoch();
     }
 
     DatabaseCoverage state = databaseCoverageOfTile(zoomLevel, xtile, ytile);
@@ -272,18 +342,19 @@ void TiledMapRenderer::offlineTileRequest(uint32_t zoomLevel, uint32_t xtile, ui
         {
             QMutexLocker locker(&tileCacheMutex);
             offlineTileCache.mergeAndStartRequests(zoomLevel, xtile, ytile,
-                                                   loadXFrom, loadXTo, loadYFrom, loadYTo,
-                                                   /*maxWidth*/ 5, /*maxHeight*/ 5);
+                                                   request.xFrom, request.xTo, request.yFrom, request.yTo,
+                                                   /*maxWidth*/ 5, /*maxHeight*/ 5,
+                                                   request.tiles);
         }
-        uint32_t width = (loadXTo - loadXFrom + 1);
-        uint32_t height = (loadYTo - loadYFrom + 1);
-        loadZ=MagnificationLevel(zoomLevel);
+        uint32_t width = (request.xTo - request.xFrom + 1);
+        uint32_t height = (request.yTo - request.yFrom + 1);
+        request.zoom=MagnificationLevel(zoomLevel);
 
 
         //osmscout::GeoBox tileBoundingBox = OSMTile::tileBoundingBox(zoomLevel, xtile, ytile);
         osmscout::GeoCoord tileVisualCenter = OSMTile::tileRelativeCoord(zoomLevel,
-                (double)loadXFrom + (double)width/2.0,
-                (double)loadYFrom + (double)height/2.0);
+                (double)request.xFrom + (double)width/2.0,
+                (double)request.yFrom + (double)height/2.0);
 
         double osmTileDimension = (double)OSMTile::osmTileOriginalWidth() * (mapDpi / OSMTile::tileDPI() ); // pixels
 
@@ -303,20 +374,25 @@ void TiledMapRenderer::offlineTileRequest(uint32_t zoomLevel, uint32_t xtile, ui
           maximumAreaLevel=6;
         }
 
-        loadJob=new DBLoadJob(projection,
-                              maximumAreaLevel,
-                              /* lowZoomOptimization */ true,
-                              /* closeOnFinish */ false);
+        DBLoadJob *loadJob=new DBLoadJob(projection,
+                                         maximumAreaLevel,
+                                         /* lowZoomOptimization */ true,
+                                         /* closeOnFinish */ false);
+        request.loadJob=loadJob;
 
         connect(loadJob, &DBLoadJob::finished,
-                this, &TiledMapRenderer::onLoadJobFinished);
+                this, [this,loadJob](QMap<QString,QMap<osmscout::TileKey,osmscout::TileRef>> tiles){
+                  onLoadJobFinished(loadJob, tiles);
+                });
 
+        // job may finish synchronously, register request before
+        loadRequests << request;
         dbThread->RunJob(loadJob);
 
     }else{
         // put Null image
         QMutexLocker locker(&tileCacheMutex);
-        offlineTileCache.put(zoomLevel, xtile, ytile, QImage(), loadEpoch);
+        offlineTileCache.put(zoomLevel, xtile, ytile, QImage(), request.epoch);
     }
 }
 
@@ -388,32 +464,44 @@ void TiledMapRenderer::onOfflineMapChanged(bool b)
     emit Redraw();
 }
 
-void TiledMapRenderer::onLoadJobFinished(QMap<QString,QMap<osmscout::TileKey,osmscout::TileRef>> tiles)
+void TiledMapRenderer::onLoadJobFinished(DBLoadJob *job, QMap<QString,QMap<osmscout::TileKey,osmscout::TileRef>> tiles)
 {
     QMutexLocker locker(&lock);
-    if (loadJob==nullptr){
-        // no running load job
+    auto it=std::find_if(loadRequests.begin(), loadRequests.end(),
+                         [job](const TileLoadRequest &request){
+                           return request.loadJob==job;
+                         });
+    if (it==loadRequests.end()){
+        // request was cancelled already
         return;
     }
 
-    uint32_t width = (loadXTo - loadXFrom + 1);
-    uint32_t height = (loadYTo - loadYFrom + 1);
+    TileLoadRequest request=*it;
+    loadRequests.erase(it);
 
-    osmscout::GeoCoord tileVisualCenter = OSMTile::tileRelativeCoord(loadZ.Get(),
-            (double)loadXFrom + (double)width/2.0,
-            (double)loadYFrom + (double)height/2.0);
+    // data are loaded, release database lock held by the job,
+    // this slot is called from DBLoadJob, we can't delete it now
+    job->Close();
+    job->deleteLater();
 
-    double osmTileDimension = (double)OSMTile::osmTileOriginalWidth() * (mapDpi / OSMTile::tileDPI() ); // pixels
+    if (job->IsAborted()){
+        // data are incomplete, remove requests, tiles will be requested again on next redraw
+        QMutexLocker cacheLocker(&tileCacheMutex);
+        for (const auto &tile:request.tiles){
+            offlineTileCache.removeRequest(tile.zoomLevel, tile.xtile, tile.ytile);
+        }
+        offlineTileCache.reemitRequests();
+        return;
+    }
 
-    QImage canvas((double)width * osmTileDimension,
-                  (double)height * osmTileDimension,
-                  QImage::Format_ARGB32_Premultiplied); // TODO: verify best format with profiler (callgrind)
+    uint32_t width = (request.xTo - request.xFrom + 1);
+    uint32_t height = (request.yTo - request.yFrom + 1);
 
-    QColor transparent = QColor::fromRgbF(1, 1, 1, 0.0);
-    canvas.fill(transparent);
+    osmscout::GeoCoord tileVisualCenter = OSMTile::tileRelativeCoord(request.zoom.Get(),
+            (double)request.xFrom + (double)width/2.0,
+            (double)request.yFrom + (double)height/2.0);
 
-    QPainter p;
-    p.begin(&canvas);
+    double osmTileDimension = (double)OSMTile::osmTileOriginalWidth() * (mapDpi / OSMTile::tileDPI() ); // pixels
 
     osmscout::MapParameter        drawParameter;
     std::list<std::string>        paths;
@@ -451,79 +539,140 @@ void TiledMapRenderer::onLoadJobFinished(QMap<QString,QMap<osmscout::TileKey,osm
 
     // To get accurate label drawing at tile borders, we take into account labels
     // of other than the current tile, too.
-    drawParameter.SetDropNotVisiblePointLabels(loadZ.Get() >= 14);
+    drawParameter.SetDropNotVisiblePointLabels(request.zoom.Get() >= 14);
 
     drawParameter.GetLocaleRef().SetDistanceUnits(units == "imperial" ? osmscout::Units::Imperial : osmscout::Units::Metrics);
 
-    // setup projection for these tiles
+    // overlay ways
     osmscout::MercatorProjection projection;
-    osmscout::Magnification magnification(loadZ);
+    osmscout::Magnification magnification(request.zoom);
 
     projection.Set(tileVisualCenter, /* angle */ 0, magnification, mapDpi,
-                   canvas.width(), canvas.height());
-    projection.SetLinearInterpolationUsage(loadZ.Get() >= 10);
+                   (double)width * osmTileDimension, (double)height * osmTileDimension);
 
-    // overlay ways
     std::vector<OverlayObjectRef> overlayObjects;
     osmscout::GeoBox renderBox;
     projection.GetDimensions(renderBox);
     getOverlayObjects(overlayObjects, renderBox);
 
-    //DrawMap(p, tileVisualCenter, loadZ, canvas.width(), canvas.height());
-    bool success;
+    bool   renderBasemap = !onlineTilesEnabled;
+    double dpi = mapDpi;
+
+    renderingCount++;
+    renderPool.start(new TileRenderTask([this,request,tiles,drawParameter,overlayObjects,renderBasemap,dpi](){
+      renderTiles(request, tiles, drawParameter, overlayObjects, renderBasemap, dpi);
+    }));
+}
+
+void TiledMapRenderer::renderTiles(const TileLoadRequest &request,
+                                   const QMap<QString,QMap<osmscout::TileKey,osmscout::TileRef>> &tiles,
+                                   osmscout::MapParameter drawParameter,
+                                   const std::vector<OverlayObjectRef> &overlayObjects,
+                                   bool renderBasemap,
+                                   double dpi)
+{
+    bool stale;
     {
-      DBRenderJob job(projection,
-                      tiles,
-                      &drawParameter,
-                      &p,
-                      overlayObjects,
-                      /*drawCanvasBackground*/ false,
-                      /*renderBasemap*/ !onlineTilesEnabled);
-      dbThread->RunJob(&job);
-      success=job.IsSuccess();
+        QMutexLocker locker(&tileCacheMutex);
+        stale = request.epoch != offlineTileCache.getEpoch();
     }
 
-    // this slot is called from DBLoadJob, we can't delete it now
-    loadJob->deleteLater();
-    loadJob=nullptr;
+    uint32_t width = (request.xTo - request.xFrom + 1);
+    uint32_t height = (request.yTo - request.yFrom + 1);
 
-    if (!success)  {
-      osmscout::log.Error() << "*** Rendering of data has error or was interrupted";
-      return;
-    }
+    double osmTileDimension = (double)OSMTile::osmTileOriginalWidth() * (dpi / OSMTile::tileDPI() ); // pixels
 
-    p.end();
+    QImage canvas;
+    bool success = false;
 
-    {
-        QMutexLocker locker(&tileCacheMutex);
+    if (!stale) {
+        osmscout::GeoCoord tileVisualCenter = OSMTile::tileRelativeCoord(request.zoom.Get(),
+                (double)request.xFrom + (double)width/2.0,
+                (double)request.yFrom + (double)height/2.0);
 
-        if (loadEpoch != offlineTileCache.getEpoch()){
-          qWarning() << "Rendered from outdated data" << loadEpoch << "!=" << offlineTileCache.getEpoch();
+        canvas = QImage((double)width * osmTileDimension,
+                        (double)height * osmTileDimension,
+                        QImage::Format_ARGB32_Premultiplied); // TODO: verify best format with profiler (callgrind)
+
+        QColor transparent = QColor::fromRgbF(1, 1, 1, 0.0);
+        canvas.fill(transparent);
+
+        QPainter p;
+        p.begin(&canvas);
+
+        // setup projection for these tiles
+        osmscout::MercatorProjection projection;
+        osmscout::Magnification magnification(request.zoom);
+
+        projection.Set(tileVisualCenter, /* angle */ 0, magnification, dpi,
+                       canvas.width(), canvas.height());
+        projection.SetLinearInterpolationUsage(request.zoom.Get() >= 10);
+
+        {
+          // job is created in this thread, it is using painter of this thread
+          DBRenderJob job(projection,
+                          tiles,
+                          &drawParameter,
+                          &p,
+                          overlayObjects,
+                          /*drawCanvasBackground*/ false,
+                          renderBasemap);
+          dbThread->RunJob(&job);
+          success=job.IsSuccess();
         }
 
-        if (width == 1 && height == 1){
-            offlineTileCache.put(loadZ.Get(), loadXFrom, loadYFrom, canvas, loadEpoch);
+        p.end();
+
+        if (!success)  {
+          osmscout::log.Error() << "*** Rendering of data has error or was interrupted";
+        }
+    }
+
+    {
+        QMutexLocker locker(&tileCacheMutex);
+
+        if (!success){
+            // remove requests, tiles will be requested again on next redraw,
+            // requests of other jobs in the same area are kept
+            for (const auto &tile:request.tiles){
+                offlineTileCache.removeRequest(tile.zoomLevel, tile.xtile, tile.ytile);
+            }
         }else{
-            for (uint32_t y = loadYFrom; y <= loadYTo; ++y){
-                for (uint32_t x = loadXFrom; x <= loadXTo; ++x){
+            if (request.epoch != offlineTileCache.getEpoch()){
+              qWarning() << "Rendered from outdated data" << request.epoch << "!=" << offlineTileCache.getEpoch();
+            }
 
-                    QImage tile = canvas.copy(
-                            (double)(x - loadXFrom) * osmTileDimension,
-                            (double)(y - loadYFrom) * osmTileDimension,
-                            osmTileDimension, osmTileDimension
-                            );
+            if (width == 1 && height == 1){
+                offlineTileCache.put(request.zoom.Get(), request.xFrom, request.yFrom, canvas, request.epoch);
+            }else{
+                for (uint32_t y = request.yFrom; y <= request.yTo; ++y){
+                    for (uint32_t x = request.xFrom; x <= request.xTo; ++x){
 
-                    offlineTileCache.put(loadZ.Get(), x, y, tile, loadEpoch);
+                        QImage tile = canvas.copy(
+                                (double)(x - request.xFrom) * osmTileDimension,
+                                (double)(y - request.yFrom) * osmTileDimension,
+                                osmTileDimension, osmTileDimension
+                                );
+
+                        offlineTileCache.put(request.zoom.Get(), x, y, tile, request.epoch);
+                    }
                 }
             }
         }
+    }
+
+    {
+        QMutexLocker locker(&lock);
+        renderingCount--;
+    }
 
-        // we don't process offline tile requests while there is active
-        // loading job, so we reemit requests again...
+    {
+        QMutexLocker locker(&tileCacheMutex);
+        // we don't process offline tile requests while all workers are busy,
+        // so we reemit requests again...
         offlineTileCache.reemitRequests();
     }
 
     emit Redraw();
-    //std::cout << "  put offline: " << loadZ << " xtile: " << xtile << " ytile: " << ytile << std::endl;
 }
 }
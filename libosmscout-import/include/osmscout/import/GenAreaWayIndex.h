@@ -35,11 +35,12 @@
 
 namespace osmscout {
 
-  class AreaWayIndexGenerator CLASS_FINAL : public ImportModule
+  class OSMSCOUT_IMPORT_API AreaWayIndexGenerator CLASS_FINAL : public ImportModule
   {
   private:
     typedef std::map<TileId,size_t>                 CoordCountMap;
-    typedef std::map<TileId,std::list<FileOffset> > CoordOffsetsMap;
+    typedef std::map<size_t,std::list<FileOffset> > TypeOffsetsMap;
+    typedef std::map<TileId,TypeOffsetsMap>         CoordOffsetsMap;
 
     struct TypeData
     {
@@ -49,7 +50,8 @@ namespace osmscout {
 
       TileIdBox          tileBox;
 
-      FileOffset         indexOffset; //! Position in file where the offset of the bitmap is written to
+      uint8_t              presenceShift; //! Tiles are summarized to cells of 2^presenceShift x 2^presenceShift tiles
+      std::vector<uint8_t> presence;      //! Bitset of cells (row by row) containing at least one entry
 
       TypeData();
 
@@ -60,6 +62,17 @@ namespace osmscout {
       }
     };
 
+    struct LevelData
+    {
+      MagnificationLevel  indexLevel;  //! magnification level of index
+      TileIdBox           tileBox;     //! Union of the tile boxes of all types of the level
+      std::vector<size_t> types;       //! Type indexes, the position is the type index in cell records
+
+      FileOffset          indexOffset; //! Position in file where the offset of the bitmap is written to
+
+      LevelData();
+    };
+
   private:
     bool FitsIndexCriteria(const ImportParameter& parameter,
                            Progress& progress,
@@ -78,9 +91,8 @@ namespace osmscout {
 
     bool WriteBitmap(Progress& progress,
                      FileWriter& writer,
-                     const TypeInfo& typeInfo,
-                     const TypeData& typeData,
-                     const CoordOffsetsMap& typeCellOffsets);
+                     const LevelData& levelData,
+                     const CoordOffsetsMap& cellOffsets);
 
   public:
     void GetDescription(const ImportParameter& parameter,
@@ -0,0 +1,97 @@
+#ifndef OSMSCOUT_IMPORT_GENLODDAT_H
+#define OSMSCOUT_IMPORT_GENLODDAT_H
+
+/*
+  This source is part of the libosmscout library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/import/ImportFeatures.h>
+
+#include <list>
+#include <string>
+#include <vector>
+
+#include <osmscout/import/Import.h>
+
+#include <osmscout/Area.h>
+#include <osmscout/Way.h>
+
+#include <osmscout/util/FileWriter.h>
+#include <osmscout/util/Projection.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * Generates the optional files with simplified geometries of ways and areas
+   * for a number of magnifications (see LODDataFile for the file format).
+   */
+  class OSMSCOUT_IMPORT_API LODDataGenerator CLASS_FINAL : public ImportModule
+  {
+  private:
+    static const uint32_t pageSize;
+
+    struct PageEntry
+    {
+      FileOffset objectOffset; //!< Offset of the object in the data file
+      FileOffset lodOffset;    //!< Offset of the simplified copy or 0
+    };
+
+    struct Level
+    {
+      MagnificationLevel      magnification;
+      uint32_t                entryCount;
+      std::vector<FileOffset> pageObjectOffsets;
+      std::vector<FileOffset> pageOffsets;
+    };
+
+  private:
+    WayRef Simplify(const Projection& projection,
+                    double pixel,
+                    const Way& way) const;
+
+    AreaRef Simplify(const Projection& projection,
+                     double pixel,
+                     const Area& area) const;
+
+    void WritePage(FileWriter& writer,
+                   const std::vector<PageEntry>& entries,
+                   Level& level) const;
+
+    void WriteIndex(FileWriter& writer,
+                    const std::list<Level>& levels) const;
+
+    template<class N>
+    bool GenerateLODFile(const TypeConfig& typeConfig,
+                         const ImportParameter& parameter,
+                         Progress& progress,
+                         const std::string& dataFile,
+                         bool memoryMappedData,
+                         const std::string& lodFile) const;
+
+  public:
+    void GetDescription(const ImportParameter& parameter,
+                        ImportModuleDescription& description) const override;
+
+    bool Import(const TypeConfigRef& typeConfig,
+                const ImportParameter& parameter,
+                Progress& progress) override;
+  };
+}
+
+#endif
@@ -20,10 +20,12 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <atomic>
 #include <list>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <osmscout/TypeInfoSet.h>
 
@@ -173,6 +175,22 @@ namespace osmscout {
                     const std::unordered_set<Id>& nodeUseMap,
                     AreaMergeData& job);
 
+    /**
+     * Merge area data of the given types. Called by multiple workers in parallel,
+     * each worker takes the next not yet handled type.
+     *
+     * @param nodeUseMap
+     * @param types
+     * @param nextType
+     *    Index of the next type to merge, shared by all workers
+     * @param mergeJob
+     */
+    void MergeAreasOfTypes(Progress& progress,
+                           const std::unordered_set<Id>& nodeUseMap,
+                           const std::vector<TypeInfoRef>& types,
+                           std::atomic<size_t>& nextType,
+                           std::vector<AreaMergeData>& mergeJob);
+
     bool WriteMergeResult(Progress& progress,
                           const TypeConfig& typeConfig,
                           FileScanner& scanner,
@@ -92,6 +92,21 @@ namespace osmscout {
       }
     };
 
+    /**
+     * A route node as calculated by a worker, not yet written.
+     */
+    struct RouteNodeResult
+    {
+      bool                           valid;     //!< The route node is routable and must be written
+      RouteNode                      routeNode;
+      std::vector<ObjectVariantData> variants;  //!< Object variant data in order of usage, the objectVariantIndex of the route node objects is an index into this list
+
+      RouteNodeResult()
+      : valid(false)
+      {
+      }
+    };
+
     typedef std::unordered_map<FileOffset,WayRef>                   FileOffsetWayMap;
     typedef std::unordered_map<FileOffset,AreaRef>                  FileOffsetAreaMap;
     typedef std::unordered_set<Id>                                  RouteNodeIdSet;
@@ -218,8 +233,8 @@ namespace osmscout {
 
     bool GetRouteNodePoint(Progress& progress,
                            const RawRouteNode& node,
-                           FileOffsetWayMap& waysMap,
-                           FileOffsetAreaMap& areasMap,
+                           const FileOffsetWayMap& waysMap,
+                           const FileOffsetAreaMap& areasMap,
                            Point& point) const;
 
     /*
@@ -259,6 +274,34 @@ namespace osmscout {
                                const RawRouteNode& node,
                                const ViaTurnRestrictionMap& restrictions);
 
+    /**
+     * Calculate the route node, its paths and excludes for the given raw route node.
+     * Does not modify any shared state, so it can be called for multiple route nodes
+     * in parallel.
+     */
+    void CalculateRouteNode(Progress& progress,
+                            const RawRouteNode& node,
+                            const FileOffsetWayMap& waysMap,
+                            const FileOffsetAreaMap& areasMap,
+                            const RouteNodeIdSet& routeNodeIdSet,
+                            const ViaTurnRestrictionMap& restrictions,
+                            VehicleMask vehicles,
+                            RouteNodeResult& result);
+
+    /**
+     * Calculate the route nodes of the given range of raw route nodes, storing the
+     * results in the same order starting at the given result position.
+     */
+    void CalculateRouteNodes(Progress& progress,
+                             RawRouteNodeList::const_iterator startNode,
+                             RawRouteNodeList::const_iterator endNode,
+                             const FileOffsetWayMap& waysMap,
+                             const FileOffsetAreaMap& areasMap,
+                             const RouteNodeIdSet& routeNodeIdSet,
+                             const ViaTurnRestrictionMap& restrictions,
+                             VehicleMask vehicles,
+                             std::vector<RouteNodeResult>::iterator result);
+
     bool WriteObjectVariantData(Progress& progress,
                                 const std::string& variantFilename,
                                 const std::map<ObjectVariantData,uint16_t>& routeDataMap);
@@ -20,6 +20,8 @@
  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
  */
 
+#include <mutex>
+
 #include <marisa.h>
 
 #include <osmscout/OSMScoutTypes.h>
@@ -59,6 +61,13 @@ namespace osmscout
                               Progress &progress,
                               const TypeConfig &typeConfig);
 
+    void AddKey(marisa::Keyset& keyset,
+                const std::string& keyString);
+
+    bool BuildTrie(Progress& progress,
+                   marisa::Keyset& keyset,
+                   const std::string& trieFile) const;
+
     bool BuildKeyStr(const std::string& text,
                      FileOffset offset,
                      const RefType& reftype,
@@ -69,6 +78,7 @@ namespace osmscout
     marisa::Keyset  keysetLocation;
     marisa::Keyset  keysetRegion;
     marisa::Keyset  keysetOther;
+    std::mutex      keysetMutex;      //! Guards the keysets, the data files are scanned in parallel
 
     uint8_t         offsetSizeBytes;  //! size in bytes of FileOffsets stored in the tries
   };
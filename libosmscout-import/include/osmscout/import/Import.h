@@ -137,6 +137,8 @@ namespace osmscout {
 
     size_t                       rawCoordBlockSize;        //<! Number of raw coords loaded during import in one go
 
+    bool                         allDataMemoryMaped;       //<! Use memory mapping for all data file access, overrides the individual settings
+
     bool                         rawNodeDataMemoryMaped;   //<! Use memory mapping for raw node data file access
 
     bool                         rawWayIndexMemoryMaped;   //<! Use memory mapping for raw way index file access
@@ -179,6 +181,10 @@ namespace osmscout {
     size_t                       optimizationCellSizeMax;  //<! Maximum number of entries  per index cell
     TransPolygon::OptimizeMethod optimizationWayMethod;    //<! what method to use to optimize ways
 
+    bool                         lodData;                  //<! Generate simplified geometries of ways and areas
+    MagnificationLevel           lodMinMag;                //<! Magnification of the coarsest level of simplified geometries
+    MagnificationLevel           lodMaxMag;                //<! Magnification of the finest level of simplified geometries
+
     size_t                       routeNodeBlockSize;       //<! Number of route nodes loaded during import until ways get resolved
     uint32_t                     routeNodeTileMag;         //<! Size of a routing tile
 
@@ -224,6 +230,8 @@ namespace osmscout {
 
     size_t GetRawCoordBlockSize() const;
 
+    bool GetAllDataMemoryMaped() const;
+
     bool GetRawNodeDataMemoryMaped() const;
 
     bool GetRawWayIndexMemoryMaped() const;
@@ -267,6 +275,10 @@ namespace osmscout {
     size_t GetOptimizationCellSizeMax() const;
     TransPolygon::OptimizeMethod GetOptimizationWayMethod() const;
 
+    bool GetLODData() const;
+    MagnificationLevel GetLODMinMag() const;
+    MagnificationLevel GetLODMaxMag() const;
+
     size_t GetRouteNodeBlockSize() const;
     uint32_t GetRouteNodeTileMag() const;
 
@@ -305,6 +317,8 @@ namespace osmscout {
 
     void SetRawCoordBlockSize(size_t blockSize);
 
+    void SetAllDataMemoryMaped(bool memoryMaped);
+
     void SetRawNodeDataMemoryMaped(bool memoryMaped);
 
     void SetRawWayIndexMemoryMaped(bool memoryMaped);
@@ -348,6 +362,10 @@ namespace osmscout {
     void SetOptimizationCellSizeMax(size_t optimizationCellSizeMax);
     void SetOptimizationWayMethod(TransPolygon::OptimizeMethod optimizationWayMethod);
 
+    void SetLODData(bool lodData);
+    void SetLODMinMag(MagnificationLevel lodMinMag);
+    void SetLODMaxMag(MagnificationLevel lodMaxMag);
+
     void SetRouteNodeBlockSize(size_t blockSize);
     void SetRouteNodeTileMag(uint32_t routeNodeTileMag);
 
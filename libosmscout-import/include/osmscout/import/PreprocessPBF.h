@@ -52,8 +52,13 @@ namespace osmscout {
     TagMap                           tagMap;
     std::vector<OSMId>               nodes;
     std::vector<RawRelation::Member> members;
+    std::vector<TagId>               stringTagIds; //!< Tag ids of the strings of the current block, resolved on first usage
 
   private:
+    TagId GetTagId(const TypeConfig& typeConfig,
+                   const OSMPBF::PrimitiveBlock& block,
+                   uint32_t stringIndex);
+
     bool GetPos(FILE* file,
                 FileOffset& pos) const;
 
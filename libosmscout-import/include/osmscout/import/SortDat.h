@@ -160,11 +160,9 @@ namespace osmscout {
   template <class N>
   void SortDataGenerator<N>::AddSource(const std::string& filename)
   {
-    Source source;
-
-    source.filename=filename;
-
-    sources.push_back(source);
+    // FileScanner is not copyable, so construct the source in place
+    sources.emplace_back();
+    sources.back().filename=filename;
   }
 
   template <class N>
@@ -208,7 +206,8 @@ namespace osmscout {
 
 
       dataWriter.Open(AppendFileToDir(parameter.GetDestinationDirectory(),
-                                      dataFilename));
+                                      dataFilename),
+                      FileWriter::DEFAULT_WRITE_BEHIND_SIZE);
 
       dataWriter.Write(overallDataCount);
 
@@ -421,7 +420,8 @@ namespace osmscout {
       uint32_t overallDataCount=0;
 
       dataWriter.Open(AppendFileToDir(parameter.GetDestinationDirectory(),
-                                      dataFilename));
+                                      dataFilename),
+                      FileWriter::DEFAULT_WRITE_BEHIND_SIZE);
 
       dataWriter.Write(overallDataCount);
 
@@ -41,6 +41,15 @@ namespace osmscout {
   : indexLevel(0),
     indexCells(0),
     indexEntries(0),
+    tileBox(TileId(0,0),
+            TileId(0,0)),
+    presenceShift(0)
+  {
+    // no code
+  }
+
+  AreaWayIndexGenerator::LevelData::LevelData()
+  : indexLevel(0),
     tileBox(TileId(0,0),
             TileId(0,0)),
     indexOffset(0)
@@ -155,6 +164,32 @@ namespace osmscout {
 
       typeData.tileBox=typeData.tileBox.Include(cell.first);
     }
+
+    // Summarize the filled tiles in a coarse presence bitset, that allows the
+    // index to skip rows and columns without any data without reading the bitmap.
+    // Tiles are combined until the summary has at most maxPresenceCells cells.
+    const uint64_t maxPresenceCells=4096;
+
+    typeData.presenceShift=0;
+
+    while ((uint64_t)((typeData.tileBox.GetMaxX() >> typeData.presenceShift)-(typeData.tileBox.GetMinX() >> typeData.presenceShift)+1)*
+           ((typeData.tileBox.GetMaxY() >> typeData.presenceShift)-(typeData.tileBox.GetMinY() >> typeData.presenceShift)+1)>maxPresenceCells) {
+      typeData.presenceShift++;
+    }
+
+    uint32_t presenceMinX=typeData.tileBox.GetMinX() >> typeData.presenceShift;
+    uint32_t presenceMinY=typeData.tileBox.GetMinY() >> typeData.presenceShift;
+    uint32_t presenceWidth=(typeData.tileBox.GetMaxX() >> typeData.presenceShift)-presenceMinX+1;
+    uint32_t presenceHeight=(typeData.tileBox.GetMaxY() >> typeData.presenceShift)-presenceMinY+1;
+
+    typeData.presence.assign((presenceWidth*presenceHeight+7)/8,0);
+
+    for (const auto& cell : cellFillCount) {
+      size_t bit=((cell.first.GetY() >> typeData.presenceShift)-presenceMinY)*presenceWidth+
+                 (cell.first.GetX() >> typeData.presenceShift)-presenceMinX;
+
+      typeData.presence[bit/8]|=1 << (bit%8);
+    }
   }
 
   bool AreaWayIndexGenerator::CalculateDistribution(const TypeConfig& typeConfig,
@@ -261,63 +296,74 @@ namespace osmscout {
   }
 
   /**
-   * For each cell we store a file offset to the bitmap data or 0, if there is no data for the cell. The bitmap entry itself
-   * contains the number of offsets followed by the offsets themselves (delta-encoded).
-   *
+   * For each cell of the level we store a file offset to the cell data or 0, if there is no data for the cell.
+   * The cell data contains the number of types with data in the cell followed by an entry for each type. The
+   * entry consists of the index of the type within the level, the size of the rest of the entry, the
+   * number of offsets and the offsets themselves (delta-encoded). The size allows readers to skip the
+   * entries of types they are not interested in.
    *
    * @param progress
    * @param writer
-   * @param typeInfo
-   * @param typeData
-   * @param typeCellOffsets
+   * @param levelData
+   * @param cellOffsets
    * @return
    */
   bool AreaWayIndexGenerator::WriteBitmap(Progress& progress,
                                           FileWriter& writer,
-                                          const TypeInfo& typeInfo,
-                                          const TypeData& typeData,
-                                          const CoordOffsetsMap& typeCellOffsets)
+                                          const LevelData& levelData,
+                                          const CoordOffsetsMap& cellOffsets)
   {
-    size_t indexEntries=0;
     size_t dataSize=0;
     char   buffer[10];
 
     //
-    // Calculate the number of entries and the overall size of the data in the bitmap entries
+    // Calculate the overall size of the data in the bitmap entries
     // We need the overall size of the bitmap entry data, because we would store the file offset only with
     // that much bytes we need to address the last data entry.
 
-    for (const auto& cell : typeCellOffsets) {
-      indexEntries+=cell.second.size();
+    std::map<TileId,std::vector<FileOffset>> cellTypeDataSizes;
+
+    for (const auto& cell : cellOffsets) {
+      std::vector<FileOffset>& typeDataSizes=cellTypeDataSizes[cell.first];
 
       dataSize+=EncodeNumber(cell.second.size(),
                              buffer);
 
-      FileOffset previousOffset=0;
+      for (const auto& type : cell.second) {
+        FileOffset typeDataSize=EncodeNumber(type.second.size(),
+                                             buffer);
+        FileOffset previousOffset=0;
+
+        for (const auto& offset : type.second) {
+          FileOffset data=offset-previousOffset;
 
-      for (const auto& offset : cell.second) {
-        FileOffset data=offset-previousOffset;
+          typeDataSize+=EncodeNumber(data,buffer);
+
+          previousOffset=offset;
+        }
 
-        dataSize+=EncodeNumber(data,buffer);
+        typeDataSizes.push_back(typeDataSize);
 
-        previousOffset=offset;
+        dataSize+=EncodeNumber(type.first,buffer);
+        dataSize+=EncodeNumber(typeDataSize,buffer);
+        dataSize+=typeDataSize;
       }
     }
 
     // "+1" because we add +1 to every offset, to generate offset > 0
     uint8_t dataOffsetBytes=BytesNeededToEncodeNumber(dataSize+1);
 
-    progress.Info("Writing map for "+
-                  typeInfo.GetName()+" , "+
-                  ByteSizeToString(1.0*dataOffsetBytes*typeData.tileBox.GetCount()+dataSize));
+    progress.Info("Writing map for level "+levelData.indexLevel+", "+
+                  std::to_string(levelData.types.size())+" types, "+
+                  ByteSizeToString(1.0*dataOffsetBytes*levelData.tileBox.GetCount()+dataSize));
 
     FileOffset bitmapOffset;
 
     bitmapOffset=writer.GetPos();
 
-    assert(typeData.indexOffset!=0);
+    assert(levelData.indexOffset!=0);
 
-    writer.SetPos(typeData.indexOffset);
+    writer.SetPos(levelData.indexOffset);
 
     writer.WriteFileOffset(bitmapOffset);
     writer.Write(dataOffsetBytes);
@@ -327,7 +373,7 @@ namespace osmscout {
     // Write the bitmap with offsets for each cell
     // We prefill with zero and only overwrite cells that have data
     // So zero means "no data for this cell"
-    for (size_t i=0; i<typeData.tileBox.GetCount(); i++) {
+    for (size_t i=0; i<levelData.tileBox.GetCount(); i++) {
       writer.WriteFileOffset(0,
                              dataOffsetBytes);
     }
@@ -337,11 +383,10 @@ namespace osmscout {
     dataStartOffset=writer.GetPos();
 
     // Now write the list of offsets of objects for every cell with content
-    for (const auto& cell : typeCellOffsets) {
+    for (const auto& cell : cellOffsets) {
       FileOffset bitmapCellOffset=bitmapOffset+
-                                  ((cell.first.GetY()-typeData.tileBox.GetMinY())*typeData.tileBox.GetWidth()+
-                                    cell.first.GetX()-typeData.tileBox.GetMinX())*(FileOffset)dataOffsetBytes;
-      FileOffset previousOffset=0;
+                                  ((cell.first.GetY()-levelData.tileBox.GetMinY())*levelData.tileBox.GetWidth()+
+                                    cell.first.GetX()-levelData.tileBox.GetMinX())*(FileOffset)dataOffsetBytes;
       FileOffset cellOffset;
 
       assert(bitmapCellOffset>=bitmapOffset);
@@ -359,14 +404,26 @@ namespace osmscout {
 
       writer.WriteNumber((uint32_t)cell.second.size());
 
-      // FileOffsets are already in increasing order, since
-      // File is scanned from start to end
-      for (const auto& offset : cell.second) {
-        assert(offset>previousOffset);
+      auto typeDataSize=cellTypeDataSizes[cell.first].begin();
 
-        writer.WriteNumber((FileOffset)(offset-previousOffset));
+      for (const auto& type : cell.second) {
+        FileOffset previousOffset=0;
 
-        previousOffset=offset;
+        writer.WriteNumber((uint32_t)type.first);
+        writer.WriteNumber(*typeDataSize);
+        writer.WriteNumber((uint32_t)type.second.size());
+
+        // FileOffsets are already in increasing order, since
+        // File is scanned from start to end
+        for (const auto& offset : type.second) {
+          assert(offset>previousOffset);
+
+          writer.WriteNumber((FileOffset)(offset-previousOffset));
+
+          previousOffset=offset;
+        }
+
+        ++typeDataSize;
       }
     }
 
@@ -422,51 +479,84 @@ namespace osmscout {
         size_t i=type->GetIndex();
 
         if (typeData[i].HasEntries()) {
-          uint8_t    dataOffsetBytes=0;
-          FileOffset bitmapOffset=0;
-
           writer.WriteTypeId(type->GetWayId(),
                              typeConfig->GetWayTypeIdBytes());
 
-          typeData[i].indexOffset=writer.GetPos();
-
-          writer.WriteFileOffset(bitmapOffset);
-          writer.Write(dataOffsetBytes);
           writer.WriteNumber(typeData[i].indexLevel);
           writer.WriteNumber(typeData[i].tileBox.GetMinX());
           writer.WriteNumber(typeData[i].tileBox.GetMaxX());
           writer.WriteNumber(typeData[i].tileBox.GetMinY());
           writer.WriteNumber(typeData[i].tileBox.GetMaxY());
+          writer.Write(typeData[i].presenceShift);
+          writer.Write((const char*)typeData[i].presence.data(),
+                       typeData[i].presence.size());
         }
       }
 
-      wayScanner.Open(AppendFileToDir(parameter.GetDestinationDirectory(),
-                                      WayDataFile::WAYS_DAT),
-                      FileScanner::Sequential,
-                      parameter.GetWayDataMemoryMaped());
+      // Group the types by index level, in the order of the type table above
+      std::list<LevelData> levels;
 
       for (MagnificationLevel l=parameter.GetAreaWayMinMag(); l<=maxLevel; l++) {
-        Magnification magnification(l);
-        TypeInfoSet   indexTypes(*typeConfig);
-        uint32_t      wayCount;
+        LevelData level;
 
-        wayScanner.GotoBegin();
+        level.indexLevel=l;
 
         for (const auto &type : typeConfig->GetWayTypes()) {
-          if (typeData[type->GetIndex()].HasEntries() &&
-              typeData[type->GetIndex()].indexLevel==l) {
-            indexTypes.Set(type);
+          size_t i=type->GetIndex();
+
+          if (!typeData[i].HasEntries() ||
+              typeData[i].indexLevel!=l) {
+            continue;
           }
+
+          if (level.types.empty()) {
+            level.tileBox=typeData[i].tileBox;
+          }
+          else {
+            level.tileBox=level.tileBox.Include(typeData[i].tileBox);
+          }
+
+          level.types.push_back(i);
         }
 
-        if (indexTypes.Empty()) {
-          continue;
+        if (!level.types.empty()) {
+          levels.push_back(level);
+        }
+      }
+
+      writer.Write((uint32_t)levels.size());
+
+      for (auto& level : levels) {
+        uint8_t    dataOffsetBytes=0;
+        FileOffset bitmapOffset=0;
+
+        writer.WriteNumber(level.indexLevel);
+
+        level.indexOffset=writer.GetPos();
+
+        writer.WriteFileOffset(bitmapOffset);
+        writer.Write(dataOffsetBytes);
+      }
+
+      wayScanner.Open(AppendFileToDir(parameter.GetDestinationDirectory(),
+                                      WayDataFile::WAYS_DAT),
+                      FileScanner::Sequential,
+                      parameter.GetWayDataMemoryMaped());
+
+      for (const auto& level : levels) {
+        Magnification       magnification(level.indexLevel);
+        std::vector<size_t> levelTypeIndex(typeConfig->GetTypeCount(),level.types.size());
+        uint32_t            wayCount;
+
+        for (size_t t=0; t<level.types.size(); t++) {
+          levelTypeIndex[level.types[t]]=t;
         }
 
-        progress.Info("Scanning ways for index level "+l);
+        progress.Info("Scanning ways for index level "+level.indexLevel);
 
-        std::vector<CoordOffsetsMap> typeCellOffsets(typeConfig->GetTypeCount());
+        CoordOffsetsMap cellOffsets;
 
+        wayScanner.GotoBegin();
         wayScanner.Read(wayCount);
 
         Way way;
@@ -481,27 +571,24 @@ namespace osmscout {
           way.Read(*typeConfig,
                    wayScanner);
 
-          if (!indexTypes.IsSet(way.GetType())) {
+          size_t typeIndex=levelTypeIndex[way.GetType()->GetIndex()];
+
+          if (typeIndex==level.types.size()) {
             continue;
           }
 
           TileIdBox box(magnification,way.GetBoundingBox());
 
           for (const auto& tileId : box) {
-            typeCellOffsets[way.GetType()->GetIndex()][tileId].push_back(offset);
+            cellOffsets[tileId][typeIndex].push_back(offset);
           }
         }
 
-        for (const auto &type : indexTypes) {
-          size_t index=type->GetIndex();
-
-          if (!WriteBitmap(progress,
-                           writer,
-                           *typeConfig->GetTypeInfo(index),
-                           typeData[index],
-                           typeCellOffsets[index])) {
-            return false;
-          }
+        if (!WriteBitmap(progress,
+                         writer,
+                         level,
+                         cellOffsets)) {
+          return false;
         }
       }
 
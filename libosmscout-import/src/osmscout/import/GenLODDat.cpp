@@ -0,0 +1,372 @@
+/*
+  This source is part of the libosmscout library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/import/GenLODDat.h>
+
+#include <osmscout/AreaDataFile.h>
+#include <osmscout/LODDataFile.h>
+#include <osmscout/WayDataFile.h>
+
+#include <osmscout/util/File.h>
+#include <osmscout/util/FileScanner.h>
+#include <osmscout/util/Transformation.h>
+
+namespace osmscout {
+
+  const uint32_t LODDataGenerator::pageSize=256;
+
+  void LODDataGenerator::GetDescription(const ImportParameter& /*parameter*/,
+                                        ImportModuleDescription& description) const
+  {
+    description.SetName("LODDataGenerator");
+    description.SetDescription("Simplify way and area geometries for lower magnifications");
+
+    description.AddRequiredFile(WayDataFile::WAYS_DAT);
+    description.AddRequiredFile(AreaDataFile::AREAS_DAT);
+
+    description.AddProvidedOptionalFile(WayLODDataFile::WAYSLOD_DAT);
+    description.AddProvidedOptionalFile(AreaLODDataFile::AREASLOD_DAT);
+  }
+
+  /**
+   * Returns a copy of the way with the nodes not visible at the magnification
+   * of the projection removed, or nullptr if this does not reduce the number
+   * of nodes considerably.
+   */
+  WayRef LODDataGenerator::Simplify(const Projection& projection,
+                                    double pixel,
+                                    const Way& way) const
+  {
+    if (way.nodes.size()<4) {
+      return nullptr;
+    }
+
+    TransPolygon       polygon;
+    std::vector<Point> nodes;
+
+    polygon.TransformWay(projection,
+                         TransPolygon::quality,
+                         way.nodes,
+                         pixel/8.0);
+
+    if (polygon.IsEmpty()) {
+      return nullptr;
+    }
+
+    nodes.reserve(polygon.GetLength());
+
+    for (size_t i=polygon.GetStart();
+         i<=polygon.GetEnd();
+         i++) {
+      if (polygon.points[i].draw) {
+        nodes.push_back(way.nodes[i]);
+      }
+    }
+
+    if (nodes.size()<2 ||
+        nodes.size()*4>way.nodes.size()*3 ||
+        !IsValidToWrite(nodes)) {
+      return nullptr;
+    }
+
+    WayRef copiedWay=std::make_shared<Way>(way);
+
+    copiedWay->nodes=std::move(nodes);
+    copiedWay->bbox.Invalidate();
+    copiedWay->segments.clear();
+
+    return copiedWay;
+  }
+
+  /**
+   * Returns a copy of the area with the nodes not visible at the magnification
+   * of the projection removed, or nullptr if this does not reduce the number
+   * of nodes considerably. In contrast to the low zoom optimization rings are never
+   * dropped, rings that would degenerate keep their original nodes.
+   */
+  AreaRef LODDataGenerator::Simplify(const Projection& projection,
+                                     double pixel,
+                                     const Area& area) const
+  {
+    AreaRef copiedArea=std::make_shared<Area>(area);
+    size_t  nodeCount=0;
+    size_t  copiedNodeCount=0;
+
+    for (auto& ring : copiedArea->rings) {
+      nodeCount+=ring.nodes.size();
+
+      if (ring.nodes.size()<4) {
+        copiedNodeCount+=ring.nodes.size();
+        continue;
+      }
+
+      TransPolygon       polygon;
+      std::vector<Point> nodes;
+
+      polygon.TransformArea(projection,
+                            TransPolygon::quality,
+                            ring.nodes,
+                            pixel/8.0);
+
+      if (!polygon.IsEmpty()) {
+        nodes.reserve(polygon.GetLength());
+
+        for (size_t i=polygon.GetStart();
+             i<=polygon.GetEnd();
+             i++) {
+          if (polygon.points[i].draw) {
+            nodes.push_back(ring.nodes[i]);
+          }
+        }
+      }
+
+      if (nodes.size()<3 ||
+          !IsValidToWrite(nodes)) {
+        copiedNodeCount+=ring.nodes.size();
+        continue;
+      }
+
+      copiedNodeCount+=nodes.size();
+
+      ring.nodes=std::move(nodes);
+      ring.bbox.Invalidate();
+      ring.segments.clear();
+    }
+
+    if (copiedNodeCount*4>nodeCount*3) {
+      return nullptr;
+    }
+
+    return copiedArea;
+  }
+
+  /**
+   * Writes the given entries of the table as a new page of the level. Offsets
+   * are delta encoded, the offset of the first object of the page is held in
+   * the index.
+   *
+   * @throws IOException
+   */
+  void LODDataGenerator::WritePage(FileWriter& writer,
+                                   const std::vector<PageEntry>& entries,
+                                   Level& level) const
+  {
+    FileOffset lastObjectOffset=entries.front().objectOffset;
+    FileOffset lastLODOffset=0;
+
+    level.pageObjectOffsets.push_back(entries.front().objectOffset);
+    level.pageOffsets.push_back(writer.GetPos());
+    level.entryCount+=(uint32_t)entries.size();
+
+    for (const auto& entry : entries) {
+      writer.WriteNumber(entry.objectOffset-lastObjectOffset);
+
+      if (entry.lodOffset!=0) {
+        writer.WriteNumber(entry.lodOffset-lastLODOffset);
+        lastLODOffset=entry.lodOffset;
+      }
+      else {
+        writer.WriteNumber((FileOffset)0);
+      }
+
+      lastObjectOffset=entry.objectOffset;
+    }
+  }
+
+  /**
+   * @throws IOException
+   */
+  void LODDataGenerator::WriteIndex(FileWriter& writer,
+                                    const std::list<Level>& levels) const
+  {
+    writer.WriteNumber((uint32_t)levels.size());
+
+    for (const auto& level : levels) {
+      writer.WriteNumber(level.magnification.Get());
+      writer.WriteNumber(level.entryCount);
+      writer.WriteNumber(pageSize);
+      writer.WriteNumber((uint32_t)level.pageOffsets.size());
+
+      for (size_t page=0; page<level.pageOffsets.size(); page++) {
+        writer.WriteFileOffset(level.pageObjectOffsets[page]);
+        writer.WriteFileOffset(level.pageOffsets[page]);
+      }
+    }
+  }
+
+  template<class N>
+  bool LODDataGenerator::GenerateLODFile(const TypeConfig& typeConfig,
+                                         const ImportParameter& parameter,
+                                         Progress& progress,
+                                         const std::string& dataFile,
+                                         bool memoryMappedData,
+                                         const std::string& lodFile) const
+  {
+    // Same screen geometry as for the low zoom optimizations
+    double           dpi=320.0;
+    double           pixel=0.5 /* mm */ * dpi / 25.4 /* inch */;
+    FileScanner      scanner;
+    FileWriter       writer;
+    std::list<Level> levels;
+
+    try {
+      scanner.Open(AppendFileToDir(parameter.GetDestinationDirectory(),
+                                   dataFile),
+                   FileScanner::Sequential,
+                   memoryMappedData);
+
+      writer.Open(AppendFileToDir(parameter.GetDestinationDirectory(),
+                                  lodFile));
+
+      writer.WriteFileOffset((FileOffset)0);
+
+      for (uint32_t mag=parameter.GetLODMinMag().Get();
+           mag<=parameter.GetLODMaxMag().Get();
+           mag+=2) {
+        MagnificationLevel     magnificationLevel(mag);
+        Magnification          magnification(magnificationLevel);
+        MercatorProjection     projection;
+        Level                  level;
+        std::vector<PageEntry> entries;
+        uint32_t               objectCount;
+        size_t                 copyCount=0;
+
+        progress.SetAction("Simplifying '"+dataFile+"' for magnification "+std::to_string(mag));
+
+        projection.Set(GeoCoord(0.0,0.0),magnification,dpi,800,480);
+
+        level.magnification=magnificationLevel;
+        level.entryCount=0;
+
+        entries.reserve(pageSize);
+
+        scanner.GotoBegin();
+        scanner.Read(objectCount);
+
+        for (uint32_t o=1; o<=objectCount; o++) {
+          N         object;
+          PageEntry entry;
+
+          progress.SetProgress(o,objectCount);
+
+          object.Read(typeConfig,
+                      scanner);
+
+          entry.objectOffset=object.GetFileOffset();
+          entry.lodOffset=0;
+
+          std::shared_ptr<N> copy=Simplify(projection,
+                                           pixel,
+                                           object);
+
+          if (copy) {
+            entry.lodOffset=writer.GetPos();
+
+            copy->Write(typeConfig,
+                        writer);
+
+            copyCount++;
+          }
+
+          entries.push_back(entry);
+
+          if (entries.size()==pageSize) {
+            WritePage(writer,
+                      entries,
+                      level);
+            entries.clear();
+          }
+        }
+
+        if (!entries.empty()) {
+          WritePage(writer,
+                    entries,
+                    level);
+        }
+
+        progress.Info("Simplified "+std::to_string(copyCount)+" of "+std::to_string(objectCount)+" objects for magnification "+std::to_string(mag));
+
+        levels.push_back(std::move(level));
+      }
+
+      FileOffset indexOffset=writer.GetPos();
+
+      WriteIndex(writer,
+                 levels);
+
+      writer.SetPos(0);
+      writer.WriteFileOffset(indexOffset);
+
+      writer.Close();
+      scanner.Close();
+    }
+    catch (IOException& e) {
+      progress.Error(e.GetDescription());
+      writer.CloseFailsafe();
+      scanner.CloseFailsafe();
+      return false;
+    }
+
+    return true;
+  }
+
+  bool LODDataGenerator::Import(const TypeConfigRef& typeConfig,
+                                const ImportParameter& parameter,
+                                Progress& progress)
+  {
+    std::string wayLODFilename=AppendFileToDir(parameter.GetDestinationDirectory(),
+                                               WayLODDataFile::WAYSLOD_DAT);
+    std::string areaLODFilename=AppendFileToDir(parameter.GetDestinationDirectory(),
+                                                AreaLODDataFile::AREASLOD_DAT);
+
+    if (!parameter.GetLODData()) {
+      // Do not leave files of a previous import behind, that do not match the data files
+      if (ExistsInFilesystem(wayLODFilename) &&
+          !RemoveFile(wayLODFilename)) {
+        progress.Error("Cannot delete file '"+wayLODFilename+"'");
+        return false;
+      }
+
+      if (ExistsInFilesystem(areaLODFilename) &&
+          !RemoveFile(areaLODFilename)) {
+        progress.Error("Cannot delete file '"+areaLODFilename+"'");
+        return false;
+      }
+
+      return true;
+    }
+
+    if (parameter.GetLODMinMag()>parameter.GetLODMaxMag()) {
+      progress.Error("Minimum LOD magnification is bigger than maximum LOD magnification");
+      return false;
+    }
+
+    return GenerateLODFile<Way>(*typeConfig,
+                                parameter,
+                                progress,
+                                WayDataFile::WAYS_DAT,
+                                parameter.GetWayDataMemoryMaped(),
+                                WayLODDataFile::WAYSLOD_DAT) &&
+           GenerateLODFile<Area>(*typeConfig,
+                                 parameter,
+                                 progress,
+                                 AreaDataFile::AREAS_DAT,
+                                 parameter.GetAreaDataMemoryMaped(),
+                                 AreaLODDataFile::AREASLOD_DAT);
+  }
+}
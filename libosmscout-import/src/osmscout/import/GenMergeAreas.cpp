@@ -19,6 +19,10 @@
 
 #include <osmscout/import/GenMergeAreas.h>
 
+#include <algorithm>
+#include <future>
+#include <thread>
+
 #include <osmscout/util/File.h>
 #include <osmscout/util/FileScanner.h>
 #include <osmscout/util/FileWriter.h>
@@ -496,6 +500,23 @@ namespace osmscout {
     }
   }
 
+  void MergeAreasGenerator::MergeAreasOfTypes(Progress& progress,
+                                              const std::unordered_set<Id>& nodeUseMap,
+                                              const std::vector<TypeInfoRef>& types,
+                                              std::atomic<size_t>& nextType,
+                                              std::vector<AreaMergeData>& mergeJob)
+  {
+    size_t typeIndex;
+
+    while ((typeIndex=nextType++)<types.size()) {
+      MergeAreas(progress,
+                 nodeUseMap,
+                 mergeJob[types[typeIndex]->GetIndex()]);
+
+      mergeJob[types[typeIndex]->GetIndex()].areas.clear();
+    }
+  }
+
   bool MergeAreasGenerator::WriteMergeResult(Progress& progress,
                                              const TypeConfig& typeConfig,
                                              FileScanner& scanner,
@@ -629,18 +650,41 @@ namespace osmscout {
 
         progress.SetAction("Merging areas");
 
+        // Areas of different types never get merged, so types are merged in parallel
+        std::vector<TypeInfoRef> typesToMerge;
+
         for (const auto& type : loadedTypes) {
           if (!mergeJob[type->GetIndex()].areas.empty()) {
             progress.Info("Merging areas of type "+type->GetName());
-            MergeAreas(progress,
-                       nodeUseMap,
-                       mergeJob[type->GetIndex()]);
-            progress.Info("Reduced areas of '"+type->GetName()+"' from "+std::to_string(mergeJob[type->GetIndex()].areaCount)+" to "+std::to_string(mergeJob[type->GetIndex()].areaCount-mergeJob[type->GetIndex()].mergedAway.size()));
-
-            mergeJob[type->GetIndex()].areas.clear();
+            typesToMerge.push_back(type);
           }
         }
 
+        // The workers report to the same progress
+        SynchronizedProgress           workerProgress(progress);
+        std::atomic<size_t>            nextType(0);
+        std::vector<std::future<void>> workers;
+        size_t                         workerCount=std::min(typesToMerge.size(),
+                                                            (size_t)std::max((unsigned int)1,std::thread::hardware_concurrency()));
+
+        for (size_t w=0; w<workerCount; w++) {
+          workers.push_back(std::async(std::launch::async,
+                                       &MergeAreasGenerator::MergeAreasOfTypes,this,
+                                       std::ref(workerProgress),
+                                       std::cref(nodeUseMap),
+                                       std::cref(typesToMerge),
+                                       std::ref(nextType),
+                                       std::ref(mergeJob)));
+        }
+
+        for (auto& worker : workers) {
+          worker.get();
+        }
+
+        for (const auto& type : typesToMerge) {
+          progress.Info("Reduced areas of '"+type->GetName()+"' from "+std::to_string(mergeJob[type->GetIndex()].areaCount)+" to "+std::to_string(mergeJob[type->GetIndex()].areaCount-mergeJob[type->GetIndex()].mergedAway.size()));
+        }
+
         // Store back merge result
 
         if (!loadedTypes.Empty()) {
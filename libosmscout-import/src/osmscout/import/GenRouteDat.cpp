@@ -22,6 +22,7 @@
 #include <algorithm>
 #include <future>
 #include <iterator>
+#include <thread>
 
 #include <osmscout/ObjectRef.h>
 
@@ -955,22 +956,24 @@ namespace osmscout {
 
   bool RouteDataGenerator::GetRouteNodePoint(Progress& progress,
                                              const RawRouteNode& node,
-                                             std::unordered_map<FileOffset,WayRef>& waysMap,
-                                             std::unordered_map<FileOffset,AreaRef>& areasMap,
+                                             const FileOffsetWayMap& waysMap,
+                                             const FileOffsetAreaMap& areasMap,
                                              Point& point) const
   {
     for (const auto& ref : node.objects) {
       if (ref.GetType()==refWay) {
-        const WayRef& way=waysMap[ref.GetFileOffset()];
+        const auto wayEntry=waysMap.find(ref.GetFileOffset());
 
-        if (!way) {
+        if (wayEntry==waysMap.end() ||
+            !wayEntry->second) {
           progress.Error("Error while loading way at offset "+
                          std::to_string(ref.GetFileOffset()) +
                          " (Internal error?)");
           continue;
         }
 
-        size_t currentNode;
+        const WayRef& way=wayEntry->second;
+        size_t        currentNode;
 
         if (!way->GetNodeIndexByNodeId(node.id,
                                        currentNode)) {
@@ -982,15 +985,17 @@ namespace osmscout {
         return true;
       }
       else if (ref.GetType()==refArea) {
-        const AreaRef& area=areasMap[ref.GetFileOffset()];
+        const auto areaEntry=areasMap.find(ref.GetFileOffset());
 
-        if (!area) {
+        if (areaEntry==areasMap.end() ||
+            !areaEntry->second) {
           progress.Error("Error while loading area at offset "+
                          std::to_string(ref.GetFileOffset()) +
                          " (Internal error?)");
           continue;
         }
 
+        const AreaRef&    area=areaEntry->second;
         size_t            currentNode;
         const Area::Ring& ring=area->rings.front();
 
@@ -1387,6 +1392,164 @@ namespace osmscout {
     }
   }
 
+  void RouteDataGenerator::CalculateRouteNode(Progress& progress,
+                                              const RawRouteNode& node,
+                                              const FileOffsetWayMap& waysMap,
+                                              const FileOffsetAreaMap& areasMap,
+                                              const RouteNodeIdSet& routeNodeIdSet,
+                                              const ViaTurnRestrictionMap& restrictions,
+                                              VehicleMask vehicles,
+                                              RouteNodeResult& result)
+  {
+    result.valid=false;
+
+    //
+    // Find out if any of the areas/ways at the intersection is routable
+    // for us for the given vehicle (we already only loaded those objects
+    // that are routable at all).
+    // If none of the objects is routable the complete node is not routable and
+    // we can safely drop this node from the routing graph.
+    //
+
+    if (!IsAnyRoutable(progress,
+                       node,
+                       waysMap,
+                       areasMap,
+                       vehicles)) {
+      return;
+    }
+
+    Point point;
+
+    if (!GetRouteNodePoint(progress,
+                           node,
+                           waysMap,
+                           areasMap,
+                           point)) {
+      return;
+    }
+
+    RouteNode& routeNode=result.routeNode;
+
+    // The file offset is assigned, when the route node gets written
+    routeNode.Initialize(0,
+                         point);
+
+    //
+    // Calculate all outgoing paths
+    //
+
+    for (const auto& ref : node.objects) {
+      if (ref.GetType()==refWay) {
+        const auto wayEntry=waysMap.find(ref.GetFileOffset());
+
+        if (wayEntry==waysMap.end() ||
+            !wayEntry->second) {
+          progress.Error("Error while loading way at offset "+
+                         std::to_string(ref.GetFileOffset()) +
+                         " (Internal error?)");
+          continue;
+        }
+
+        const Way& way=*wayEntry->second;
+
+        if (!GetAccess(way).CanRoute(vehicles)) {
+          continue;
+        }
+
+        ObjectVariantData variant;
+
+        variant.type=way.GetType();
+        variant.maxSpeed=GetMaxSpeed(way);
+        variant.grade=GetGrade(way);
+
+        uint16_t objectVariantIndex=(uint16_t)result.variants.size();
+
+        result.variants.push_back(variant);
+
+        if (way.IsCircular()) {
+          // Circular way routing (similar to current area routing, but respecting isOneway())
+          CalculateCircularWayPaths(routeNode,
+                                    way,
+                                    objectVariantIndex,
+                                    routeNodeIdSet);
+        }
+        else {
+          // Normal way routing
+          CalculateWayPaths(routeNode,
+                            way,
+                            objectVariantIndex,
+                            routeNodeIdSet);
+        }
+      }
+      else if (ref.GetType()==refArea) {
+        const auto areaEntry=areasMap.find(ref.GetFileOffset());
+
+        if (areaEntry==areasMap.end() ||
+            !areaEntry->second) {
+          progress.Error("Error while loading area at offset "+
+                         std::to_string(ref.GetFileOffset()) +
+                         " (Internal error?)");
+          continue;
+        }
+
+        const Area& area=*areaEntry->second;
+
+        if (!area.GetType()->CanRoute()) {
+          continue;
+        }
+
+        ObjectVariantData variant;
+
+        variant.type=area.GetType();
+        variant.maxSpeed=0;
+        variant.grade=1;
+
+        uint16_t objectVariantIndex=(uint16_t)result.variants.size();
+
+        result.variants.push_back(variant);
+
+        routeNode.AddObject(ref,
+                            objectVariantIndex);
+
+        CalculateAreaPaths(routeNode,
+                           area,
+                           objectVariantIndex,
+                           routeNodeIdSet);
+      }
+    }
+
+    FillRoutePathExcludes(routeNode,
+                          node,
+                          restrictions);
+
+    result.valid=true;
+  }
+
+  void RouteDataGenerator::CalculateRouteNodes(Progress& progress,
+                                               RawRouteNodeList::const_iterator startNode,
+                                               RawRouteNodeList::const_iterator endNode,
+                                               const FileOffsetWayMap& waysMap,
+                                               const FileOffsetAreaMap& areasMap,
+                                               const RouteNodeIdSet& routeNodeIdSet,
+                                               const ViaTurnRestrictionMap& restrictions,
+                                               VehicleMask vehicles,
+                                               std::vector<RouteNodeResult>::iterator result)
+  {
+    for (auto nodeEntry=startNode; nodeEntry!=endNode; ++nodeEntry) {
+      CalculateRouteNode(progress,
+                         *nodeEntry,
+                         waysMap,
+                         areasMap,
+                         routeNodeIdSet,
+                         restrictions,
+                         vehicles,
+                         *result);
+
+      ++result;
+    }
+  }
+
   bool RouteDataGenerator::WriteObjectVariantData(Progress& progress,
                                                   const std::string& variantFilename,
                                                   const std::map<ObjectVariantData,uint16_t>& routeDataMap)
@@ -1453,7 +1616,8 @@ namespace osmscout {
       size_t     excludeCount=0;
       size_t     simpleNodesCount=0;
 
-      writer.Open(dataFilename);
+      writer.Open(dataFilename,
+                  FileWriter::DEFAULT_WRITE_BEHIND_SIZE);
 
       writer.Write(indexFileOffset);
       writer.Write(writtenRouteNodeCount);
@@ -1506,9 +1670,59 @@ namespace osmscout {
         FileOffsetWayMap waysMap=waysMapFuture.get();
         FileOffsetAreaMap areasMap=areasMapFuture.get();
 
+        progress.Info("Calculating route nodes");
+
+        //
+        // Route nodes only depend on the loaded ways and areas, so they are calculated in parallel.
+        // The block is split into slices of complete route node tiles, one slice per worker.
+        // Each worker stores its results at the position of the raw route node, so the
+        // route nodes are written in the same order as before.
+        //
+
+        std::vector<RouteNodeResult>   results(blockSize);
+        std::vector<std::future<void>> workers;
+        size_t                         workerCount=std::max((unsigned int)1,std::thread::hardware_concurrency());
+        size_t                         sliceSize=std::max((size_t)1,blockSize/workerCount);
+        auto                           startOfSlice=startOfBlock;
+        size_t                         sliceStart=0;
+
+        while (startOfSlice!=endOfBlock) {
+          auto   endOfSlice=startOfSlice;
+          size_t sliceCount=0;
+
+          while (endOfSlice!=endOfBlock &&
+                 (sliceCount<sliceSize ||
+                  endOfSlice->cell==std::prev(endOfSlice)->cell)) {
+            endOfSlice++;
+            sliceCount++;
+          }
+
+          workers.push_back(std::async(std::launch::async,
+                                       &RouteDataGenerator::CalculateRouteNodes,this,
+                                       std::ref(progress),
+                                       startOfSlice,
+                                       endOfSlice,
+                                       std::cref(waysMap),
+                                       std::cref(areasMap),
+                                       std::cref(routeNodeIdSet),
+                                       std::cref(restrictions),
+                                       vehicles,
+                                       results.begin()+sliceStart));
+
+          sliceStart+=sliceCount;
+          startOfSlice=endOfSlice;
+        }
+
+        for (auto& worker : workers) {
+          worker.get();
+        }
+
         progress.Info("Storing route nodes");
 
-        for (auto nodeEntry=startOfBlock; nodeEntry!=endOfBlock; nodeEntry++) {
+        std::vector<uint16_t> objectVariantIndexes;
+        auto                  result=results.begin();
+
+        for (auto nodeEntry=startOfBlock; nodeEntry!=endOfBlock; nodeEntry++, result++) {
           auto& node=*nodeEntry;
 
           if (node.cell!=currentCell) {
@@ -1528,108 +1742,26 @@ namespace osmscout {
           progress.SetProgress(handledRouteNodeCount,
                                (uint32_t)rawRouteNodes.size());
 
-          //
-          // Find out if any of the areas/ways at the intersection is routable
-          // for us for the given vehicle (we already only loaded those objects
-          // that are routable at all).
-          // If none of the objects is routable the complete node is not routable and
-          // we can safely drop this node from the routing graph.
-          //
-
-          if (!IsAnyRoutable(progress,
-                             node,
-                             waysMap,
-                             areasMap,
-                             vehicles)) {
+          if (!result->valid) {
             continue;
           }
 
-          Point point;
+          RouteNode& routeNode=result->routeNode;
 
-          if (!GetRouteNodePoint(progress,
-                                 node,
-                                 waysMap,
-                                 areasMap,
-                                 point)) {
-            continue;
-          }
+          // Object variant indexes are registered in route node order, so they are
+          // independent of the number of workers
+          objectVariantIndexes.clear();
 
-          RouteNode  routeNode;
-
-          routeNode.Initialize(writer.GetPos(),
-                               point);
-
-          //
-          // Calculate all outgoing paths
-          //
-
-          for (const auto& ref : node.objects) {
-            if (ref.GetType()==refWay) {
-              const WayRef& way=waysMap[ref.GetFileOffset()];
-
-              if (!way) {
-                progress.Error("Error while loading way at offset "+
-                               std::to_string(ref.GetFileOffset()) +
-                               " (Internal error?)");
-                continue;
-              }
-
-              if (!GetAccess(*way).CanRoute(vehicles)) {
-                continue;
-              }
-
-              uint16_t objectVariantIndex=RegisterOrUseObjectVariantData(routeDataMap,
-                                                                         way->GetType(),
-                                                                         GetMaxSpeed(*way),
-                                                                         GetGrade(*way));
-
-              if (way->IsCircular()) {
-                // Circular way routing (similar to current area routing, but respecting isOneway())
-                CalculateCircularWayPaths(routeNode,
-                                          *way,
-                                          objectVariantIndex,
-                                          routeNodeIdSet);
-              }
-              else {
-                // Normal way routing
-                CalculateWayPaths(routeNode,
-                                  *way,
-                                  objectVariantIndex,
-                                  routeNodeIdSet);
-              }
-            }
-            else if (ref.GetType()==refArea) {
-              const AreaRef& area=areasMap[ref.GetFileOffset()];
-
-              if (!area) {
-                progress.Error("Error while loading area at offset "+
-                               std::to_string(ref.GetFileOffset()) +
-                               " (Internal error?)");
-                continue;
-              }
-
-              if (!area->GetType()->CanRoute()) {
-                continue;
-              }
-
-              uint16_t objectVariantIndex=RegisterOrUseObjectVariantData(routeDataMap,
-                                                                         area->GetType(),
-                                                                         0,
-                                                                         1);
-
-              routeNode.AddObject(ref,
-                                  objectVariantIndex);
-
-              CalculateAreaPaths(routeNode,
-                                 *area,
-                                 objectVariantIndex,
-                                 routeNodeIdSet);
-            }
+          for (const auto& variant : result->variants) {
+            objectVariantIndexes.push_back(RegisterOrUseObjectVariantData(routeDataMap,
+                                                                          variant.type,
+                                                                          variant.maxSpeed,
+                                                                          variant.grade));
           }
 
-          FillRoutePathExcludes(routeNode,
-                                node,
-                                restrictions);
+          for (auto& object : routeNode.objects) {
+            object.objectVariantIndex=objectVariantIndexes[object.objectVariantIndex];
+          }
 
           if (routeNode.paths.size()==1) {
             simpleNodesCount++;
@@ -39,6 +39,8 @@
 
 #include <osmscout/import/GenTextIndex.h>
 
+#include <future>
+
 #include <marisa.h>
 
 namespace osmscout
@@ -75,20 +77,33 @@ namespace osmscout
     }
     progress.Info("Using "+std::to_string(offsetSizeBytes)+"-byte offsets");
 
-    // add node text data
-    if(!this->AddNodeTextToKeysets(parameter,
-                                   progress,
-                                   *typeConfig)) {
-      return false;
-    }
-    if(!this->AddWayTextToKeysets(parameter,
-                                  progress,
-                                  *typeConfig)) {
-      return false;
-    }
-    if(!this->AddAreaTextToKeysets(parameter,
-                                   progress,
-                                   *typeConfig)) {
+    // Scanner and trie tasks report to the same progress
+    SynchronizedProgress taskProgress(progress);
+
+    // The data files are independent, so they are scanned in parallel
+    auto nodeTextFuture=std::async(std::launch::async,
+                                   &TextIndexGenerator::AddNodeTextToKeysets,this,
+                                   std::cref(parameter),
+                                   std::ref(taskProgress),
+                                   std::cref(*typeConfig));
+    auto wayTextFuture=std::async(std::launch::async,
+                                  &TextIndexGenerator::AddWayTextToKeysets,this,
+                                  std::cref(parameter),
+                                  std::ref(taskProgress),
+                                  std::cref(*typeConfig));
+    auto areaTextFuture=std::async(std::launch::async,
+                                   &TextIndexGenerator::AddAreaTextToKeysets,this,
+                                   std::cref(parameter),
+                                   std::ref(taskProgress),
+                                   std::cref(*typeConfig));
+
+    bool nodeTextAdded=nodeTextFuture.get();
+    bool wayTextAdded=wayTextFuture.get();
+    bool areaTextAdded=areaTextFuture.get();
+
+    if (!nodeTextAdded ||
+        !wayTextAdded ||
+        !areaTextAdded) {
       return false;
     }
 
@@ -122,37 +137,62 @@ namespace osmscout
     trieFiles.push_back(AppendFileToDir(parameter.GetDestinationDirectory(),
                                         TextSearchIndex::TEXT_OTHER_DAT));
 
+    // The tries are independent, so they are built in parallel
+    std::vector<std::future<bool>> trieFutures;
+
     for(size_t i=0; i < keysets.size(); i++) {
       // add sz_offset to the keyset
       keysets[i]->push_back(offsetSizeBytesStr.c_str(),
                             offsetSizeBytesStr.length());
 
-      marisa::Trie trie;
-      try {
-        trie.build(*(keysets[i]),
-                   MARISA_DEFAULT_NUM_TRIES |
-                   MARISA_BINARY_TAIL |
-                   MARISA_LABEL_ORDER |
-                   MARISA_DEFAULT_CACHE);
-      }
-      catch (const marisa::Exception &ex) {
-        std::string errorMsg="Error building:" +trieFiles[i];
-        errorMsg.append(ex.what());
-        progress.Error(errorMsg);
-        return false;
-      }
+      trieFutures.push_back(std::async(std::launch::async,
+                                       &TextIndexGenerator::BuildTrie,this,
+                                       std::ref(taskProgress),
+                                       std::ref(*keysets[i]),
+                                       std::cref(trieFiles[i])));
+    }
 
-      try {
-        trie.save(trieFiles[i].c_str());
-      }
-      catch (const marisa::Exception &ex) {
-        std::string errorMsg="Error saving:" +trieFiles[i];
-        errorMsg.append(ex.what());
-        progress.Error(errorMsg);
-        return false;
+    bool success=true;
+
+    for (auto& trieFuture : trieFutures) {
+      if (!trieFuture.get()) {
+        success=false;
       }
     }
 
+    return success;
+  }
+
+  bool TextIndexGenerator::BuildTrie(Progress& progress,
+                                     marisa::Keyset& keyset,
+                                     const std::string& trieFile) const
+  {
+    marisa::Trie trie;
+
+    try {
+      trie.build(keyset,
+                 MARISA_DEFAULT_NUM_TRIES |
+                 MARISA_BINARY_TAIL |
+                 MARISA_LABEL_ORDER |
+                 MARISA_DEFAULT_CACHE);
+    }
+    catch (const marisa::Exception &ex) {
+      std::string errorMsg="Error building:" +trieFile;
+      errorMsg.append(ex.what());
+      progress.Error(errorMsg);
+      return false;
+    }
+
+    try {
+      trie.save(trieFile.c_str());
+    }
+    catch (const marisa::Exception &ex) {
+      std::string errorMsg="Error saving:" +trieFile;
+      errorMsg.append(ex.what());
+      progress.Error(errorMsg);
+      return false;
+    }
+
     return true;
   }
 
@@ -281,8 +321,8 @@ namespace osmscout
                            refNode,
                            keyString))
             {
-              keyset->push_back(keyString.c_str(),
-                                keyString.length());
+              AddKey(*keyset,
+                     keyString);
             }
           }
           if(nameAltValue!=nullptr) {
@@ -292,8 +332,8 @@ namespace osmscout
                            refNode,
                            keyString))
             {
-              keyset->push_back(keyString.c_str(),
-                                keyString.length());
+              AddKey(*keyset,
+                     keyString);
             }
           }
         }
@@ -382,8 +422,8 @@ namespace osmscout
                          refWay,
                          keyString))
           {
-            keyset->push_back(keyString.c_str(),
-                              keyString.length());
+            AddKey(*keyset,
+                   keyString);
           }
         }
 
@@ -394,8 +434,8 @@ namespace osmscout
                          refWay,
                          keyString))
           {
-            keyset->push_back(keyString.c_str(),
-                              keyString.length());
+            AddKey(*keyset,
+                   keyString);
           }
         }
 
@@ -406,8 +446,8 @@ namespace osmscout
                          refWay,
                          keyString))
           {
-            keyset->push_back(keyString.c_str(),
-                              keyString.length());
+            AddKey(*keyset,
+                   keyString);
           }
         }
       }
@@ -493,8 +533,8 @@ namespace osmscout
                            refArea,
                            keyString))
             {
-              keyset->push_back(keyString.c_str(),
-                                keyString.length());
+              AddKey(*keyset,
+                     keyString);
             }
           }
           if (nameAltValue!=nullptr) {
@@ -504,8 +544,8 @@ namespace osmscout
                            refArea,
                            keyString))
             {
-              keyset->push_back(keyString.c_str(),
-                                keyString.length());
+              AddKey(*keyset,
+                     keyString);
             }
           }
         }
@@ -521,6 +561,15 @@ namespace osmscout
     return true;
   }
 
+  void TextIndexGenerator::AddKey(marisa::Keyset& keyset,
+                                  const std::string& keyString)
+  {
+    std::lock_guard<std::mutex> lock(keysetMutex);
+
+    keyset.push_back(keyString.c_str(),
+                     keyString.length());
+  }
+
   bool TextIndexGenerator::BuildKeyStr(const std::string& text,
                                        FileOffset offset,
                                        const RefType& reftype,
@@ -67,6 +67,7 @@
 
 #include <osmscout/import/GenOptimizeAreasLowZoom.h>
 #include <osmscout/import/GenOptimizeWaysLowZoom.h>
+#include <osmscout/import/GenLODDat.h>
 
 // Routing
 #include <osmscout/import/GenRouteDat.h>
@@ -84,7 +85,7 @@ namespace osmscout {
 
   static const size_t defaultStartStep=1;
 #if defined(OSMSCOUT_IMPORT_HAVE_LIB_MARISA)
-  static const size_t defaultEndStep=25;
+  static const size_t defaultEndStep=26;
 #else
   static const size_t defaultEndStep=24;
 #endif
@@ -114,6 +115,7 @@ namespace osmscout {
      processingQueueSize(std::max((unsigned int)1,std::thread::hardware_concurrency())),
      numericIndexPageSize(1024),
      rawCoordBlockSize(60000000),
+     allDataMemoryMaped(false),
      rawNodeDataMemoryMaped(false),
      rawWayIndexMemoryMaped(true),
      rawWayDataMemoryMaped(false),
@@ -145,6 +147,9 @@ namespace osmscout {
      optimizationCellSizeAverage(64),
      optimizationCellSizeMax(255),
      optimizationWayMethod(TransPolygon::quality),
+     lodData(false),
+     lodMinMag(10),
+     lodMaxMag(14),
      routeNodeBlockSize(500000),
      routeNodeTileMag(13),
      assumeLand(AssumeLandStrategy::automatic),
@@ -241,14 +246,19 @@ namespace osmscout {
     return rawCoordBlockSize;
   }
 
+  bool ImportParameter::GetAllDataMemoryMaped() const
+  {
+    return allDataMemoryMaped;
+  }
+
   bool ImportParameter::GetRawNodeDataMemoryMaped() const
   {
-    return rawNodeDataMemoryMaped;
+    return allDataMemoryMaped || rawNodeDataMemoryMaped;
   }
 
   bool ImportParameter::GetRawWayIndexMemoryMaped() const
   {
-    return rawWayIndexMemoryMaped;
+    return allDataMemoryMaped || rawWayIndexMemoryMaped;
   }
 
   size_t ImportParameter::GetRawWayIndexCacheSize() const
@@ -258,7 +268,7 @@ namespace osmscout {
 
   bool ImportParameter::GetRawWayDataMemoryMaped() const
   {
-    return rawWayDataMemoryMaped;
+    return allDataMemoryMaped || rawWayDataMemoryMaped;
   }
 
   size_t ImportParameter::GetRawWayBlockSize() const
@@ -268,7 +278,7 @@ namespace osmscout {
 
   bool ImportParameter::GetCoordDataMemoryMaped() const
   {
-    return coordDataMemoryMaped;
+    return allDataMemoryMaped || coordDataMemoryMaped;
   }
 
   size_t ImportParameter::GetCoordIndexCacheSize() const
@@ -298,7 +308,7 @@ namespace osmscout {
 
   bool ImportParameter::GetAreaDataMemoryMaped() const
   {
-    return areaDataMemoryMaped;
+    return allDataMemoryMaped || areaDataMemoryMaped;
   }
 
   size_t ImportParameter::GetWayDataCacheSize() const
@@ -308,7 +318,7 @@ namespace osmscout {
 
   bool ImportParameter::GetWayDataMemoryMaped() const
   {
-    return wayDataMemoryMaped;
+    return allDataMemoryMaped || wayDataMemoryMaped;
   }
 
   MagnificationLevel ImportParameter::GetAreaNodeGridMag() const
@@ -396,6 +406,21 @@ namespace osmscout {
     return optimizationWayMethod;
   }
 
+  bool ImportParameter::GetLODData() const
+  {
+    return lodData;
+  }
+
+  MagnificationLevel ImportParameter::GetLODMinMag() const
+  {
+    return lodMinMag;
+  }
+
+  MagnificationLevel ImportParameter::GetLODMaxMag() const
+  {
+    return lodMaxMag;
+  }
+
   size_t ImportParameter::GetRouteNodeBlockSize() const
   {
     return routeNodeBlockSize;
@@ -518,6 +543,17 @@ namespace osmscout {
     this->rawCoordBlockSize=blockSize;
   }
 
+  /**
+   * Memory map all intermediate and data files read during import, independent of the
+   * individual settings. Access advice (sequential or random) is still given per file
+   * depending on the FileScanner mode, so this is a good choice if the files fit into
+   * the page cache.
+   */
+  void ImportParameter::SetAllDataMemoryMaped(bool memoryMaped)
+  {
+    this->allDataMemoryMaped=memoryMaped;
+  }
+
   void ImportParameter::SetRawNodeDataMemoryMaped(bool memoryMaped)
   {
     this->rawNodeDataMemoryMaped=memoryMaped;
@@ -680,6 +716,21 @@ namespace osmscout {
     this->optimizationWayMethod=optimizationWayMethod;
   }
 
+  void ImportParameter::SetLODData(bool lodData)
+  {
+    this->lodData=lodData;
+  }
+
+  void ImportParameter::SetLODMinMag(MagnificationLevel lodMinMag)
+  {
+    this->lodMinMag=lodMinMag;
+  }
+
+  void ImportParameter::SetLODMaxMag(MagnificationLevel lodMaxMag)
+  {
+    this->lodMaxMag=lodMaxMag;
+  }
+
   void ImportParameter::SetRouteNodeBlockSize(size_t blockSize)
   {
     this->routeNodeBlockSize=blockSize;
@@ -918,17 +969,20 @@ namespace osmscout {
     modules.push_back(std::make_shared<OptimizeWaysLowZoomGenerator>());
 
     /* 22 */
-    modules.push_back(std::make_shared<LocationIndexGenerator>());
+    modules.push_back(std::make_shared<LODDataGenerator>());
 
     /* 23 */
-    modules.push_back(std::make_shared<RouteDataGenerator>());
+    modules.push_back(std::make_shared<LocationIndexGenerator>());
 
     /* 24 */
+    modules.push_back(std::make_shared<RouteDataGenerator>());
+
+    /* 25 */
     modules.push_back(std::make_shared<IntersectionIndexGenerator>());
 
 
 #if defined(OSMSCOUT_IMPORT_HAVE_LIB_MARISA)
-    /* 25 */
+    /* 26 */
     modules.push_back(std::make_shared<TextIndexGenerator>());
 #endif
   }
@@ -23,6 +23,7 @@
 #include <osmscout/import/ImportFeatures.h>
 
 #include <cstdio>
+#include <limits>
 
 #if defined(HAVE_FCNTL_H)
   #include <fcntl.h>
@@ -48,6 +49,9 @@
 
 namespace osmscout {
 
+  //! Marker for strings of the block string table not yet resolved to a tag id
+  static const TagId tagUnresolved=std::numeric_limits<TagId>::max();
+
   bool PreprocessPBF::GetPos(FILE* file,
                              FileOffset& pos) const
   {
@@ -287,6 +291,23 @@ namespace osmscout {
     return true;
   }
 
+  /**
+   * Return the tag id for the given string of the block string table. Keys repeat
+   * a lot within a block, so each string is resolved just once per block.
+   */
+  TagId PreprocessPBF::GetTagId(const TypeConfig& typeConfig,
+                                const OSMPBF::PrimitiveBlock& block,
+                                uint32_t stringIndex)
+  {
+    TagId& id=stringTagIds[stringIndex];
+
+    if (id==tagUnresolved) {
+      id=typeConfig.GetTagId(block.stringtable().s(stringIndex));
+    }
+
+    return id;
+  }
+
   void PreprocessPBF::ReadNodes(const TypeConfig& typeConfig,
                                 const OSMPBF::PrimitiveBlock& block,
                                 const OSMPBF::PrimitiveGroup& group,
@@ -306,7 +327,7 @@ namespace osmscout {
       tagMap.clear();
 
       for (int t=0; t<inputNode.keys_size(); t++) {
-        TagId id=typeConfig.GetTagId(block.stringtable().s(inputNode.keys(t)));
+        TagId id=GetTagId(typeConfig,block,inputNode.keys(t));
 
         if (id!=tagIgnore) {
           nodeData.tags[id]=block.stringtable().s(inputNode.vals(t));
@@ -351,7 +372,7 @@ namespace osmscout {
           break;
         }
 
-        TagId id=typeConfig.GetTagId(block.stringtable().s(dense.keys_vals(t)));
+        TagId id=GetTagId(typeConfig,block,dense.keys_vals(t));
 
         if (id!=tagIgnore) {
           nodeData.tags[id]=block.stringtable().s(dense.keys_vals(t+1));
@@ -379,7 +400,7 @@ namespace osmscout {
       wayData.id=inputWay.id();
 
       for (int t=0; t<inputWay.keys_size(); t++) {
-        TagId id=typeConfig.GetTagId(block.stringtable().s(inputWay.keys(t)));
+        TagId id=GetTagId(typeConfig,block,inputWay.keys(t));
 
         if (id!=tagIgnore) {
           wayData.tags[id]=block.stringtable().s(inputWay.vals(t));
@@ -416,7 +437,7 @@ namespace osmscout {
       members.clear();
 
       for (int t=0; t<inputRelation.keys_size(); t++) {
-        TagId id=typeConfig.GetTagId(block.stringtable().s(inputRelation.keys(t)));
+        TagId id=GetTagId(typeConfig,block,inputRelation.keys(t));
 
         if (id!=tagIgnore) {
           relationData.tags[id]=block.stringtable().s(inputRelation.vals(t));
@@ -471,6 +492,9 @@ namespace osmscout {
   {
     PreprocessorCallback::RawBlockDataRef blockData(new PreprocessorCallback::RawBlockData());
 
+    stringTagIds.assign((size_t)block->stringtable().s_size(),
+                        tagUnresolved);
+
     for (int currentGroup=0;
          currentGroup<block->primitivegroup_size();
          currentGroup++) {
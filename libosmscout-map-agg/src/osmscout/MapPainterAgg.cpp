@@ -426,6 +426,9 @@ namespace osmscout {
   {
     labelLayouter.Layout(projection, parameter);
 
+    AddLabelStatistics(labelLayouter.GetPlacedCount(),
+                       labelLayouter.GetRejectedCount());
+
     labelLayouter.DrawLabels(projection,
                              parameter,
                              this);
@@ -1126,6 +1126,9 @@ namespace osmscout {
   {
     labelLayouter.Layout(projection, parameter);
 
+    AddLabelStatistics(labelLayouter.GetPlacedCount(),
+                       labelLayouter.GetRejectedCount());
+
     labelLayouter.DrawLabels(projection,
                              parameter,
                              this);
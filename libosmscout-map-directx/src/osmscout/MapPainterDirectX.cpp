@@ -677,6 +677,9 @@ namespace osmscout
   {
     m_LabelLayouter.Layout(projection, parameter);
 
+    AddLabelStatistics(m_LabelLayouter.GetPlacedCount(),
+                       m_LabelLayouter.GetRejectedCount());
+
     m_LabelLayouter.DrawLabels(projection,
                                parameter,
                                this);
@@ -539,6 +539,8 @@ namespace osmscout {
                             const MapParameter& parameter,
                             const MapData& data) {
         labelLayouter.Layout(projection, parameter);
+        AddLabelStatistics(labelLayouter.GetPlacedCount(),
+                           labelLayouter.GetRejectedCount());
         labelLayouter.DrawLabels(projection,
                                  parameter,
                                  this);
@@ -1018,6 +1018,9 @@ namespace osmscout {
 
     labelLayouter.Layout(projection, parameter);
 
+    AddLabelStatistics(labelLayouter.GetPlacedCount(),
+                       labelLayouter.GetRejectedCount());
+
     labelLayouter.DrawLabels(projection,
                              parameter,
                              this);
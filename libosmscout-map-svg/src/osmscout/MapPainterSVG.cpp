@@ -771,6 +771,9 @@ namespace osmscout {
 
     labelLayouter.Layout(projection, parameter);
 
+    AddLabelStatistics(labelLayouter.GetPlacedCount(),
+                       labelLayouter.GetRejectedCount());
+
     labelLayouter.DrawLabels(projection,
                              parameter,
                              this);
@@ -0,0 +1,229 @@
+#ifndef OSMSCOUT_INDEXQUERYCACHE_H
+#define OSMSCOUT_INDEXQUERYCACHE_H
+
+/*
+  This source is part of the libosmscout library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <iterator>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <osmscout/TypeInfoSet.h>
+
+#include <osmscout/util/TileId.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Service
+   *
+   * Least recently used cache of the results of area index queries for map tiles.
+   * An entry is identified by the tile, an additional query specific level
+   * (for example the maximum area level) and the requested types. It holds
+   * the returned file offsets (or data block spans) and the loaded types.
+   *
+   * The cache remembers the index instance its entries belong to. If it is used
+   * with another index instance, for example because the database was closed
+   * and opened again, all entries are dropped.
+   *
+   * The cache is thread safe.
+   */
+  template <class V>
+  class IndexQueryCache
+  {
+  private:
+    struct Entry
+    {
+      TileKey        key;
+      uint32_t       level;
+      TypeInfoSet    types;
+      std::vector<V> values;
+      TypeInfoSet    loadedTypes;
+
+      Entry(const TileKey& key,
+            uint32_t level,
+            const TypeInfoSet& types,
+            const std::vector<V>& values,
+            const TypeInfoSet& loadedTypes)
+      : key(key),
+        level(level),
+        types(types),
+        values(values),
+        loadedTypes(loadedTypes)
+      {
+        // no code
+      }
+    };
+
+    typedef std::list<Entry>                                    EntryList;
+    typedef std::multimap<TileKey,typename EntryList::iterator> EntryMap;
+
+  private:
+    mutable std::mutex          mutex;
+    size_t                      maxSize; //!< Maximum number of entries
+    std::weak_ptr<const void>   index;   //!< The index instance the entries belong to
+    EntryList                   entries; //!< Entries, most recently used first
+    EntryMap                    map;     //!< Entries by tile
+
+  private:
+    typename EntryMap::iterator Find(const TileKey& key,
+                                     uint32_t level,
+                                     const TypeInfoSet& types)
+    {
+      auto range=map.equal_range(key);
+
+      for (auto iter=range.first; iter!=range.second; ++iter) {
+        if (iter->second->level==level &&
+            iter->second->types==types) {
+          return iter;
+        }
+      }
+
+      return map.end();
+    }
+
+    void CheckIndex(const std::shared_ptr<const void>& currentIndex)
+    {
+      if (index.lock()!=currentIndex) {
+        entries.clear();
+        map.clear();
+        index=currentIndex;
+      }
+    }
+
+    void StripCache()
+    {
+      while (entries.size()>maxSize) {
+        auto range=map.equal_range(entries.back().key);
+
+        for (auto iter=range.first; iter!=range.second; ++iter) {
+          if (iter->second==std::prev(entries.end())) {
+            map.erase(iter);
+            break;
+          }
+        }
+
+        entries.pop_back();
+      }
+    }
+
+  public:
+    explicit IndexQueryCache(size_t maxSize)
+    : maxSize(maxSize)
+    {
+      // no code
+    }
+
+    /**
+     * Returns the cached result of a query of the given index for the given tile, level
+     * and types. Returns false, if the result is not cached.
+     */
+    bool Get(const std::shared_ptr<const void>& currentIndex,
+             const TileKey& key,
+             uint32_t level,
+             const TypeInfoSet& types,
+             std::vector<V>& values,
+             TypeInfoSet& loadedTypes)
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+
+      CheckIndex(currentIndex);
+
+      auto iter=Find(key,level,types);
+
+      if (iter==map.end()) {
+        return false;
+      }
+
+      // Move the entry to the front of the list
+      entries.splice(entries.begin(),entries,iter->second);
+
+      values=iter->second->values;
+      loadedTypes=iter->second->loadedTypes;
+
+      return true;
+    }
+
+    /**
+     * Stores the result of a query of the given index for the given tile, level and types
+     */
+    void Set(const std::shared_ptr<const void>& currentIndex,
+             const TileKey& key,
+             uint32_t level,
+             const TypeInfoSet& types,
+             const std::vector<V>& values,
+             const TypeInfoSet& loadedTypes)
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+
+      if (maxSize==0) {
+        return;
+      }
+
+      CheckIndex(currentIndex);
+
+      auto iter=Find(key,level,types);
+
+      if (iter!=map.end()) {
+        entries.erase(iter->second);
+        map.erase(iter);
+      }
+
+      entries.emplace_front(key,level,types,values,loadedTypes);
+      map.insert(std::make_pair(key,entries.begin()));
+
+      StripCache();
+    }
+
+    void SetMaxSize(size_t maxSize)
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+
+      this->maxSize=maxSize;
+
+      StripCache();
+    }
+
+    size_t GetMaxSize() const
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+
+      return maxSize;
+    }
+
+    size_t GetSize() const
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+
+      return entries.size();
+    }
+
+    void Flush()
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+
+      entries.clear();
+      map.clear();
+    }
+  };
+}
+
+#endif
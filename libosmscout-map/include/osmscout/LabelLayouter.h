@@ -292,7 +292,9 @@ namespace osmscout {
         textLayouter(textLayouter),
         visibleViewport{0,0,0,0},
         layoutViewport{0,0,0,0},
-        layoutOverlap{0}
+        layoutOverlap{0},
+        placedCount{0},
+        rejectedCount{0}
     {};
 
     void SetViewport(DoubleRectangle v)
@@ -366,6 +368,9 @@ namespace osmscout {
       std::swap(allSortedLabels, labelInstances);
       std::swap(allSortedContourLabels, contourLabelInstances);
 
+      placedCount=0;
+      rejectedCount=0;
+
       // sort labels by priority and position (to be deterministic)
       std::stable_sort(allSortedLabels.begin(),
                        allSortedLabels.end(),
@@ -462,6 +467,10 @@ namespace osmscout {
             if (!collision) {
               visibleElements.push_back(element);
               canvases[eli]=canvas;
+              placedCount++;
+            }
+            else {
+              rejectedCount++;
             }
 #ifdef DEBUG_LABEL_LAYOUTER
             std::cout << " -> " << (collision ? "skipped" : "added") << std::endl;
@@ -514,6 +523,10 @@ namespace osmscout {
               MarkLabelPlace(labelCanvas, masks[gi], layoutViewport.height);
             }
             contourLabelInstances.push_back(*currentContourLabel);
+            placedCount++;
+          }
+          else {
+            rejectedCount++;
           }
 #ifdef DEBUG_LABEL_LAYOUTER
           std::cout << " -> " << (collision ? "skipped" : "added") << std::endl;
@@ -801,6 +814,23 @@ namespace osmscout {
       return contourLabelInstances;
     }
 
+    /**
+     * Number of label elements (labels, icons, symbols, contour labels)
+     * placed by the last Layout call
+     */
+    size_t GetPlacedCount() const
+    {
+      return placedCount;
+    }
+
+    /**
+     * Number of label elements dropped by the last Layout call because of collisions
+     */
+    size_t GetRejectedCount() const
+    {
+      return rejectedCount;
+    }
+
   private:
     TextLayouter *textLayouter;
     std::vector<ContourLabelType> contourLabelInstances;
@@ -808,6 +838,8 @@ namespace osmscout {
     DoubleRectangle visibleViewport;
     DoubleRectangle layoutViewport;
     double layoutOverlap; // overlap ratio used for label layouting
+    size_t placedCount;   // placed label elements during last layout
+    size_t rejectedCount; // rejected label elements during last layout
   };
 
 }
@@ -20,6 +20,7 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <array>
 #include <list>
 #include <string>
 
@@ -74,6 +75,43 @@ namespace osmscout {
     LastStep              = 16
   };
 
+  /**
+   * \ingroup Renderer
+   *
+   * Returns a human readable name of the given render step.
+   */
+  extern OSMSCOUT_MAP_API const char* GetRenderStepName(RenderSteps step);
+
+  /**
+   * \ingroup Renderer
+   *
+   * Statistics collected by MapPainter while rendering. The statistics are reset
+   * at the start of each MapPainter::Draw call, so they always describe the steps
+   * executed by the last call. They can be fetched from the painter via
+   * MapPainter::GetRenderStatistics() or are passed to the callback registered via
+   * MapParameter::SetRenderStatisticsCallback() after the last requested step
+   * got executed (the callback is not called if rendering was aborted).
+   *
+   * Instances can be summed up to aggregate statistics over multiple render actions.
+   */
+  struct OSMSCOUT_MAP_API RenderStatistics
+  {
+    std::array<double,RenderSteps::LastStep+1> stepTime; //!< Wall time of each render step in milliseconds
+    size_t styleLookups;                                   //!< Number of style sheet lookups for objects
+    size_t transformedPoints;                              //!< Number of geo coordinates transformed to screen coordinates
+    size_t culledObjects;                                  //!< Number of ways and areas skipped, because they are not visible
+    size_t labelsPlaced;                                   //!< Number of labels, icons and symbols placed by the label layouter
+    size_t labelsRejected;                                 //!< Number of labels, icons and symbols dropped because of collisions
+
+    RenderStatistics();
+
+    void Reset();
+
+    double GetTotalTime() const;
+
+    RenderStatistics& operator+=(const RenderStatistics& other);
+  };
+
   /**
    * Abstract base class of all renders (though you can always write
    * your own renderer without inheriting from this class) It
@@ -215,6 +253,7 @@ namespace osmscout {
   private:
     std::vector<StepMethod>      stepMethods;
     double                       errorTolerancePixel;
+    RenderStatistics             renderStatistics;  //!< Statistics of the current/last render action
 
     std::list<AreaData>          areaData;
     std::list<WayData>           wayData;
@@ -478,6 +517,17 @@ namespace osmscout {
       return areaData;
     }
 
+    /**
+     * Should be called by the concrete backend after label layouting
+     * to add the result to the render statistics.
+     */
+    inline void AddLabelStatistics(size_t placed,
+                                   size_t rejected)
+    {
+      renderStatistics.labelsPlaced+=placed;
+      renderStatistics.labelsRejected+=rejected;
+    }
+
     /**
       Low level drawing routines that have to be implemented by
       the concrete drawing engine.
@@ -629,6 +679,14 @@ namespace osmscout {
     bool Draw(const Projection& projection,
               const MapParameter& parameter,
               const MapData& data);
+
+    /**
+     * Return the statistics of the last render action
+     */
+    inline const RenderStatistics& GetRenderStatistics() const
+    {
+      return renderStatistics;
+    }
   };
 
   /**
@@ -20,6 +20,7 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <functional>
 #include <list>
 #include <string>
 
@@ -32,6 +33,16 @@
 
 namespace osmscout {
 
+  struct RenderStatistics;
+
+  /**
+   * \ingroup Renderer
+   *
+   * Callback that gets called by MapPainter after the last render step
+   * with the statistics collected during rendering.
+   */
+  typedef std::function<void(const RenderStatistics&)> RenderStatisticsCallback;
+
   /**
    * \ingroup Renderer
    *
@@ -114,6 +125,8 @@ namespace osmscout {
 
     BreakerRef                          breaker;                   //!< Breaker to abort processing on external request
 
+    RenderStatisticsCallback            renderStatisticsCallback;  //!< Optional receiver of render statistics
+
   public:
     MapParameter();
 
@@ -178,6 +191,8 @@ namespace osmscout {
 
     void SetBreaker(const BreakerRef& breaker);
 
+    void SetRenderStatisticsCallback(const RenderStatisticsCallback& callback);
+
 
     inline std::string GetFontName() const
     {
@@ -369,6 +384,11 @@ namespace osmscout {
       return locale;
     }
 
+    inline const RenderStatisticsCallback& GetRenderStatisticsCallback() const
+    {
+      return renderStatisticsCallback;
+    }
+
     bool IsAborted() const
     {
       if (breaker) {
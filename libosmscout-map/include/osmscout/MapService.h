@@ -39,6 +39,7 @@
 #include <osmscout/util/WorkQueue.h>
 
 #include <osmscout/DataTileCache.h>
+#include <osmscout/IndexQueryCache.h>
 
 namespace osmscout {
 
@@ -54,6 +55,7 @@ namespace osmscout {
   private:
     unsigned long maxAreaLevel;
     bool          useLowZoomOptimization;
+    bool          useLODData;
     BreakerRef    breaker;
     bool          useMultithreading;
 
@@ -64,6 +66,8 @@ namespace osmscout {
 
     void SetUseLowZoomOptimization(bool useLowZoomOptimization);
 
+    void SetUseLODData(bool useLODData);
+
     void SetUseMultithreading(bool useMultithreading);
 
     void SetBreaker(const BreakerRef& breaker);
@@ -72,8 +76,15 @@ namespace osmscout {
 
     bool GetUseLowZoomOptimization() const;
 
+    bool GetUseLODData() const;
+
     bool GetUseMultithreading() const;
 
+    inline BreakerRef GetBreaker() const
+    {
+      return breaker;
+    }
+
     bool IsAborted() const;
   };
 
@@ -109,11 +120,18 @@ namespace osmscout {
     typedef std::function<void(const TileRef&)> TileStateCallback;
 
   private:
+    static const size_t          indexQueryCacheFactor=4; //!< Size of the index query caches relative to the data cache
+
     mutable std::mutex           stateMutex;           //!< Mutex to protect internal state
 
     DatabaseRef                  database;             //!< The reference to the database
     mutable DataTileCache        cache;                //!< Data cache
 
+    // Results of index queries by tile, they outlive the tiles in the data cache
+    mutable IndexQueryCache<FileOffset>    nodeQueryCache;
+    mutable IndexQueryCache<FileOffset>    wayQueryCache;
+    mutable IndexQueryCache<DataBlockSpan> areaQueryCache;
+
     mutable WorkQueue<bool>      nodeWorkerQueue;
     std::thread                  nodeWorkerThread;
 
@@ -168,6 +186,7 @@ namespace osmscout {
 
     bool GetWays(const AreaSearchParameter& parameter,
                  const TypeInfoSet& wayTypes,
+                 const Magnification& magnification,
                  const GeoBox& boundingBox,
                  bool prefill,
                  const TileRef& tile) const;
@@ -207,10 +226,16 @@ namespace osmscout {
 
     std::future<bool> PushWayTask(const AreaSearchParameter& parameter,
                                   const TypeInfoSet& wayTypes,
+                                  const Magnification& magnification,
                                   const GeoBox& boundingBox,
                                   bool prefill,
                                   const TileRef& tile) const;
 
+    void PrefillDataFromCache(const AreaSearchParameter& parameter,
+                              const Magnification& magnification,
+                              const TypeDefinition& typeDefinition,
+                              Tile& tile) const;
+
     void NotifyTileStateCallbacks(const TileRef& tile) const;
 
     bool LoadMissingTileDataStyleSheet(const AreaSearchParameter& parameter,
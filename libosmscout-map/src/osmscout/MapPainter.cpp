@@ -145,6 +145,89 @@ namespace osmscout {
     return a.position<b.position;
   }
 
+  const char* GetRenderStepName(RenderSteps step)
+  {
+    switch (step) {
+    case RenderSteps::Initialize:
+      return "Initialize";
+    case RenderSteps::DumpStatistics:
+      return "DumpStatistics";
+    case RenderSteps::PreprocessData:
+      return "PreprocessData";
+    case RenderSteps::Prerender:
+      return "Prerender";
+    case RenderSteps::DrawBaseMapTiles:
+      return "DrawBaseMapTiles";
+    case RenderSteps::DrawGroundTiles:
+      return "DrawGroundTiles";
+    case RenderSteps::DrawOSMTileGrids:
+      return "DrawOSMTileGrids";
+    case RenderSteps::DrawAreas:
+      return "DrawAreas";
+    case RenderSteps::DrawWays:
+      return "DrawWays";
+    case RenderSteps::DrawWayDecorations:
+      return "DrawWayDecorations";
+    case RenderSteps::DrawWayContourLabels:
+      return "DrawWayContourLabels";
+    case RenderSteps::PrepareAreaLabels:
+      return "PrepareAreaLabels";
+    case RenderSteps::DrawAreaBorderLabels:
+      return "DrawAreaBorderLabels";
+    case RenderSteps::DrawAreaBorderSymbols:
+      return "DrawAreaBorderSymbols";
+    case RenderSteps::PrepareNodeLabels:
+      return "PrepareNodeLabels";
+    case RenderSteps::DrawLabels:
+      return "DrawLabels";
+    case RenderSteps::Postrender:
+      return "Postrender";
+    }
+
+    return "";
+  }
+
+  RenderStatistics::RenderStatistics()
+  {
+    Reset();
+  }
+
+  void RenderStatistics::Reset()
+  {
+    stepTime.fill(0.0);
+    styleLookups=0;
+    transformedPoints=0;
+    culledObjects=0;
+    labelsPlaced=0;
+    labelsRejected=0;
+  }
+
+  double RenderStatistics::GetTotalTime() const
+  {
+    double total=0.0;
+
+    for (const auto time : stepTime) {
+      total+=time;
+    }
+
+    return total;
+  }
+
+  RenderStatistics& RenderStatistics::operator+=(const RenderStatistics& other)
+  {
+    for (size_t step=RenderSteps::FirstStep; step<=RenderSteps::LastStep; step++) {
+      stepTime[step]+=other.stepTime[step];
+    }
+
+    styleLookups+=other.styleLookups;
+    transformedPoints+=other.transformedPoints;
+    culledObjects+=other.culledObjects;
+    labelsPlaced+=other.labelsPlaced;
+    labelsRejected+=other.labelsRejected;
+
+    return *this;
+  }
+
   MapPainter::MapPainter(const StyleConfigRef& styleConfig,
                          CoordBuffer *buffer)
   : coordBuffer(buffer),
@@ -838,6 +921,8 @@ namespace osmscout {
                                   projection,
                                   textStyles);
 
+    renderStatistics.styleLookups+=2;
+
     if (!iconStyle && textStyles.empty()) {
       return;
     }
@@ -873,6 +958,8 @@ namespace osmscout {
                                                                         *areaData.buffer,
                                                                         projection);
 
+    renderStatistics.styleLookups++;
+
     if (!borderTextStyle) {
       return false;
     }
@@ -934,6 +1021,8 @@ namespace osmscout {
                                                                               *areaData.buffer,
                                                                               projection);
 
+    renderStatistics.styleLookups++;
+
     if (!borderSymbolStyle) {
       return false;
     }
@@ -981,6 +1070,8 @@ namespace osmscout {
                                  projection,
                                  textStyles);
 
+    renderStatistics.styleLookups+=2;
+
     double x,y;
 
     Transform(projection,
@@ -1034,6 +1125,8 @@ namespace osmscout {
     PathSymbolStyleRef pathSymbolStyle=styleConfig.GetWayPathSymbolStyle(*data.buffer,
                                                                          projection);
 
+    renderStatistics.styleLookups++;
+
     if (!pathSymbolStyle) {
       return false;
     }
@@ -1077,6 +1170,8 @@ namespace osmscout {
     PathShieldStyleRef shieldStyle=styleConfig.GetWayPathShieldStyle(data.GetFeatureValueBuffer(),
                                                                      projection);
 
+    renderStatistics.styleLookups++;
+
     if (!shieldStyle) {
       return false;
     }
@@ -1105,6 +1200,8 @@ namespace osmscout {
     PathTextStyleRef pathTextStyle=styleConfig.GetWayPathTextStyle(*data.buffer,
                                                                    projection);
 
+    renderStatistics.styleLookups++;
+
     if (!pathTextStyle) {
       return false;
     }
@@ -1276,6 +1373,8 @@ namespace osmscout {
                                   ring.nodes,
                                   td[i].transStart,td[i].transEnd,
                                   errorTolerancePixel);
+
+        renderStatistics.transformedPoints+=ring.nodes.size();
       }else{
         std::vector<Point> nodes;
         for (const auto &segment:ring.segments){
@@ -1292,6 +1391,8 @@ namespace osmscout {
                                   nodes,
                                   td[i].transStart,td[i].transEnd,
                                   errorTolerancePixel);
+
+        renderStatistics.transformedPoints+=nodes.size();
       }
     }
 
@@ -1323,6 +1424,8 @@ namespace osmscout {
                                       projection,
                                       borderStyles);
 
+      renderStatistics.styleLookups+=2;
+
       if (!fillStyle && borderStyles.empty()) {
         return false;
       }
@@ -1345,6 +1448,8 @@ namespace osmscout {
       if (!IsVisibleArea(projection,
                          a.boundingBox,
                          borderWidth/2.0)) {
+        renderStatistics.culledObjects++;
+
         return false;
       }
 
@@ -1447,11 +1552,14 @@ namespace osmscout {
                                  projection,
                                  lineStyles);
 
+    renderStatistics.styleLookups++;
+
     if (lineStyles.empty()) {
       return;
     }
 
     bool               transformed=false;
+    bool               culled=false;
     size_t             transStart=0; // Make the compiler happy
     size_t             transEnd=0;   // Make the compiler happy
     double             mainSlotWidth=0.0;
@@ -1527,6 +1635,7 @@ namespace osmscout {
       if (!IsVisibleWay(projection,
                         way.GetBoundingBox(),
                         lineWidth/2)) {
+        culled=true;
         continue;
       }
 
@@ -1538,6 +1647,8 @@ namespace osmscout {
                                    transStart,
                                    transEnd,
                                    errorTolerancePixel);
+
+          renderStatistics.transformedPoints+=way.nodes.size();
         }
         else {
           std::vector<Point> nodes;
@@ -1556,6 +1667,8 @@ namespace osmscout {
                                    transStart,
                                    transEnd,
                                    errorTolerancePixel);
+
+          renderStatistics.transformedPoints+=nodes.size();
         }
 
         WayPathData pathData;
@@ -1627,6 +1740,10 @@ namespace osmscout {
         wayData.push_back(data);
       }
     }
+
+    if (culled && !transformed) {
+      renderStatistics.culledObjects++;
+    }
   }
 
   void MapPainter::PrepareWays(const StyleConfig& styleConfig,
@@ -1680,19 +1797,33 @@ namespace osmscout {
   {
     assert(startStep>=RenderSteps::FirstStep);
     assert(startStep<=RenderSteps::LastStep);
+    assert(endStep>=startStep);
+    assert(endStep<=RenderSteps::LastStep);
+
+    renderStatistics.Reset();
 
     for (size_t step=startStep; step<=endStep; step++) {
       StepMethod stepMethod=stepMethods[step];
 
       assert(stepMethod!=nullptr);
 
+      StopClockNano stepTimer;
+
       (this->*stepMethod)(projection,parameter,data);
 
+      stepTimer.Stop();
+
+      renderStatistics.stepTime[step]=stepTimer.GetNanoseconds()/1000000.0;
+
       if (parameter.IsAborted()) {
         return false;
       }
     }
 
+    if (parameter.GetRenderStatisticsCallback()) {
+      parameter.GetRenderStatisticsCallback()(renderStatistics);
+    }
+
     return true;
   }
 
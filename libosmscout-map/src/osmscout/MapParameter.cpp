@@ -251,6 +251,11 @@ namespace osmscout {
     this->breaker=breaker;
   }
 
+  void MapParameter::SetRenderStatisticsCallback(const RenderStatisticsCallback& callback)
+  {
+    this->renderStatisticsCallback=callback;
+  }
+
   void MapParameter::RegisterFillStyleProcessor(size_t typeIndex,
                                                 const FillStyleProcessorRef& processor)
   {
@@ -33,6 +33,7 @@ namespace osmscout {
   AreaSearchParameter::AreaSearchParameter()
   : maxAreaLevel(4),
     useLowZoomOptimization(true),
+    useLODData(true),
     useMultithreading(false)
   {
     // no code
@@ -48,6 +49,16 @@ namespace osmscout {
     this->useLowZoomOptimization=useLowZoomOptimization;
   }
 
+  /**
+   * If set and the database holds simplified geometries of ways and areas,
+   * ways and areas are loaded in the level of detail for the magnification
+   * of the tile.
+   */
+  void AreaSearchParameter::SetUseLODData(bool useLODData)
+  {
+    this->useLODData=useLODData;
+  }
+
   void AreaSearchParameter::SetUseMultithreading(bool useMultithreading)
   {
     this->useMultithreading=useMultithreading;
@@ -68,6 +79,11 @@ namespace osmscout {
     return useLowZoomOptimization;
   }
 
+  bool AreaSearchParameter::GetUseLODData() const
+  {
+    return useLODData;
+  }
+
   bool AreaSearchParameter::GetUseMultithreading() const
   {
     return useMultithreading;
@@ -86,6 +102,9 @@ namespace osmscout {
   MapService::MapService(const DatabaseRef& database)
    : database(database),
      cache(25),
+     nodeQueryCache(25*indexQueryCacheFactor),
+     wayQueryCache(25*indexQueryCacheFactor),
+     areaQueryCache(25*indexQueryCacheFactor),
      nodeWorkerThread(&MapService::NodeWorkerLoop,this),
      wayWorkerThread(&MapService::WayWorkerLoop,this),
      wayLowZoomWorkerThread(&MapService::WayLowZoomWorkerLoop,this),
@@ -112,13 +131,18 @@ namespace osmscout {
   }
 
   /**
-   * Set the size of the tile data cache
+   * Set the size of the tile data cache. The caches of index query results
+   * hold indexQueryCacheFactor times more tiles.
    */
   void MapService::SetCacheSize(size_t cacheSize)
   {
     std::lock_guard<std::mutex> lock(stateMutex);
 
     cache.SetSize(cacheSize);
+
+    nodeQueryCache.SetMaxSize(cacheSize*indexQueryCacheFactor);
+    wayQueryCache.SetMaxSize(cacheSize*indexQueryCacheFactor);
+    areaQueryCache.SetMaxSize(cacheSize*indexQueryCacheFactor);
   }
 
   size_t MapService::GetCacheSize() const
@@ -155,6 +179,10 @@ namespace osmscout {
     size_t size=cache.GetSize();
     cache.SetSize(0);
     cache.SetSize(size);
+
+    nodeQueryCache.Flush();
+    wayQueryCache.Flush();
+    areaQueryCache.Flush();
   }
 
   /**
@@ -256,12 +284,26 @@ namespace osmscout {
     }
 
     if (!requestedNodeTypes.Empty()) {
-      if (!areaNodeIndex->GetOffsets(boundingBox,
-                                     requestedNodeTypes,
-                                     offsets,
-                                     loadedNodeTypes)) {
-        log.Error() << "Error getting nodes from area node index!";
-        return false;
+      if (!nodeQueryCache.Get(areaNodeIndex,
+                              tile->GetKey(),
+                              0,
+                              requestedNodeTypes,
+                              offsets,
+                              loadedNodeTypes)) {
+        if (!areaNodeIndex->GetOffsets(boundingBox,
+                                       requestedNodeTypes,
+                                       offsets,
+                                       loadedNodeTypes)) {
+          log.Error() << "Error getting nodes from area node index!";
+          return false;
+        }
+
+        nodeQueryCache.Set(areaNodeIndex,
+                           tile->GetKey(),
+                           0,
+                           requestedNodeTypes,
+                           offsets,
+                           loadedNodeTypes);
       }
 
       if (parameter.IsAborted()) {
@@ -280,8 +322,11 @@ namespace osmscout {
 
         if (!database->GetNodesByOffset(offsets,
                                         boundingBox,
-                                        nodes)) {
-          log.Error() << "Error reading nodes in area!";
+                                        nodes,
+                                        parameter.GetBreaker())) {
+          if (!parameter.IsAborted()) {
+            log.Error() << "Error reading nodes in area!";
+          }
           return false;
         }
 
@@ -417,15 +462,31 @@ namespace osmscout {
     }
 
     if (!requestedAreaTypes.Empty()) {
-      if (!areaAreaIndex->GetAreasInArea(*database->GetTypeConfig(),
-                                         boundingBox,
-                                         magnification.GetLevel()+
-                                         parameter.GetMaximumAreaLevel(),
-                                         requestedAreaTypes,
-                                         spans,
-                                         loadedAreaTypes)) {
-        log.Error() << "Error getting areas from area index!";
-        return false;
+      uint32_t maxAreaLevel=magnification.GetLevel()+
+                            parameter.GetMaximumAreaLevel();
+
+      if (!areaQueryCache.Get(areaAreaIndex,
+                              tile->GetKey(),
+                              maxAreaLevel,
+                              requestedAreaTypes,
+                              spans,
+                              loadedAreaTypes)) {
+        if (!areaAreaIndex->GetAreasInArea(*database->GetTypeConfig(),
+                                           boundingBox,
+                                           maxAreaLevel,
+                                           requestedAreaTypes,
+                                           spans,
+                                           loadedAreaTypes)) {
+          log.Error() << "Error getting areas from area index!";
+          return false;
+        }
+
+        areaQueryCache.Set(areaAreaIndex,
+                           tile->GetKey(),
+                           maxAreaLevel,
+                           requestedAreaTypes,
+                           spans,
+                           loadedAreaTypes);
       }
 
       if (parameter.IsAborted()) {
@@ -441,10 +502,24 @@ namespace osmscout {
         }
 
         std::vector<AreaRef> areas;
+        bool                 success;
+
+        if (parameter.GetUseLODData()) {
+          success=database->GetAreasByBlockSpans(spans,
+                                                 magnification,
+                                                 areas,
+                                                 parameter.GetBreaker());
+        }
+        else {
+          success=database->GetAreasByBlockSpans(spans,
+                                                 areas,
+                                                 parameter.GetBreaker());
+        }
 
-        if (!database->GetAreasByBlockSpans(spans,
-                                            areas)) {
-          log.Error() << "Error reading areas in area!";
+        if (!success) {
+          if (!parameter.IsAborted()) {
+            log.Error() << "Error reading areas in area!";
+          }
           return false;
         }
 
@@ -550,6 +625,7 @@ namespace osmscout {
 
   bool MapService::GetWays(const AreaSearchParameter& parameter,
                            const TypeInfoSet& wayTypes,
+                           const Magnification& magnification,
                            const GeoBox& boundingBox,
                            bool prefill,
                            const TileRef& tile) const
@@ -578,12 +654,26 @@ namespace osmscout {
     }
 
     if (!requestedWayTypes.Empty()) {
-      if (!areaWayIndex->GetOffsets(boundingBox,
-                                    requestedWayTypes,
-                                    offsets,
-                                    loadedWayTypes)) {
-        log.Error() << "Error getting ways from area way index!";
-        return false;
+      if (!wayQueryCache.Get(areaWayIndex,
+                             tile->GetKey(),
+                             0,
+                             requestedWayTypes,
+                             offsets,
+                             loadedWayTypes)) {
+        if (!areaWayIndex->GetOffsets(boundingBox,
+                                      requestedWayTypes,
+                                      offsets,
+                                      loadedWayTypes)) {
+          log.Error() << "Error getting ways from area way index!";
+          return false;
+        }
+
+        wayQueryCache.Set(areaWayIndex,
+                          tile->GetKey(),
+                          0,
+                          requestedWayTypes,
+                          offsets,
+                          loadedWayTypes);
       }
 
       if (parameter.IsAborted()) {
@@ -599,10 +689,24 @@ namespace osmscout {
         }
 
         std::vector<WayRef> ways;
+        bool                success;
+
+        if (parameter.GetUseLODData()) {
+          success=database->GetWaysByOffset(offsets,
+                                            magnification,
+                                            ways,
+                                            parameter.GetBreaker());
+        }
+        else {
+          success=database->GetWaysByOffset(offsets,
+                                            ways,
+                                            parameter.GetBreaker());
+        }
 
-        if (!database->GetWaysByOffset(offsets,
-                                       ways)) {
-          log.Error() << "Error reading ways in area!";
+        if (!success) {
+          if (!parameter.IsAborted()) {
+            log.Error() << "Error reading ways in area!";
+          }
           return false;
         }
 
@@ -765,6 +869,7 @@ namespace osmscout {
 
   std::future<bool> MapService::PushWayTask(const AreaSearchParameter& parameter,
                                             const TypeInfoSet& wayTypes,
+                                            const Magnification& magnification,
                                             const GeoBox& boundingBox,
                                             bool prefill,
                                             const TileRef& tile) const
@@ -772,6 +877,7 @@ namespace osmscout {
     std::packaged_task<bool()> task(std::bind(&MapService::GetWays,this,
                                               parameter,
                                               wayTypes,
+                                              magnification,
                                               boundingBox,
                                               prefill,
                                               tile));
@@ -783,6 +889,39 @@ namespace osmscout {
     return future;
   }
 
+  /**
+   * Prefill the tile with the data of its parent tile, if cached. Ways and areas
+   * of the parent tile are not reused, if they were loaded in a different level
+   * of detail than the tile requires.
+   */
+  void MapService::PrefillDataFromCache(const AreaSearchParameter& parameter,
+                                        const Magnification& magnification,
+                                        const TypeDefinition& typeDefinition,
+                                        Tile& tile) const
+  {
+    bool prefillWays=true;
+    bool prefillAreas=true;
+
+    if (parameter.GetUseLODData() &&
+        magnification.GetLevel()>0) {
+      Magnification      parentMagnification(MagnificationLevel(magnification.GetLevel()-1));
+      WayLODDataFileRef  wayLODDataFile=database->GetWayLODDataFile();
+      AreaLODDataFileRef areaLODDataFile=database->GetAreaLODDataFile();
+
+      prefillWays=!wayLODDataFile ||
+                  wayLODDataFile->HasSameLevel(magnification,parentMagnification);
+      prefillAreas=!areaLODDataFile ||
+                   areaLODDataFile->HasSameLevel(magnification,parentMagnification);
+    }
+
+    cache.PrefillDataFromCache(tile,
+                               typeDefinition.nodeTypes,
+                               prefillWays ? typeDefinition.wayTypes : TypeInfoSet(),
+                               prefillAreas ? typeDefinition.areaTypes : TypeInfoSet(),
+                               typeDefinition.optimizedWayTypes,
+                               typeDefinition.optimizedAreaTypes);
+  }
+
   void MapService::NotifyTileStateCallbacks(const TileRef& tile) const
   {
     std::lock_guard<std::mutex> lock(callbackMutex);
@@ -881,6 +1020,11 @@ namespace osmscout {
     std::list<std::future<bool>> results;
 
     for (auto& tile : tiles) {
+      if (parameter.IsAborted()) {
+        // neither prepare type definitions nor queue tasks for superseded requests
+        break;
+      }
+
       GeoBox          tileBoundingBox(tile->GetBoundingBox());
 
       if (!tile->IsComplete()) {
@@ -899,12 +1043,10 @@ namespace osmscout {
           typeDefinitionMagnification=magnification;
         }
 
-        cache.PrefillDataFromCache(*tile,
-                                   typeDefinition->nodeTypes,
-                                   typeDefinition->wayTypes,
-                                   typeDefinition->areaTypes,
-                                   typeDefinition->optimizedWayTypes,
-                                   typeDefinition->optimizedAreaTypes);
+        PrefillDataFromCache(parameter,
+                             magnification,
+                             *typeDefinition,
+                             *tile);
 
         NotifyTileStateCallbacks(tile);
 
@@ -941,6 +1083,7 @@ namespace osmscout {
 
         results.push_back(PushWayTask(parameter,
                                       typeDefinition->wayTypes,
+                                      magnification,
                                       tileBoundingBox,
                                       false,
                                       tile));
@@ -959,7 +1102,7 @@ namespace osmscout {
       }
     }
 
-    bool success=true;
+    bool success=!parameter.IsAborted();
 
     if (async) {
       results.clear();
@@ -996,6 +1139,11 @@ namespace osmscout {
     std::list<std::future<bool>> results;
 
     for (auto& tile : tiles) {
+      if (parameter.IsAborted()) {
+        // do not queue tasks for superseded requests
+        break;
+      }
+
       GeoBox tileBoundingBox(tile->GetBoundingBox());
 
       if (!tile->IsComplete()) {
@@ -1003,12 +1151,10 @@ namespace osmscout {
 
         //std::cout << "Loading tile: " << (std::string)tile->GetId() << std::endl;
 
-        cache.PrefillDataFromCache(*tile,
-                                   typeDefinition.nodeTypes,
-                                   typeDefinition.wayTypes,
-                                   typeDefinition.areaTypes,
-                                   typeDefinition.optimizedWayTypes,
-                                   typeDefinition.optimizedAreaTypes);
+        PrefillDataFromCache(parameter,
+                             magnification,
+                             typeDefinition,
+                             *tile);
 
         NotifyTileStateCallbacks(tile);
 
@@ -1045,6 +1191,7 @@ namespace osmscout {
 
         results.push_back(PushWayTask(parameter,
                                       typeDefinition.wayTypes,
+                                      magnification,
                                       tileBoundingBox,
                                       true,
                                       tile));
@@ -1063,7 +1210,7 @@ namespace osmscout {
       }
     }
 
-    bool success=true;
+    bool success=!parameter.IsAborted();
 
     if (async) {
       results.clear();
@@ -63,6 +63,15 @@ namespace osmscout {
       FileOffset data;        //!< The file index at which the data payload starts
     };
 
+    /**
+      Index cell of one of the top levels of the index, which are held in memory.
+      */
+    struct TopLevelCell
+    {
+      IndexCell cell;
+      uint32_t  childIndex[4]; //!< Index of each of the four children in topLevelCells, if the child is held in memory
+    };
+
     typedef Cache<FileOffset,IndexCell> IndexCache;
 
     struct IndexCacheValueSizer : public IndexCache::ValueSizer
@@ -82,36 +91,55 @@ namespace osmscout {
       FileOffset offset;
       size_t     x;
       size_t     y;
+      uint32_t   topLevelIndex; //!< Index of the cell in topLevelCells, if the cell is held in memory
 
       CellRef(FileOffset offset,
               size_t x,
-              size_t y)
+              size_t y,
+              uint32_t topLevelIndex)
       : offset(offset),
         x(x),
-        y(y)
+        y(y),
+        topLevelIndex(topLevelIndex)
       {
         // no code
       }
     };
 
+    /**
+     * Maximum number of levels (starting with the top level) held in memory
+     */
+    static const uint32_t maxTopLevels=6;
+
   private:
     std::string           datafilename;   //!< Full path and name of the data file
-    mutable FileScanner   scanner;        //!< Scanner instance for reading this file
+    FileScanner           scanner;        //!< Scanner instance for reading this file
 
     uint32_t              maxLevel;       //!< Maximum level in index
     FileOffset            topLevelOffset; //!< File offset of the top level index entry
 
-    mutable IndexCache    indexCache;     //!< Cached map of all index entries by file offset
+    uint32_t                  topLevels;     //!< Number of levels held in topLevelCells
+    std::vector<TopLevelCell> topLevelCells; //!< Cells of the top levels in breadth first order, starting with the top level cell
 
-    mutable std::mutex    lookupMutex;
+    mutable IndexCache    indexCache;     //!< Cached map of all index entries by file offset
+    mutable std::mutex    indexCacheMutex;
 
   private:
-    bool GetIndexCell(uint32_t level,
+    void ReadIndexCell(FileCursor& cursor,
+                       uint32_t level,
+                       FileOffset offset,
+                       IndexCell& indexCell) const;
+
+    void ReadTopLevels();
+
+    bool GetIndexCell(FileCursor& cursor,
+                      uint32_t level,
                       FileOffset offset,
                       IndexCell& indexCell,
                       FileOffset& dataOffset) const;
 
-    bool ReadCellData(const TypeConfig& typeConfig,
+    bool ReadCellData(FileCursor& cursor,
+                      const TypeConfig& typeConfig,
                       const TypeInfoSet& types,
                       FileOffset dataOffset,
                       std::vector<DataBlockSpan>& spans) const;
@@ -121,6 +149,7 @@ namespace osmscout {
                                double maxlon,
                                double maxlat,
                                const IndexCell & cellIndexData,
+                               const TopLevelCell* topLevelCell,
                                const CellDimension& cellDimension,
                                size_t cx,
                                size_t cy,
@@ -22,7 +22,6 @@
 
 #include <map>
 #include <memory>
-#include <mutex>
 #include <vector>
 
 #include <osmscout/TypeConfig.h>
@@ -73,24 +72,25 @@ namespace osmscout {
     };
 
   private:
-    mutable FileScanner   scanner;        //!< Scanner instance for reading this file,
-                                          //!< guarded by lookupMutex (Open and Close method are not guarded!)
+    FileScanner           scanner;        //!< Scanner instance for reading this file,
+                                          //!< lookups use their own FileCursor (Open and Close method are not thread safe!)
 
     MagnificationLevel    gridMag;
     std::vector<TypeData> nodeTypeData;
 
-    mutable std::mutex    lookupMutex;
-
   private:
-    bool GetOffsetsList(const TypeData& typeData,
+    bool GetOffsetsList(FileCursor& cursor,
+                        const TypeData& typeData,
                         const GeoBox& boundingBox,
                         std::vector<FileOffset>& offsets) const;
 
-    bool GetOffsetsTileList(const TypeData& typeData,
+    bool GetOffsetsTileList(FileCursor& cursor,
+                            const TypeData& typeData,
                             const GeoBox& boundingBox,
                             std::vector<FileOffset>& offsets) const;
 
-    bool GetOffsetsBitmap(const TypeData& typeData,
+    bool GetOffsetsBitmap(FileCursor& cursor,
+                          const TypeData& typeData,
                           const GeoBox& boundingBox,
                           std::vector<FileOffset>& offsets) const;
 
@@ -21,8 +21,6 @@
 */
 
 #include <memory>
-#include <mutex>
-#include <unordered_set>
 #include <vector>
 
 #include <osmscout/TypeConfig.h>
@@ -51,31 +49,54 @@ namespace osmscout {
       TypeInfoRef         type;
       MagnificationLevel  indexLevel;
 
-      uint8_t             dataOffsetBytes;
-      FileOffset          bitmapOffset;
-
       TileIdBox           tileBox;
 
       GeoBox              boundingBox;
 
+      uint8_t              presenceShift; //!< Presence cells summarize 2^presenceShift x 2^presenceShift tiles
+      TileIdBox            presenceBox;   //!< tileBox in presence cell coordinates
+      std::vector<uint8_t> presence;      //!< Bitset of presence cells (row by row) containing data
+
       TypeData();
 
+      bool GetPresentColumns(uint32_t y,
+                             uint32_t& minX,
+                             uint32_t& maxX) const;
+    };
+
+    /**
+     * All types indexed at the same level share one bitmap over the union of
+     * their tile boxes. The record of a cell holds the offsets of all types of
+     * the level, so one pass over the rows of the bitmap returns the offsets of
+     * all requested types.
+     */
+    struct LevelData
+    {
+      MagnificationLevel  indexLevel;
+      uint8_t             dataOffsetBytes;
+      FileOffset          bitmapOffset;
+      TileIdBox           tileBox;    //!< Union of the tile boxes of all types of the level
+      std::vector<size_t> types;      //!< Indexes into wayTypeData, the position is the type index in cell records
+
+      LevelData();
+
       FileOffset GetDataOffset() const;
       FileOffset GetCellOffset(size_t x, size_t y) const;
     };
 
   private:
     std::string           datafilename;   //!< Full path and name of the data file
-    mutable FileScanner   scanner;        //!< Scanner instance for reading this file
-
-    std::vector<TypeData> wayTypeData;
+    FileScanner           scanner;        //!< Scanner instance for reading this file
 
-    mutable std::mutex    lookupMutex;
+    std::vector<TypeData>  wayTypeData;
+    std::vector<LevelData> levelData;  //!< Types with data, grouped by index level
 
   private:
-    void GetOffsets(const TypeData& typeData,
-                    const GeoBox& boundingBox,
-                    std::unordered_set<FileOffset>& offsets) const;
+    void GetOffsets(FileCursor& cursor,
+                    const LevelData& level,
+                    const std::vector<bool>& requestedTypes,
+                    const TileIdBox& boundingTileBox,
+                    std::vector<FileOffset>& offsets) const;
 
   public:
     AreaWayIndex();
@@ -0,0 +1,93 @@
+#ifndef OSMSCOUT_COVERAGEDIRECTORY_H
+#define OSMSCOUT_COVERAGEDIRECTORY_H
+
+/*
+  This source is part of the libosmscout library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <osmscout/CoverageIndex.h>
+#include <osmscout/GeoCoord.h>
+#include <osmscout/Pixel.h>
+
+#include <osmscout/routing/DBFileOffset.h>
+
+#include <osmscout/util/GeoBox.h>
+
+namespace osmscout {
+
+  /**
+    \ingroup Database
+
+    CoverageDirectory answers which of a number of databases cover a given
+    coordinate or bounding box, without asking every database.
+
+    The coverage of all databases is summarized in a quadtree of geographic
+    cells. Level 0 is a single cell for the whole world, on every level each
+    cell is split into four cells. Each cell holds the databases that cover at
+    least one of its coverage index cells. A bounding box query descends the
+    tree from the root and only visits cells that intersect the box and are covered
+    by at least one database. Coordinates are finally checked against the coverage
+    indexes of the databases found.
+
+    Databases without a coverage index are treated as covering everything.
+    */
+  class OSMSCOUT_API CoverageDirectory
+  {
+  public:
+    static const uint32_t DEFAULT_LEVEL;
+
+  private:
+    typedef std::unordered_map<uint64_t,std::vector<DatabaseId>> CellMap;
+
+  private:
+    uint32_t                                         levelCount;         //!< Number of levels of the tree
+    std::vector<CellMap>                             levels;             //!< Databases covering a cell, for each level
+    std::unordered_map<DatabaseId,CoverageIndexRef> databases;          //!< Coverage index of all databases with a coverage index
+    std::vector<DatabaseId>                          uncoveredDatabases; //!< Databases without coverage index
+
+  private:
+    void AddCell(uint32_t level,
+                 const Pixel& cell,
+                 DatabaseId id);
+
+    void GetDatabases(uint32_t level,
+                      const Pixel& cell,
+                      const Pixel& minLeaf,
+                      const Pixel& maxLeaf,
+                      std::vector<DatabaseId>& result) const;
+
+  public:
+    explicit CoverageDirectory(uint32_t maxLevel=DEFAULT_LEVEL);
+
+    void Clear();
+
+    void AddDatabase(DatabaseId id,
+                     const CoverageIndexRef& index);
+
+    void GetDatabases(const GeoCoord& coord,
+                      std::vector<DatabaseId>& result) const;
+
+    void GetDatabases(const GeoBox& boundingBox,
+                      std::vector<DatabaseId>& result) const;
+  };
+}
+
+#endif
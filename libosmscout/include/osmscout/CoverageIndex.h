@@ -66,6 +66,21 @@ namespace osmscout {
       return scanner.IsOpen();
     }
 
+    inline uint32_t GetCellLevel() const
+    {
+      return cellLevel;
+    }
+
+    inline Pixel GetMinCell() const
+    {
+      return minCell;
+    }
+
+    inline Pixel GetMaxCell() const
+    {
+      return maxCell;
+    }
+
     Pixel GetTile(const GeoCoord& coord) const;
     bool IsCovered(const Pixel& tile) const;
 
@@ -20,6 +20,7 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -29,6 +30,8 @@
 #include <osmscout/NumericIndex.h>
 #include <osmscout/TypeConfig.h>
 
+#include <osmscout/util/Arena.h>
+#include <osmscout/util/Breaker.h>
 #include <osmscout/util/Cache.h>
 #include <osmscout/util/FileScanner.h>
 #include <osmscout/util/Logger.h>
@@ -96,6 +99,30 @@ namespace osmscout {
     bool ReadData(N& data) const;
     bool ReadData(FileOffset offset,
                   N& data) const;
+    bool ReadData(FileOffset offset,
+                  N& data,
+                  FileOffset& streamOffset) const;
+
+    /**
+     * Marker for an unknown position of the stream
+     */
+    static const FileOffset unknownStreamOffset=std::numeric_limits<FileOffset>::max();
+
+    /**
+     * Batch reads of at least this number of entries decode the feature values
+     * of all read objects into one common arena
+     */
+    static const size_t arenaBatchSize=32;
+
+    /**
+     * Batch reads check the optional breaker every this number of entries
+     */
+    static const size_t breakerCheckInterval=256;
+
+    static inline ArenaRef CreateBatchArena(size_t count)
+    {
+      return count>=arenaBatchSize ? std::make_shared<Arena>() : nullptr;
+    }
 
   public:
     DataFile(const std::string& datafile, size_t cacheSize);
@@ -121,12 +148,14 @@ namespace osmscout {
 
     template<typename IteratorIn>
     bool GetByOffset(IteratorIn begin, IteratorIn end, size_t size,
-                     std::vector<ValueType>& data) const;
+                     std::vector<ValueType>& data,
+                     const BreakerRef& breaker=nullptr) const;
 
     template<typename IteratorIn>
     bool GetByOffset(IteratorIn begin, IteratorIn end, size_t size,
                      const GeoBox& boundingBox,
-                     std::vector<ValueType>& data) const;
+                     std::vector<ValueType>& data,
+                     const BreakerRef& breaker=nullptr) const;
 
     template<typename IteratorIn>
     bool GetByOffset(IteratorIn begin, IteratorIn end, size_t size,
@@ -134,7 +163,8 @@ namespace osmscout {
 
     template<typename IteratorIn>
     bool GetByBlockSpans(IteratorIn begin, IteratorIn end,
-                         std::vector<ValueType>& data) const;
+                         std::vector<ValueType>& data,
+                         const BreakerRef& breaker=nullptr) const;
   };
 
   template <class N>
@@ -175,6 +205,38 @@ namespace osmscout {
     return true;
   }
 
+  /**
+   * Read one data value from the given file offset. streamOffset is the position of the
+   * stream after the previously read value (or unknownStreamOffset) and gets updated.
+   * If the value directly follows the previously read one, seeking is skipped, so
+   * reading offsets in file order reads contiguous runs of values sequentially.
+   *
+   * Method is NOT thread-safe.
+   */
+  template <class N>
+  bool DataFile<N>::ReadData(FileOffset offset,
+                             N& data,
+                             FileOffset& streamOffset) const
+  {
+    try {
+      if (offset!=streamOffset) {
+        scanner.SetPos(offset);
+      }
+
+      data.Read(*typeConfig,
+                scanner);
+
+      streamOffset=scanner.GetPos();
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      streamOffset=unknownStreamOffset;
+      return false;
+    }
+
+    return true;
+  }
+
   /**
    * Read one data value from the current position of the stream
    *
@@ -261,7 +323,8 @@ namespace osmscout {
   /**
    * Reads data for the given file offsets. File offsets are passed by iterator over
    * some container. the size parameter hints as the number of entries returned by the iterators
-   * and is used to preallocate enough room in the result vector.
+   * and is used to preallocate enough room in the result vector. Offsets sorted in file order
+   * are read with as few seeks as possible.
    *
    * @tparam N
    *    Object type managed by the data file
@@ -276,8 +339,10 @@ namespace osmscout {
    *    in result vector.
    * @param data
    *    vector containing data. Data is appended.
+   * @param breaker
+   *    Optional breaker, it is checked every breakerCheckInterval entries
    * @return
-   *    false if there was an error, else true
+   *    false if there was an error or reading was aborted, else true
    *
    * Method is thread-safe.
    */
@@ -285,7 +350,8 @@ namespace osmscout {
   template <typename IteratorIn>
   bool DataFile<N>::GetByOffset(IteratorIn begin, IteratorIn end,
                                 size_t size,
-                                std::vector<ValueType>& data) const
+                                std::vector<ValueType>& data,
+                                const BreakerRef& breaker) const
   {
     if (size==0) {
       return true;
@@ -293,13 +359,23 @@ namespace osmscout {
 
     data.reserve(data.size()+size);
     std::lock_guard<std::mutex> lock(accessMutex);
+    ArenaScope                  arenaScope(CreateBatchArena(size));
 
     if (cache.GetMaxSize()>0 &&
         size>cache.GetMaxSize()){
       log.Warn() << "Cache size (" << cache.GetMaxSize() << ") for file " << datafile << " is smaller than current request (" << size << ")";
     }
 
+    size_t     readCount=0;
+    FileOffset streamOffset=unknownStreamOffset;
+
     for (IteratorIn offsetIter=begin; offsetIter!=end; ++offsetIter) {
+      if (readCount++%breakerCheckInterval==0 &&
+          breaker &&
+          breaker->IsAborted()) {
+        return false;
+      }
+
       ValueCacheRef entryRef;
 
       if (cache.GetEntry(*offsetIter,entryRef)) {
@@ -309,7 +385,8 @@ namespace osmscout {
         ValueType value=std::make_shared<N>();
 
         if (!ReadData(*offsetIter,
-                      *value)) {
+                      *value,
+                      streamOffset)) {
           log.Error() << "Error while reading data from offset " << *offsetIter << " of file " << datafilename << "!";
           return false;
         }
@@ -323,7 +400,10 @@ namespace osmscout {
   }
 
   /**
-   * Read data values from the given file offsets.
+   * Read data values from the given file offsets, values not intersecting
+   * the given bounding box are skipped. Reading is stopped (and false returned)
+   * if the optional breaker is aborted, it is checked every breakerCheckInterval
+   * entries.
    *
    * Method is thread-safe.
    */
@@ -332,7 +412,8 @@ namespace osmscout {
   bool DataFile<N>::GetByOffset(IteratorIn begin, IteratorIn end,
                                 size_t size,
                                 const GeoBox& boundingBox,
-                                std::vector<ValueType>& data) const
+                                std::vector<ValueType>& data,
+                                const BreakerRef& breaker) const
   {
     if (size==0) {
       return true;
@@ -340,6 +421,7 @@ namespace osmscout {
 
     data.reserve(data.size()+size);
     std::lock_guard<std::mutex> lock(accessMutex);
+    ArenaScope                  arenaScope(CreateBatchArena(size));
 
     if (cache.GetMaxSize()>0 &&
         size>cache.GetMaxSize()){
@@ -348,8 +430,17 @@ namespace osmscout {
 
     //std::map<std::string,size_t> hitRateTypes;
     //std::map<std::string,size_t> missRateTypes;
-    size_t inBoxCount=0;
+    size_t     inBoxCount=0;
+    size_t     readCount=0;
+    FileOffset streamOffset=unknownStreamOffset;
+
     for (IteratorIn offsetIter=begin; offsetIter!=end; ++offsetIter) {
+      if (readCount++%breakerCheckInterval==0 &&
+          breaker &&
+          breaker->IsAborted()) {
+        return false;
+      }
+
       ValueType value=std::make_shared<N>();
 
       ValueCacheRef entryRef;
@@ -357,7 +448,8 @@ namespace osmscout {
         value=entryRef->value;
       }else{
         if (!ReadData(*offsetIter,
-                      *value)) {
+                      *value,
+                      streamOffset)) {
           log.Error() << "Error while reading data from offset " << *offsetIter << " of file " << datafilename << "!";
           return false;
         }
@@ -470,6 +562,8 @@ namespace osmscout {
 
     std::lock_guard<std::mutex> lock(accessMutex);
 
+    ArenaScope arenaScope(CreateBatchArena(span.count));
+
     try {
       bool offsetSetup=false;
       FileOffset offset=span.startOffset;
@@ -510,14 +604,17 @@ namespace osmscout {
   }
 
   /**
-   * Read data values from the given DataBlockSpans.
+   * Read data values from the given DataBlockSpans. Reading is stopped
+   * (and false returned) if the optional breaker is aborted, it is checked
+   * every breakerCheckInterval entries.
    *
    * Method is thread-safe.
    */
   template <class N>
   template<typename IteratorIn>
   bool DataFile<N>::GetByBlockSpans(IteratorIn begin, IteratorIn end,
-                                    std::vector<ValueType>& data) const
+                                    std::vector<ValueType>& data,
+                                    const BreakerRef& breaker) const
   {
     uint32_t overallCount=0;
 
@@ -529,6 +626,9 @@ namespace osmscout {
 
     try {
       std::lock_guard<std::mutex> lock(accessMutex);
+      ArenaScope                  arenaScope(CreateBatchArena(overallCount));
+      size_t                      readCount=0;
+
       for (IteratorIn spanIter=begin; spanIter!=end; ++spanIter) {
         if (spanIter->count==0) {
           continue;
@@ -538,6 +638,12 @@ namespace osmscout {
         FileOffset offset=spanIter->startOffset;
 
         for (uint32_t i=1; i<=spanIter->count; i++) {
+          if (readCount++%breakerCheckInterval==0 &&
+              breaker &&
+              breaker->IsAborted()) {
+            return false;
+          }
+
           ValueCacheRef entryRef;
           if (cache.GetEntry(offset,entryRef)){
             data.push_back(entryRef->value);
@@ -20,6 +20,8 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <functional>
+#include <future>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -36,6 +38,7 @@
 #include <osmscout/BoundingBoxDataFile.h>
 #include <osmscout/NodeDataFile.h>
 #include <osmscout/WayDataFile.h>
+#include <osmscout/LODDataFile.h>
 
 #include <osmscout/OptimizeAreasLowZoom.h>
 #include <osmscout/OptimizeWaysLowZoom.h>
@@ -53,6 +56,7 @@
 
 #include <osmscout/routing/Route.h>
 
+#include <osmscout/util/Breaker.h>
 #include <osmscout/util/GeoBox.h>
 
 #include <osmscout/system/Compiler.h>
@@ -116,6 +120,38 @@ namespace osmscout {
     bool GetIndexMMap() const;
   };
 
+  /**
+    Parameter for Database::Warmup(), selecting the data files and indexes
+    that are opened in advance.
+
+    By default everything that is required for rendering is opened, the
+    location index is only opened on request.
+    */
+  class OSMSCOUT_API DatabaseWarmupParameter CLASS_FINAL
+  {
+  private:
+    bool dataFiles;
+    bool areaIndexes;
+    bool lowZoomOptimizations;
+    bool waterIndex;
+    bool locationIndex;
+
+  public:
+    DatabaseWarmupParameter();
+
+    void SetDataFiles(bool dataFiles);
+    void SetAreaIndexes(bool areaIndexes);
+    void SetLowZoomOptimizations(bool lowZoomOptimizations);
+    void SetWaterIndex(bool waterIndex);
+    void SetLocationIndex(bool locationIndex);
+
+    bool GetDataFiles() const;
+    bool GetAreaIndexes() const;
+    bool GetLowZoomOptimizations() const;
+    bool GetWaterIndex() const;
+    bool GetLocationIndex() const;
+  };
+
   class Database;
 
   class OSMSCOUT_API NodeRegionSearchResultEntry
@@ -308,6 +344,14 @@ namespace osmscout {
     mutable OptimizeWaysLowZoomRef  optimizeWaysLowZoom;      //!< Optimized data for low zoom situations
     mutable std::mutex              optimizeWaysMutex;        //!< Mutex to make lazy initialisation of optimized ways index thread-safe
 
+    mutable AreaLODDataFileRef      areaLODDataFile;          //!< Cached access to the optional 'areaslod.dat' file
+    mutable bool                    areaLODDataFileChecked;   //!< true, if we already tried to open the area LOD file
+    mutable std::mutex              areaLODDataFileMutex;     //!< Mutex to make lazy initialisation of area LOD file thread-safe
+
+    mutable WayLODDataFileRef       wayLODDataFile;           //!< Cached access to the optional 'wayslod.dat' file
+    mutable bool                    wayLODDataFileChecked;    //!< true, if we already tried to open the way LOD file
+    mutable std::mutex              wayLODDataFileMutex;      //!< Mutex to make lazy initialisation of way LOD file thread-safe
+
   public:
     explicit Database(const DatabaseParameter& parameter);
     virtual ~Database();
@@ -341,6 +385,11 @@ namespace osmscout {
     OptimizeAreasLowZoomRef GetOptimizeAreasLowZoom() const;
     OptimizeWaysLowZoomRef GetOptimizeWaysLowZoom() const;
 
+    AreaLODDataFileRef GetAreaLODDataFile() const;
+    WayLODDataFileRef GetWayLODDataFile() const;
+
+    std::future<bool> Warmup(const DatabaseWarmupParameter& warmupParameter=DatabaseWarmupParameter()) const;
+
     bool GetBoundingBox(GeoBox& boundingBox) const;
 
     bool GetNodeByOffset(const FileOffset& offset,
@@ -349,7 +398,8 @@ namespace osmscout {
                           std::vector<NodeRef>& nodes) const;
     bool GetNodesByOffset(const std::vector<FileOffset>& offsets,
                           const GeoBox& boundingBox,
-                          std::vector<NodeRef>& nodes) const;
+                          std::vector<NodeRef>& nodes,
+                          const BreakerRef& breaker=nullptr) const;
     bool GetNodesByOffset(const std::set<FileOffset>& offsets,
                           std::vector<NodeRef>& nodes) const;
     bool GetNodesByOffset(const std::list<FileOffset>& offsets,
@@ -370,13 +420,23 @@ namespace osmscout {
     bool GetAreasByBlockSpan(const DataBlockSpan& span,
                              std::vector<AreaRef>& area) const;
     bool GetAreasByBlockSpans(const std::vector<DataBlockSpan>& spans,
-                              std::vector<AreaRef>& areas) const;
+                              std::vector<AreaRef>& areas,
+                              const BreakerRef& breaker=nullptr) const;
+    bool GetAreasByBlockSpans(const std::vector<DataBlockSpan>& spans,
+                              const Magnification& magnification,
+                              std::vector<AreaRef>& areas,
+                              const BreakerRef& breaker=nullptr) const;
 
 
     bool GetWayByOffset(const FileOffset& offset,
                         WayRef& way) const;
     bool GetWaysByOffset(const std::vector<FileOffset>& offsets,
-                         std::vector<WayRef>& ways) const;
+                         std::vector<WayRef>& ways,
+                         const BreakerRef& breaker=nullptr) const;
+    bool GetWaysByOffset(const std::vector<FileOffset>& offsets,
+                         const Magnification& magnification,
+                         std::vector<WayRef>& ways,
+                         const BreakerRef& breaker=nullptr) const;
     bool GetWaysByOffset(const std::set<FileOffset>& offsets,
                          std::vector<WayRef>& ways) const;
     bool GetWaysByOffset(const std::list<FileOffset>& offsets,
@@ -0,0 +1,659 @@
+#ifndef OSMSCOUT_LODDATAFILE_H
+#define OSMSCOUT_LODDATAFILE_H
+
+/*
+  This source is part of the libosmscout library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <osmscout/Area.h>
+#include <osmscout/DataFile.h>
+#include <osmscout/Way.h>
+
+#include <osmscout/util/Magnification.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Database
+   *
+   * Access to the optional simplified geometries ("level of detail") of the
+   * objects of a data file.
+   *
+   * The file holds a number of levels, each for a certain magnification. For each
+   * level it holds simplified copies of all objects whose geometry can be reduced
+   * considerably at this magnification and a table, that maps the offset of each
+   * object of the data file to the offset of its simplified copy (or 0, if there is
+   * no copy). The table is split into pages of consecutive objects, only the offset
+   * of the first object of each page is held in memory.
+   *
+   * Simplified copies are returned with the file offset of the original object, so
+   * they can be used in place of the original objects.
+   */
+  template <class N>
+  class LODDataFile
+  {
+  public:
+    typedef std::shared_ptr<N> ValueType;
+    typedef Cache<FileOffset,std::shared_ptr<N>> ValueCache;
+
+    typedef typename Cache<FileOffset,ValueType>::CacheEntry ValueCacheEntry;
+    typedef typename Cache<FileOffset,ValueType>::CacheRef ValueCacheRef;
+
+  private:
+    struct Level
+    {
+      MagnificationLevel      magnification;     //!< Magnification the objects are simplified for
+      uint32_t                entryCount;        //!< Number of objects in the table
+      uint32_t                pageSize;          //!< Number of objects per page of the table
+      std::vector<FileOffset> pageObjectOffsets; //!< Data file offset of the first object of each page
+      std::vector<FileOffset> pageOffsets;       //!< Offset of each page in this file
+    };
+
+    struct Entry
+    {
+      FileOffset objectOffset; //!< Offset of the object in the data file
+      FileOffset lodOffset;    //!< Offset of the simplified copy or 0
+    };
+
+  private:
+    std::string         datafile;     //!< Basename part of the data file name
+    std::string         datafilename; //!< complete filename for data file
+
+    std::vector<Level>  levels;       //!< Levels, sorted by ascending magnification
+
+    mutable ValueCache  cache;        //!< Cache of simplified objects by their offset in this file
+
+    mutable FileScanner scanner;      //!< File stream to the data file
+
+    mutable std::mutex  accessMutex;  //!< Mutex to secure multi-thread access
+
+    TypeConfigRef       typeConfig;
+
+  private:
+    const Level* GetLevel(const Magnification& magnification) const;
+
+    void ReadPage(FileCursor& cursor,
+                  const Level& level,
+                  size_t page,
+                  std::vector<Entry>& entries) const;
+
+    template<typename IteratorIn>
+    void ResolveOffsets(const Level& level,
+                        IteratorIn begin, IteratorIn end,
+                        std::vector<FileOffset>& objectOffsets,
+                        std::vector<Entry>& lodEntries) const;
+
+    template<typename IteratorIn>
+    void ResolveBlockSpans(const Level& level,
+                           IteratorIn begin, IteratorIn end,
+                           std::vector<FileOffset>& objectOffsets,
+                           std::vector<Entry>& lodEntries) const;
+
+    bool ReadData(const std::vector<Entry>& lodEntries,
+                  std::vector<ValueType>& data,
+                  const BreakerRef& breaker) const;
+
+  public:
+    LODDataFile(const std::string& datafile, size_t cacheSize);
+
+    virtual ~LODDataFile();
+
+    bool Open(const TypeConfigRef& typeConfig,
+              const std::string& path,
+              bool memoryMappedData);
+    bool IsOpen() const;
+    bool Close();
+
+    inline std::string GetFilename() const
+    {
+      return datafilename;
+    }
+
+    bool HasLevel(const Magnification& magnification) const;
+    bool HasSameLevel(const Magnification& a,
+                      const Magnification& b) const;
+
+    template<typename IteratorIn>
+    bool GetByOffset(IteratorIn begin, IteratorIn end, size_t size,
+                     const Magnification& magnification,
+                     const DataFile<N>& dataFile,
+                     std::vector<ValueType>& data,
+                     const BreakerRef& breaker=nullptr) const;
+
+    template<typename IteratorIn>
+    bool GetByBlockSpans(IteratorIn begin, IteratorIn end,
+                         const Magnification& magnification,
+                         const DataFile<N>& dataFile,
+                         std::vector<ValueType>& data,
+                         const BreakerRef& breaker=nullptr) const;
+  };
+
+  template <class N>
+  LODDataFile<N>::LODDataFile(const std::string& datafile, size_t cacheSize)
+  : datafile(datafile),cache(cacheSize)
+  {
+    // no code
+  }
+
+  template <class N>
+  LODDataFile<N>::~LODDataFile()
+  {
+    if (IsOpen()) {
+      Close();
+    }
+  }
+
+  /**
+   * Open the file and read the page tables of all levels.
+   *
+   * Method is NOT thread-safe.
+   */
+  template <class N>
+  bool LODDataFile<N>::Open(const TypeConfigRef& typeConfig,
+                            const std::string& path,
+                            bool memoryMappedData)
+  {
+    this->typeConfig=typeConfig;
+
+    datafilename=AppendFileToDir(path,datafile);
+
+    try {
+      scanner.Open(datafilename,
+                   FileScanner::LowMemRandom,
+                   memoryMappedData);
+
+      FileOffset indexOffset;
+      uint32_t   levelCount;
+
+      scanner.ReadFileOffset(indexOffset);
+      scanner.SetPos(indexOffset);
+
+      scanner.ReadNumber(levelCount);
+
+      levels.resize(levelCount);
+
+      for (auto& level : levels) {
+        uint32_t magnification;
+        uint32_t pageCount;
+
+        scanner.ReadNumber(magnification);
+        scanner.ReadNumber(level.entryCount);
+        scanner.ReadNumber(level.pageSize);
+        scanner.ReadNumber(pageCount);
+
+        level.magnification=MagnificationLevel(magnification);
+        level.pageObjectOffsets.resize(pageCount);
+        level.pageOffsets.resize(pageCount);
+
+        for (size_t page=0; page<pageCount; page++) {
+          scanner.ReadFileOffset(level.pageObjectOffsets[page]);
+          scanner.ReadFileOffset(level.pageOffsets[page]);
+        }
+      }
+
+      std::sort(levels.begin(),levels.end(),[](const Level& a, const Level& b) {
+        return a.magnification<b.magnification;
+      });
+
+      return !scanner.HasError();
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      scanner.CloseFailsafe();
+      levels.clear();
+      return false;
+    }
+  }
+
+  /**
+   * Return true, if the file is currently opened.
+   *
+   * Method is NOT thread-safe.
+   */
+  template <class N>
+  bool LODDataFile<N>::IsOpen() const
+  {
+    return scanner.IsOpen();
+  }
+
+  /**
+   * Close the file.
+   *
+   * Method is NOT thread-safe.
+   */
+  template <class N>
+  bool LODDataFile<N>::Close()
+  {
+    typeConfig=nullptr;
+    levels.clear();
+
+    try  {
+      if (scanner.IsOpen()) {
+        scanner.Close();
+      }
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      scanner.CloseFailsafe();
+      return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * Returns the level to use for the given magnification, this is the level with the
+   * smallest magnification not smaller than the given one. Returns nullptr, if there
+   * is no such level and the objects should be used in full resolution.
+   */
+  template <class N>
+  const typename LODDataFile<N>::Level* LODDataFile<N>::GetLevel(const Magnification& magnification) const
+  {
+    for (const auto& level : levels) {
+      if (level.magnification.Get()>=magnification.GetLevel()) {
+        return &level;
+      }
+    }
+
+    return nullptr;
+  }
+
+  /**
+   * Returns true, if there are simplified objects for the given magnification
+   */
+  template <class N>
+  bool LODDataFile<N>::HasLevel(const Magnification& magnification) const
+  {
+    return GetLevel(magnification)!=nullptr;
+  }
+
+  /**
+   * Returns true, if objects are returned in the same level of detail for both
+   * magnifications.
+   */
+  template <class N>
+  bool LODDataFile<N>::HasSameLevel(const Magnification& a,
+                                    const Magnification& b) const
+  {
+    return GetLevel(a)==GetLevel(b);
+  }
+
+  /**
+   * Decodes the given page of the table of the given level.
+   *
+   * @throws IOException
+   */
+  template <class N>
+  void LODDataFile<N>::ReadPage(FileCursor& cursor,
+                                const Level& level,
+                                size_t page,
+                                std::vector<Entry>& entries) const
+  {
+    size_t     count=std::min((size_t)level.pageSize,
+                              (size_t)level.entryCount-page*level.pageSize);
+    FileOffset objectOffset=level.pageObjectOffsets[page];
+    FileOffset lodOffset=0;
+
+    entries.resize(count);
+
+    cursor.SetPos(level.pageOffsets[page]);
+
+    for (auto& entry : entries) {
+      FileOffset objectDelta;
+      FileOffset lodDelta;
+
+      cursor.ReadNumber(objectDelta);
+      cursor.ReadNumber(lodDelta);
+
+      objectOffset+=objectDelta;
+      entry.objectOffset=objectOffset;
+
+      if (lodDelta!=0) {
+        lodOffset+=lodDelta;
+        entry.lodOffset=lodOffset;
+      }
+      else {
+        entry.lodOffset=0;
+      }
+    }
+  }
+
+  /**
+   * Splits the given data file offsets into the offsets of objects without simplified
+   * copy and the entries of the objects with simplified copy.
+   *
+   * @throws IOException
+   */
+  template <class N>
+  template<typename IteratorIn>
+  void LODDataFile<N>::ResolveOffsets(const Level& level,
+                                      IteratorIn begin, IteratorIn end,
+                                      std::vector<FileOffset>& objectOffsets,
+                                      std::vector<Entry>& lodEntries) const
+  {
+    FileCursor         cursor(scanner);
+    std::vector<Entry> entries;
+    size_t             currentPage=level.pageObjectOffsets.size();
+
+    for (IteratorIn offsetIter=begin; offsetIter!=end; ++offsetIter) {
+      FileOffset offset=*offsetIter;
+      auto       pageIter=std::upper_bound(level.pageObjectOffsets.begin(),
+                                           level.pageObjectOffsets.end(),
+                                           offset);
+
+      if (pageIter==level.pageObjectOffsets.begin()) {
+        objectOffsets.push_back(offset);
+        continue;
+      }
+
+      size_t page=pageIter-level.pageObjectOffsets.begin()-1;
+
+      if (page!=currentPage) {
+        ReadPage(cursor,level,page,entries);
+        currentPage=page;
+      }
+
+      auto entry=std::lower_bound(entries.begin(),
+                                  entries.end(),
+                                  offset,
+                                  [](const Entry& entry, FileOffset offset) {
+        return entry.objectOffset<offset;
+      });
+
+      if (entry!=entries.end() &&
+          entry->objectOffset==offset &&
+          entry->lodOffset!=0) {
+        lodEntries.push_back(*entry);
+      }
+      else {
+        objectOffsets.push_back(offset);
+      }
+    }
+  }
+
+  /**
+   * Splits the objects of the given spans into the offsets of objects without
+   * simplified copy and the entries of the objects with simplified copy. Since
+   * the table holds all objects of the data file, the objects of a span are
+   * the consecutive table entries starting at the start offset of the span.
+   *
+   * @throws IOException
+   */
+  template <class N>
+  template<typename IteratorIn>
+  void LODDataFile<N>::ResolveBlockSpans(const Level& level,
+                                         IteratorIn begin, IteratorIn end,
+                                         std::vector<FileOffset>& objectOffsets,
+                                         std::vector<Entry>& lodEntries) const
+  {
+    FileCursor         cursor(scanner);
+    std::vector<Entry> entries;
+    size_t             currentPage=level.pageObjectOffsets.size();
+
+    for (IteratorIn spanIter=begin; spanIter!=end; ++spanIter) {
+      if (spanIter->count==0) {
+        continue;
+      }
+
+      auto pageIter=std::upper_bound(level.pageObjectOffsets.begin(),
+                                     level.pageObjectOffsets.end(),
+                                     spanIter->startOffset);
+
+      if (pageIter==level.pageObjectOffsets.begin()) {
+        throw IOException(datafilename,"Cannot resolve span","Unknown object offset "+std::to_string(spanIter->startOffset));
+      }
+
+      size_t page=pageIter-level.pageObjectOffsets.begin()-1;
+
+      if (page!=currentPage) {
+        ReadPage(cursor,level,page,entries);
+        currentPage=page;
+      }
+
+      auto entry=std::lower_bound(entries.begin(),
+                                  entries.end(),
+                                  spanIter->startOffset,
+                                  [](const Entry& entry, FileOffset offset) {
+        return entry.objectOffset<offset;
+      });
+
+      if (entry==entries.end() ||
+          entry->objectOffset!=spanIter->startOffset) {
+        throw IOException(datafilename,"Cannot resolve span","Unknown object offset "+std::to_string(spanIter->startOffset));
+      }
+
+      size_t index=entry-entries.begin();
+
+      for (uint32_t i=0; i<spanIter->count; i++) {
+        if (index>=entries.size()) {
+          if (currentPage+1>=level.pageObjectOffsets.size()) {
+            throw IOException(datafilename,"Cannot resolve span","Span exceeds data file");
+          }
+
+          currentPage++;
+          ReadPage(cursor,level,currentPage,entries);
+          index=0;
+        }
+
+        if (entries[index].lodOffset!=0) {
+          lodEntries.push_back(entries[index]);
+        }
+        else {
+          objectOffsets.push_back(entries[index].objectOffset);
+        }
+
+        index++;
+      }
+    }
+  }
+
+  /**
+   * Reads the simplified copies of the given entries
+   *
+   * Method is thread-safe.
+   */
+  template <class N>
+  bool LODDataFile<N>::ReadData(const std::vector<Entry>& lodEntries,
+                                std::vector<ValueType>& data,
+                                const BreakerRef& breaker) const
+  {
+    if (lodEntries.empty()) {
+      return true;
+    }
+
+    data.reserve(data.size()+lodEntries.size());
+
+    std::lock_guard<std::mutex> lock(accessMutex);
+    ArenaScope                  arenaScope(lodEntries.size()>=32 ? std::make_shared<Arena>() : nullptr);
+    FileOffset                  streamOffset=0;
+    size_t                      readCount=0;
+
+    try {
+      for (const auto& entry : lodEntries) {
+        if (readCount++%256==0 &&
+            breaker &&
+            breaker->IsAborted()) {
+          return false;
+        }
+
+        ValueCacheRef entryRef;
+
+        if (cache.GetEntry(entry.lodOffset,entryRef)) {
+          data.push_back(entryRef->value);
+          continue;
+        }
+
+        ValueType value=std::make_shared<N>();
+
+        if (entry.lodOffset!=streamOffset) {
+          scanner.SetPos(entry.lodOffset);
+        }
+
+        value->Read(*typeConfig,
+                    scanner);
+        value->SetFileOffset(entry.objectOffset);
+
+        streamOffset=scanner.GetPos();
+
+        cache.SetEntry(ValueCacheEntry(entry.lodOffset,value));
+        data.push_back(value);
+      }
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * Reads the objects with the given data file offsets. Objects are returned in the
+   * level of detail for the given magnification, objects without simplified copy
+   * (or all objects, if there is no level for the magnification) are read from the
+   * given data file.
+   *
+   * The order of the returned objects is not defined.
+   *
+   * Method is thread-safe.
+   */
+  template <class N>
+  template<typename IteratorIn>
+  bool LODDataFile<N>::GetByOffset(IteratorIn begin, IteratorIn end, size_t size,
+                                   const Magnification& magnification,
+                                   const DataFile<N>& dataFile,
+                                   std::vector<ValueType>& data,
+                                   const BreakerRef& breaker) const
+  {
+    const Level* level=GetLevel(magnification);
+
+    if (level==nullptr) {
+      return dataFile.GetByOffset(begin,end,size,data,breaker);
+    }
+
+    std::vector<FileOffset> objectOffsets;
+    std::vector<Entry>      lodEntries;
+
+    objectOffsets.reserve(size);
+
+    try {
+      ResolveOffsets(*level,
+                     begin,end,
+                     objectOffsets,
+                     lodEntries);
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      return false;
+    }
+
+    return dataFile.GetByOffset(objectOffsets.begin(),
+                                objectOffsets.end(),
+                                objectOffsets.size(),
+                                data,
+                                breaker) &&
+           ReadData(lodEntries,
+                    data,
+                    breaker);
+  }
+
+  /**
+   * Reads the objects in the given spans of the data file. Objects are returned in the
+   * level of detail for the given magnification, objects without simplified copy
+   * (or all objects, if there is no level for the magnification) are read from the
+   * given data file.
+   *
+   * The order of the returned objects is not defined.
+   *
+   * Method is thread-safe.
+   */
+  template <class N>
+  template<typename IteratorIn>
+  bool LODDataFile<N>::GetByBlockSpans(IteratorIn begin, IteratorIn end,
+                                       const Magnification& magnification,
+                                       const DataFile<N>& dataFile,
+                                       std::vector<ValueType>& data,
+                                       const BreakerRef& breaker) const
+  {
+    const Level* level=GetLevel(magnification);
+
+    if (level==nullptr) {
+      return dataFile.GetByBlockSpans(begin,end,data,breaker);
+    }
+
+    std::vector<FileOffset> objectOffsets;
+    std::vector<Entry>      lodEntries;
+
+    try {
+      ResolveBlockSpans(*level,
+                        begin,end,
+                        objectOffsets,
+                        lodEntries);
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      return false;
+    }
+
+    return dataFile.GetByOffset(objectOffsets.begin(),
+                                objectOffsets.end(),
+                                objectOffsets.size(),
+                                data,
+                                breaker) &&
+           ReadData(lodEntries,
+                    data,
+                    breaker);
+  }
+
+  /**
+    \ingroup Database
+    Abstraction for getting cached access to the 'wayslod.dat' file.
+    */
+  class OSMSCOUT_API WayLODDataFile : public LODDataFile<Way>
+  {
+  public:
+    static const char* const WAYSLOD_DAT;
+
+  public:
+    explicit WayLODDataFile(size_t cacheSize);
+  };
+
+  typedef std::shared_ptr<WayLODDataFile> WayLODDataFileRef;
+
+  /**
+    \ingroup Database
+    Abstraction for getting cached access to the 'areaslod.dat' file.
+    */
+  class OSMSCOUT_API AreaLODDataFile : public LODDataFile<Area>
+  {
+  public:
+    static const char* const AREASLOD_DAT;
+
+  public:
+    explicit AreaLODDataFile(size_t cacheSize);
+  };
+
+  typedef std::shared_ptr<AreaLODDataFile> AreaLODDataFileRef;
+}
+
+#endif
@@ -74,13 +74,14 @@ namespace osmscout {
     double                                     magnification; //!< Magnification, up to which we support optimization
     std::map<TypeInfoRef,std::list<TypeData> > wayTypesData;  //!< Index information for all way types
 
-    mutable std::mutex                         lookupMutex;
+    mutable std::mutex                         lookupMutex;   //!< Guards the scanner while loading ways, index lookups use a FileCursor
 
   private:
     void ReadTypeData(FileScanner& scanner,
                       TypeData& data);
 
-    void GetOffsets(const TypeData& typeData,
+    void GetOffsets(FileCursor& cursor,
+                    const TypeData& typeData,
                     const GeoBox& boundingBox,
                     std::set<FileOffset>& offsets) const;
 
@@ -58,6 +58,18 @@ namespace osmscout {
     virtual ~TagCondition();
 
     virtual bool Evaluate(const TagMap& tagMap) const = 0;
+
+    /**
+     * Collects tags, of which at least one must be set for the condition to
+     * evaluate to true. This allows to skip conditions that cannot match
+     * without evaluating them.
+     *
+     * @param tags
+     *    Tags are appended
+     * @return
+     *    false, if the condition may match without any specific tag
+     */
+    virtual bool GetTriggerTags(std::vector<TagId>& tags) const;
   };
 
   /**
@@ -110,6 +122,7 @@ namespace osmscout {
     void AddCondition(const TagConditionRef& condition);
 
     bool Evaluate(const TagMap& tagMap) const override;
+    bool GetTriggerTags(std::vector<TagId>& tags) const override;
   };
 
   /**
@@ -136,6 +149,8 @@ namespace osmscout {
     {
       return tagMap.find(tag)!=tagMap.end();
     }
+
+    bool GetTriggerTags(std::vector<TagId>& tags) const override;
   };
 
   /**
@@ -168,6 +183,7 @@ namespace osmscout {
                        const size_t& tagValue);
 
     bool Evaluate(const TagMap& tagMap) const override;
+    bool GetTriggerTags(std::vector<TagId>& tags) const override;
   };
 
   /**
@@ -188,6 +204,7 @@ namespace osmscout {
     void AddTagValue(const std::string& tagValue);
 
     bool Evaluate(const TagMap& tagMap) const override;
+    bool GetTriggerTags(std::vector<TagId>& tags) const override;
   };
 
   /**
@@ -212,7 +229,7 @@ namespace osmscout {
     TagInfo(TagId id,
             const std::string& name);
 
-    inline std::string GetName() const
+    inline const std::string& GetName() const
     {
       return name;
     }
@@ -242,6 +259,15 @@ namespace osmscout {
 
     std::unordered_map<std::string,size_t>      surfaceToGradeMap;
 
+    // Perfect hash over all tag names (see CompileLookupTable())
+
+    std::vector<uint32_t>                       hashSeeds;     //!< Displacement seed for each bucket
+    std::vector<TagId>                          hashSlots;     //!< Tag id for each slot, tagIgnore for empty slots
+
+  private:
+    TagId LookupTagId(const char* name,
+                      size_t length) const;
+
   public:
     TagRegistry();
     ~TagRegistry();
@@ -256,6 +282,13 @@ namespace osmscout {
     TagId GetTagId(const char* name) const;
     TagId GetTagId(const std::string& name) const;
 
+    /**
+     * Builds a perfect hash table over all currently registered tag names.
+     * Registering a new tag drops the table again, until this method
+     * is called again.
+     */
+    void CompileLookupTable();
+
     bool IsNameTag(TagId tag,
                    uint32_t& priority) const;
     bool IsNameAltTag(TagId tag,
@@ -34,6 +34,7 @@
 #include <osmscout/Tag.h>
 #include <osmscout/TypeFeature.h>
 
+#include <osmscout/util/Arena.h>
 #include <osmscout/util/FileScanner.h>
 #include <osmscout/util/FileWriter.h>
 #include <osmscout/util/TagErrorReporter.h>
@@ -655,6 +656,10 @@ namespace osmscout {
   /**
    * A FeatureValueBuffer is instantiated by an object and holds information
    * about the type of the object, the features and feature values available for the given object.
+   *
+   * If an arena is active for the current thread (see ArenaScope) while the type is assigned,
+   * the feature bits are allocated from it instead of the heap. The value buffer is allocated
+   * lazily, it is taken from the same arena only while its scope is still active, else from the heap.
    */
   class OSMSCOUT_API FeatureValueBuffer CLASS_FINAL
   {
@@ -662,6 +667,8 @@ namespace osmscout {
     TypeInfoRef type;
     uint8_t     *featureBits;
     char        *featureValueBuffer;
+    ArenaRef    arena;               //!< Arena the feature bits are allocated from (see ArenaScope), or nullptr for the heap
+    bool        valuesInArena;       //!< The value buffer is allocated from the arena, too
 
   private:
     void DeleteData();
@@ -808,7 +815,7 @@ namespace osmscout {
   // Forward declaration
   class TypeConfig;
 
-  static const uint32_t FILE_FORMAT_VERSION=19;
+  static const uint32_t FILE_FORMAT_VERSION=20;
 
   /**
    * \ingroup type
@@ -841,6 +848,37 @@ namespace osmscout {
 
     std::unordered_map<std::string,TypeInfoRef> nameToTypeMap;
 
+    /**
+     * Type conditions for one kind of object, indexed by their trigger tags
+     * (see TagCondition::GetTriggerTags()), so that only conditions that
+     * can match the tags of an object are evaluated.
+     */
+    struct ConditionDispatch
+    {
+      struct Entry
+      {
+        TypeInfoRef     type;      //!< The type the condition belongs to
+        unsigned char   types;     //!< Bitset of types the condition can be applied to
+        TagConditionRef condition; //!< The root condition
+      };
+
+      std::vector<Entry>                 entries;         //!< All conditions in evaluation order
+      std::vector<std::vector<uint32_t>> tagEntries;      //!< Indexes of the entries triggered by a tag, by tag id
+      std::vector<uint32_t>              untaggedEntries; //!< Indexes of the entries that must always be evaluated
+
+      void Clear();
+      void Add(const TypeInfoRef& type,
+               const TypeInfo::TypeCondition& condition);
+      void GetCandidates(const TagMap& tagMap,
+                         std::vector<uint32_t>& candidates) const;
+    };
+
+    bool                                        conditionsCompiled; //!< true, if the condition dispatch tables are up to date
+    ConditionDispatch                           nodeConditions;
+    ConditionDispatch                           wayAreaConditions;
+    ConditionDispatch                           multipolygonConditions;
+    ConditionDispatch                           relationConditions;
+
     // Features
 
     std::vector<FeatureRef>                     features;
@@ -1095,6 +1133,15 @@ namespace osmscout {
      * type.
      */
     TypeInfoRef GetRelationType(const TagMap& tagMap) const;
+
+    /**
+     * Builds lookup tables for tag names (a perfect hash) and for type conditions
+     * (indexed by the tags they depend on). They speed up tag lookup and type
+     * detection during preprocessing and are built automatically after loading
+     * an OST file. Registering further tags or types drops the tables again,
+     * until this method is called again.
+     */
+    void CompileLookupTables();
     //@}
 
     /**
@@ -29,6 +29,7 @@
 #include <osmscout/GroundTile.h>
 #include <osmscout/OSMScoutTypes.h>
 
+#include <osmscout/util/Cache.h>
 #include <osmscout/util/FileScanner.h>
 #include <osmscout/util/Magnification.h>
 
@@ -65,17 +66,48 @@ namespace osmscout {
       uint32_t                   cellYEnd;         //!< Last x-axis coordinate cells
     };
 
+    /**
+     * Decoded ground tiles of a coast cell. The coordinates of the tiles are
+     * relative to the cell, the position of the tiles is not set. Templates are
+     * shared and never changed after decoding, so cache hits do not copy them.
+     */
+    typedef std::shared_ptr<const std::vector<GroundTile>> CellTemplateRef;
+
+    typedef Cache<FileOffset,CellTemplateRef> CellTemplateCache;
+
+    struct CellTemplateCacheValueSizer : public CellTemplateCache::ValueSizer
+    {
+      size_t GetSize(const CellTemplateRef& value) const override
+      {
+        size_t memory=sizeof(value)+sizeof(*value);
+
+        for (const auto& tile : *value) {
+          memory+=sizeof(tile);
+          memory+=tile.coords.capacity()*sizeof(GroundTile::Coord);
+        }
+
+        return memory;
+      }
+    };
+
   private:
+    static const size_t        cellTemplateCacheSize=1000;
+
     std::string                datafilename;   //!< Full path and name of the data file
-    mutable FileScanner        scanner;        //!< Scanner instance for reading this file
+    FileScanner                scanner;        //!< Scanner instance for reading this file
 
     uint32_t                   waterIndexMinMag;
     uint32_t                   waterIndexMaxMag;
     std::vector<Level>         levels;
 
-    mutable std::mutex         lookupMutex;
+    mutable CellTemplateCache  cellTemplateCache;      //!< Decoded coast cells by file offset of the cell data
+    mutable std::mutex         cellTemplateCacheMutex;
 
   private:
+    void ReadCellTemplate(FileCursor& cursor,
+                          FileOffset offset,
+                          std::vector<GroundTile>& cellTiles) const;
+
     void GetGroundTileByDefault(const Level& level,
                                 uint32_t cx1,
                                 uint32_t cx2,
@@ -74,6 +74,15 @@ namespace osmscout {
       return nextFileOffset;
     }
 
+    /**
+     * Sets the file offset of the object. Used for simplified copies of an object,
+     * that stand in for the object at the given offset of the data file.
+     */
+    inline void SetFileOffset(FileOffset fileOffset)
+    {
+      this->fileOffset=fileOffset;
+    }
+
     inline ObjectFileRef GetObjectFileRef() const
     {
       return {fileOffset,refWay};
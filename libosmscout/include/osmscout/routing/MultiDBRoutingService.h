@@ -21,6 +21,7 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <osmscout/CoverageDirectory.h>
 #include <osmscout/Pixel.h>
 #include <osmscout/routing/AbstractRoutingService.h>
 #include <osmscout/routing/SimpleRoutingService.h>
@@ -57,6 +58,7 @@ namespace osmscout {
 
   private:
     std::vector<DatabaseHandle> handles;
+    CoverageDirectory           coverageDirectory; //!< Databases by covered region
     bool                        isOpen;
 
   private:
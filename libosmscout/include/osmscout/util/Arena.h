@@ -0,0 +1,123 @@
+#ifndef OSMSCOUT_UTIL_ARENA_H
+#define OSMSCOUT_UTIL_ARENA_H
+
+/*
+  This source is part of the libosmscout library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/CoreFeatures.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <osmscout/CoreImportExport.h>
+
+#include <osmscout/system/Compiler.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Util
+   *
+   * Simple bump allocator. Memory is taken from big blocks and is never
+   * returned individually. All blocks are freed at once, when the arena
+   * is destroyed.
+   *
+   * The arena itself is not thread-safe. It is expected that one arena
+   * is filled by one thread (see ArenaScope), while objects allocated from
+   * it may be used by any thread afterwards.
+   */
+  class OSMSCOUT_API Arena CLASS_FINAL
+  {
+  private:
+    size_t             blockSize;        //!< Size of one memory block
+    std::vector<char*> blocks;           //!< All allocated memory blocks
+    char*              current;          //!< Next free byte in the current block
+    size_t             remaining;        //!< Free bytes in the current block
+    size_t             allocationCount;  //!< Number of allocations served
+    size_t             allocatedBytes;   //!< Number of bytes served
+
+  public:
+    static const size_t DefaultBlockSize=64*1024;
+
+  public:
+    explicit Arena(size_t blockSize=DefaultBlockSize);
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * Return memory for the given size and alignment. The memory is
+     * uninitialized and stays valid for the lifetime of the arena.
+     */
+    void* Allocate(size_t size,
+                   size_t alignment=alignof(std::max_align_t));
+
+    inline size_t GetAllocationCount() const
+    {
+      return allocationCount;
+    }
+
+    inline size_t GetAllocatedBytes() const
+    {
+      return allocatedBytes;
+    }
+
+    inline size_t GetBlockCount() const
+    {
+      return blocks.size();
+    }
+  };
+
+  typedef std::shared_ptr<Arena> ArenaRef;
+
+  /**
+   * \ingroup Util
+   *
+   * Makes the given arena the current arena of the calling thread for the
+   * lifetime of the scope object. The previous arena is restored on
+   * destruction, so scopes can be nested. Passing nullptr disables the
+   * arena inside the scope.
+   *
+   * Classes supporting arenas (like FeatureValueBuffer) take their memory
+   * from the current arena and keep a reference to it, so the arena
+   * is released after the last object using it is gone. Allocations made
+   * after the scope has ended must use the heap, since the arena is not
+   * thread-safe.
+   */
+  class OSMSCOUT_API ArenaScope CLASS_FINAL
+  {
+  private:
+    ArenaRef previous;
+
+  public:
+    explicit ArenaScope(const ArenaRef& arena);
+    ~ArenaScope();
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+    /**
+     * Return the current arena of the calling thread, or nullptr
+     */
+    static const ArenaRef& GetCurrentArena();
+  };
+}
+
+#endif
@@ -272,6 +272,7 @@ namespace osmscout {
       order.clear();
       map.clear();
       size=0;
+      previousEntry=order.end();
     }
 
     /**
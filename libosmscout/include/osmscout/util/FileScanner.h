@@ -21,6 +21,7 @@
 */
 
 #include <cstdio>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -56,6 +57,10 @@ namespace osmscout {
     mapping the complete file into the memory of the process (without
     allocating real memory) resulting in measurable speed increase because of
     exchanging buffered file access with in memory array access.
+
+    Beside the sequential reading cursor FileScanner offers positional
+    reads (see ReadAt() and FileCursor) that do not touch the cursor and
+    thus can be used by multiple threads concurrently.
     */
   class OSMSCOUT_API FileScanner CLASS_FINAL
   {
@@ -87,6 +92,10 @@ namespace osmscout {
     HANDLE       mmfHandle;
 #endif
 
+    mutable std::mutex   positionalMutex; //!< Serializes positional reads if pread() is not available
+
+    friend class FileCursor;
+
   private:
     void AssureByteBufferSize(size_t size);
     void FreeBuffer();
@@ -208,6 +217,15 @@ namespace osmscout {
     void SetPos(FileOffset pos);
     FileOffset GetPos() const;
 
+    inline FileOffset GetSize() const
+    {
+      return size;
+    }
+
+    void ReadAt(FileOffset pos,
+                char* buffer,
+                size_t bytes) const;
+
     void Read(char* buffer, size_t bytes);
 
     void Read(std::string& value);
@@ -267,6 +285,84 @@ namespace osmscout {
     std::vector<ObjectFileRef> ReadObjectFileRefs(size_t count);
   };
 
+  /**
+    \ingroup File
+
+    FileCursor reads from an opened FileScanner starting at an arbitrary
+    position without changing the position of the scanner itself. If the
+    file is memory mapped, data is accessed in place, else blocks of the
+    file are read using positional IO (pread()) into a buffer of the cursor.
+
+    Any number of cursors (one per thread) may read from the same scanner at the
+    same time, as long as the scanner is not used for sequential reading or closed
+    meanwhile. Errors are reported by throwing an IOException, the error state
+    of the scanner is not changed.
+    */
+  class OSMSCOUT_API FileCursor CLASS_FINAL
+  {
+  private:
+    static const size_t blockSize=4096;
+
+    const FileScanner& scanner;
+    FileOffset         pos;       //!< Current reading position
+    const char*        data;      //!< Currently accessible part of the file
+    FileOffset         dataStart; //!< File offset of the first byte in data
+    size_t             dataSize;  //!< Number of bytes in data
+    std::vector<char>  buffer;    //!< Buffer for data, if the file is not memory mapped
+
+  private:
+    void Fill(size_t bytes);
+
+    /**
+     * Returns a pointer to the next bytes of the file and moves
+     * the cursor behind them.
+     */
+    inline const char* Fetch(size_t bytes)
+    {
+      if (pos<dataStart ||
+          pos+bytes>dataStart+dataSize) {
+        Fill(bytes);
+      }
+
+      const char* result=data+(pos-dataStart);
+
+      pos+=bytes;
+
+      return result;
+    }
+
+  public:
+    explicit FileCursor(const FileScanner& scanner,
+                        FileOffset pos=0);
+
+    FileCursor(const FileCursor& other) = delete;
+    FileCursor& operator=(const FileCursor& other) = delete;
+
+    inline void SetPos(FileOffset pos)
+    {
+      this->pos=pos;
+    }
+
+    inline FileOffset GetPos() const
+    {
+      return pos;
+    }
+
+    void Read(uint8_t& number);
+    void Read(uint16_t& number);
+
+    void ReadFileOffset(FileOffset& offset,
+                        size_t bytes);
+
+    void ReadNumber(uint32_t& number);
+    void ReadNumber(uint64_t& number);
+
+    void ReadCoord(GeoCoord& coord);
+
+    void ReadTypeId(TypeId& id,
+                    uint8_t maxBytes);
+  };
+
   /**
    * Read back a stream of sorted ObjectFileRefs as written by the ObjectFileRefStreamWriter.
    */
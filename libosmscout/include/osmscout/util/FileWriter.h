@@ -21,6 +21,7 @@
 */
 
 #include <cstdio>
+#include <future>
 #include <string>
 #include <vector>
 
@@ -43,6 +44,12 @@ namespace osmscout {
     FileScanner implements platform independent writing to data in files.
     It uses C standard library FILE internally and wraps it to offer
     a number of convenience methods.
+
+    Optionally the writer can be opened with a write-behind buffer. Data is
+    then collected in a large user space buffer and full buffers are written
+    by a background task, while the caller continues encoding into a second
+    buffer. Seeking back (for example for patching offsets) is still supported;
+    positions within the current buffer are patched in memory.
     */
   class OSMSCOUT_API FileWriter CLASS_FINAL
   {
@@ -53,14 +60,32 @@ namespace osmscout {
     std::vector<int32_t> deltaBuffer; //!< Temporary storage for deltas for storing of std::vector<GeoCoord>
     std::vector<uint8_t> byteBuffer;  //!< Temporary data buffer for storing of std::vector<GeoCoord>
 
+    size_t               writeBehindSize;   //!< Size of the write-behind buffers, 0 if write-behind is disabled
+    std::vector<char>    writeBehindBuffer; //!< Write-behind buffer filled by the caller
+    std::vector<char>    writeBuffer;       //!< Write-behind buffer written by the background task
+    std::future<bool>    pendingWrite;      //!< Background task writing writeBuffer
+    FileOffset           bufferOffset;      //!< File offset of the first byte in writeBehindBuffer
+    size_t               bufferPos;         //!< Current write position in writeBehindBuffer
+
+  private:
+    size_t WriteData(const void* data,
+                     size_t size,
+                     size_t count);
+    bool WriteBuffer(FileOffset offset);
+    bool StartBufferWrite();
+    bool WaitForBufferWrite();
+    bool FlushBuffer();
+
   public:
     static const uint64_t MAX_NODES;
+    static const size_t   DEFAULT_WRITE_BEHIND_SIZE;
 
   public:
     FileWriter();
     virtual ~FileWriter();
 
-    void Open(const std::string& filename);
+    void Open(const std::string& filename,
+              size_t writeBehindSize=0);
     void Close();
     void CloseFailsafe();
     inline bool IsOpen() const
@@ -22,11 +22,10 @@
 
 #include <osmscout/CoreImportExport.h>
 
-#include <bitset>
-#include <unordered_map>
-
 #include <osmscout/OSMScoutTypes.h>
 
+#include <osmscout/util/NumberSet.h>
+
 #include <osmscout/system/Compiler.h>
 
 namespace osmscout {
@@ -37,26 +36,15 @@ namespace osmscout {
    * id used at least twice. In concrete it is used, to
    * check if a node id is shared by multiple ways/areas.
    *
-   * It is expected that ids are not sparse but continuously
-   * used. So while the data structure works for Id, it will
-   * likely not work for OSMId.
-   *
-   * It internally used large bitsets in a hashset to allow
-   * efficient memory usage (only a few entries in hashtable
-   * to reduce management overhead but no need for large
-   * continuous memory areas) and at the same time fast access
-   * (O(1)) for reading and writing.
+   * Ids used at least once and ids used at least twice are held
+   * in two NumberSet instances, so memory usage is bound by the number
+   * of used ids and sparse ids are handled efficiently, too.
    */
   class OSMSCOUT_API NodeUseMap CLASS_FINAL
   {
   private:
-    typedef std::bitset<4096>                 Bitset;
-    typedef std::unordered_map<size_t,Bitset> Map;
-
-  private:
-    Map                                       nodeUseMap;
-    size_t                                    nodeCount;
-    size_t                                    duplicateCount;
+    NumberSet                                 usedOnce;
+    NumberSet                                 usedTwice;
 
   public:
     NodeUseMap();
@@ -22,11 +22,14 @@
 
 #include <osmscout/CoreImportExport.h>
 
-#include <bitset>
-#include <unordered_map>
+#include <cstdint>
+#include <vector>
 
 #include <osmscout/OSMScoutTypes.h>
 
+#include <osmscout/util/FileScanner.h>
+#include <osmscout/util/FileWriter.h>
+
 #include <osmscout/system/Compiler.h>
 
 namespace osmscout {
@@ -34,25 +37,88 @@ namespace osmscout {
   /**
    * \ingroup Util
    *
+   * Set of (possibly very sparse) ids, modeled after roaring bitmaps.
+   *
+   * Ids are split into chunks of 65536 ids by their upper bits. Chunks are
+   * held in a directory sorted by chunk id, so there is no hashing and no
+   * per-bucket overhead. The directory is split into pages of at most
+   * maxPageChunks chunks, so inserting a chunk in the middle only moves the
+   * chunks of one page. Each chunk stores the lower 16 bits of its ids
+   * either as sorted array (sparse chunks, 2 bytes per id) or as bitmap
+   * (dense chunks, fixed 8 KiB). A chunk switches from array to bitmap
+   * as soon as the bitmap gets smaller than the array.
+   *
+   * Inserting ids in ascending order (as typical during import) is fast,
+   * since the last used chunk is remembered and new chunks are appended
+   * to the last page.
    */
   class OSMSCOUT_API NumberSet CLASS_FINAL
   {
   private:
-    typedef std::bitset<4096>                 Bitset;
-    typedef std::unordered_map<size_t,Bitset> Map;
+    static const size_t   chunkBits=16;
+    static const size_t   bitmapWords=(1u << chunkBits)/64;
+    static const size_t   maxArraySize=4096; //!< From this size on a bitmap needs less memory than the array
+    static const size_t   maxPageChunks=64;  //!< Maximum number of chunks in a directory page
+
+    struct Chunk
+    {
+      uint64_t              id;      //!< Upper bits of all ids in the chunk
+      uint32_t              count;   //!< Number of ids in the chunk
+      std::vector<uint16_t> array;   //!< Sorted lower bits, if the chunk is sparse
+      std::vector<uint64_t> bitmap;  //!< Bitmap of the lower bits, if the chunk is dense
+
+      inline bool IsBitmap() const
+      {
+        return !bitmap.empty();
+      }
+
+      bool Set(uint16_t value);
+      bool IsSet(uint16_t value) const;
+    };
+
+    typedef std::vector<Chunk> Page;
 
   private:
-    Map                                       map;
+    std::vector<Page>                         pages;     //!< Pages of chunks, sorted by chunk id
+    size_t                                    lastPage;  //!< Index of the page of the last chunk used for insert
+    size_t                                    lastChunk; //!< Index of the last chunk used for insert within its page
     size_t                                    count;
 
-    public:
+  private:
+    size_t FindPage(uint64_t chunkId) const;
+    Chunk* FindChunk(uint64_t chunkId);
+    const Chunk* FindChunk(uint64_t chunkId) const;
+
+  public:
     NumberSet();
 
-    void Set(Id id);
+    /**
+     * Insert the given id. Returns true, if the id was not set before.
+     */
+    bool Set(Id id);
     bool IsSet(Id id) const;
     size_t GetNodeUsedCount() const;
 
+    /**
+     * Insert all ids of the given range. Ids should be sorted for best performance.
+     */
+    template<typename IteratorIn>
+    void Set(IteratorIn begin, IteratorIn end)
+    {
+      for (IteratorIn id=begin; id!=end; ++id) {
+        Set(*id);
+      }
+    }
+
+    /**
+     * Return the number of bytes used by the chunk containers
+     */
+    size_t GetMemoryUsage() const;
+
     void Clear();
+
+    void Write(FileWriter& writer) const;
+    void Read(FileScanner& scanner);
   };
 
 }
@@ -21,6 +21,7 @@
 */
 
 #include <ctime>
+#include <mutex>
 #include <string>
 
 #include <osmscout/CoreFeatures.h>
@@ -79,6 +80,33 @@ namespace osmscout {
     void Warning(const std::string& text) override;
     void Error(const std::string& text) override;
   };
+
+  /**
+   * Forwards all calls to the given progress while holding a lock, so that
+   * multiple threads can report to the same progress. Debug output is enabled
+   * if it was enabled for the given progress on construction.
+   */
+  class OSMSCOUT_API SynchronizedProgress : public Progress
+  {
+  private:
+    std::mutex mutex;
+    Progress&  progress;
+
+  public:
+    explicit SynchronizedProgress(Progress& progress);
+
+    void SetStep(const std::string& step) override;
+    void SetAction(const std::string& action) override;
+    void SetProgress(double current, double total) override;
+    void SetProgress(unsigned int current, unsigned int total) override;
+    void SetProgress(unsigned long current, unsigned long total) override;
+    void SetProgress(unsigned long long current, unsigned long long total) override;
+
+    void Debug(const std::string& text) override;
+    void Info(const std::string& text) override;
+    void Warning(const std::string& text) override;
+    void Error(const std::string& text) override;
+  };
 }
 
 #endif
@@ -32,10 +32,12 @@
 namespace osmscout {
 
   const char* const AreaAreaIndex::AREA_AREA_IDX="areaarea.idx";
+  const uint32_t    AreaAreaIndex::maxTopLevels;
 
   AreaAreaIndex::AreaAreaIndex(size_t cacheSize)
   : maxLevel(0),
     topLevelOffset(0),
+    topLevels(0),
     indexCache(cacheSize)
   {
     // no code
@@ -59,57 +61,136 @@ namespace osmscout {
     }
   }
 
-  bool AreaAreaIndex::GetIndexCell(uint32_t level,
-                                   FileOffset offset,
-                                   IndexCell &indexCell,
-                                   FileOffset &dataOffset) const
+  /**
+   * Reads the index cell at the given offset
+   */
+  void AreaAreaIndex::ReadIndexCell(FileCursor& cursor,
+                                    uint32_t level,
+                                    FileOffset offset,
+                                    IndexCell& indexCell) const
   {
     if (level<maxLevel) {
-      std::lock_guard<std::mutex> guard(lookupMutex);
-      IndexCache::CacheRef        cacheRef;
+      cursor.SetPos(offset);
 
-#if defined(ANALYZE_CACHE)
-      if (indexCache.GetSize()==indexCache.GetMaxSize()) {
-        log.Warn() << "areaarea.index cache of " << indexCache.GetSize() << "/" << indexCache.GetMaxSize()
-                   << " is too small";
-        indexCache.DumpStatistics("areaarea.idx",IndexCacheValueSizer());
+      for (FileOffset& c : indexCell.children) {
+        FileOffset childOffset;
+
+        cursor.ReadNumber(childOffset);
+
+        if (childOffset==0) {
+          c=0;
+        }
+        else {
+          c=offset-childOffset;
+        }
       }
-#endif
 
-      if (!indexCache.GetEntry(offset,cacheRef)) {
-        IndexCache::CacheEntry cacheEntry(offset);
+      indexCell.data=cursor.GetPos();
+    }
+    else {
+      indexCell.data=offset;
+
+      for (FileOffset& c : indexCell.children) {
+        c=0;
+      }
+    }
+  }
+
+  /**
+   * Reads the cells of the top levels of the index into topLevelCells,
+   * level by level, so that no further lookups are required for them.
+   */
+  void AreaAreaIndex::ReadTopLevels()
+  {
+    FileCursor   cursor(scanner);
+    TopLevelCell topCell;
+    size_t       levelStart=0;
+
+    topLevels=std::min(maxLevel+1,maxTopLevels);
+
+    topLevelCells.clear();
+
+    ReadIndexCell(cursor,
+                  0,
+                  topLevelOffset,
+                  topCell.cell);
 
-        cacheRef=indexCache.SetEntry(cacheEntry);
+    std::fill(std::begin(topCell.childIndex),std::end(topCell.childIndex),0);
 
-        scanner.SetPos(offset);
+    topLevelCells.push_back(topCell);
 
-        for (FileOffset& c : cacheRef->value.children) {
-          FileOffset childOffset;
+    for (uint32_t level=1; level<topLevels; level++) {
+      size_t levelEnd=topLevelCells.size();
 
-          scanner.ReadNumber(childOffset);
+      for (size_t i=levelStart; i<levelEnd; i++) {
+        for (size_t c=0; c<4; c++) {
+          FileOffset childOffset=topLevelCells[i].cell.children[c];
 
           if (childOffset==0) {
-            c=0;
+            continue;
           }
-          else {
-            c=offset-childOffset;
-          }
-        }
 
-        cacheRef->value.data=scanner.GetPos();
+          TopLevelCell childCell;
 
-        indexCell=cacheRef->value;
-      }
-      else {
-        indexCell=cacheRef->value;
+          ReadIndexCell(cursor,
+                        level,
+                        childOffset,
+                        childCell.cell);
+
+          std::fill(std::begin(childCell.childIndex),std::end(childCell.childIndex),0);
+
+          topLevelCells[i].childIndex[c]=(uint32_t)topLevelCells.size();
+          topLevelCells.push_back(childCell);
+        }
       }
+
+      levelStart=levelEnd;
     }
-    else {
-      indexCell.data=offset;
+  }
 
-      for (FileOffset& c : indexCell.children) {
-        c=0;
+  bool AreaAreaIndex::GetIndexCell(FileCursor& cursor,
+                                   uint32_t level,
+                                   FileOffset offset,
+                                   IndexCell &indexCell,
+                                   FileOffset &dataOffset) const
+  {
+    if (level<maxLevel) {
+      {
+        std::lock_guard<std::mutex> guard(indexCacheMutex);
+        IndexCache::CacheRef        cacheRef;
+
+#if defined(ANALYZE_CACHE)
+        if (indexCache.GetSize()==indexCache.GetMaxSize()) {
+          log.Warn() << "areaarea.index cache of " << indexCache.GetSize() << "/" << indexCache.GetMaxSize()
+                     << " is too small";
+          indexCache.DumpStatistics("areaarea.idx",IndexCacheValueSizer());
+        }
+#endif
+
+        if (indexCache.GetEntry(offset,cacheRef)) {
+          indexCell=cacheRef->value;
+          dataOffset=indexCell.data;
+
+          return true;
+        }
       }
+
+      // Read the cell without holding the lock, other lookups may proceed meanwhile
+      ReadIndexCell(cursor,
+                    level,
+                    offset,
+                    indexCell);
+
+      std::lock_guard<std::mutex> guard(indexCacheMutex);
+      IndexCache::CacheEntry      cacheEntry(offset,indexCell);
+
+      indexCache.SetEntry(cacheEntry);
+    }
+    else {
+      ReadIndexCell(cursor,
+                    level,
+                    offset,
+                    indexCell);
     }
 
     dataOffset=indexCell.data;
@@ -117,18 +198,17 @@ namespace osmscout {
     return true;
   }
 
-  bool AreaAreaIndex::ReadCellData(const TypeConfig& typeConfig,
+  bool AreaAreaIndex::ReadCellData(FileCursor& cursor,
+                                   const TypeConfig& typeConfig,
                                    const TypeInfoSet& types,
                                    FileOffset dataOffset,
                                    std::vector<DataBlockSpan>& spans) const
   {
-    std::lock_guard<std::mutex> guard(lookupMutex);
-
-    scanner.SetPos(dataOffset);
+    cursor.SetPos(dataOffset);
 
     uint32_t typeCount;
 
-    scanner.ReadNumber(typeCount);
+    cursor.ReadNumber(typeCount);
 
     FileOffset prevDataFileOffset=0;
 
@@ -137,9 +217,9 @@ namespace osmscout {
       uint32_t   dataCount;
       FileOffset dataFileOffset;
 
-      scanner.ReadTypeId(typeId,typeConfig.GetAreaTypeIdBytes());
-      scanner.ReadNumber(dataCount);
-      scanner.ReadNumber(dataFileOffset);
+      cursor.ReadTypeId(typeId,typeConfig.GetAreaTypeIdBytes());
+      cursor.ReadNumber(dataCount);
+      cursor.ReadNumber(dataFileOffset);
 
       dataFileOffset+=prevDataFileOffset;
       prevDataFileOffset=dataFileOffset;
@@ -168,6 +248,7 @@ namespace osmscout {
                                             double maxlon,
                                             double maxlat,
                                             const IndexCell& cellIndexData,
+                                            const TopLevelCell* topLevelCell,
                                             const CellDimension& cellDimension,
                                             size_t cx,
                                             size_t cy,
@@ -182,7 +263,8 @@ namespace osmscout {
             y>maxlat+cellDimension.height/2 ||
             x+cellDimension.width<minlon-cellDimension.width/2 ||
             y+cellDimension.height<minlat-cellDimension.height/2)) {
-        nextCellRefs.emplace_back(cellIndexData.children[0],cx,cy+1);
+        nextCellRefs.emplace_back(cellIndexData.children[0],cx,cy+1,
+                                  topLevelCell!=nullptr ? topLevelCell->childIndex[0] : 0);
       }
     }
 
@@ -195,7 +277,8 @@ namespace osmscout {
             y>maxlat+cellDimension.height/2 ||
             x+cellDimension.width<minlon-cellDimension.width/2 ||
             y+cellDimension.height<minlat-cellDimension.height/2)) {
-        nextCellRefs.emplace_back(cellIndexData.children[1],cx+1,cy+1);
+        nextCellRefs.emplace_back(cellIndexData.children[1],cx+1,cy+1,
+                                  topLevelCell!=nullptr ? topLevelCell->childIndex[1] : 0);
       }
     }
 
@@ -208,7 +291,8 @@ namespace osmscout {
             y>maxlat+cellDimension.height/2 ||
             x+cellDimension.width<minlon-cellDimension.width/2 ||
             y+cellDimension.height<minlat-cellDimension.height/2)) {
-        nextCellRefs.emplace_back(cellIndexData.children[2],cx,cy);
+        nextCellRefs.emplace_back(cellIndexData.children[2],cx,cy,
+                                  topLevelCell!=nullptr ? topLevelCell->childIndex[2] : 0);
       }
     }
 
@@ -221,7 +305,8 @@ namespace osmscout {
             y>maxlat+cellDimension.height/2 ||
             x+cellDimension.width<minlon-cellDimension.width/2 ||
             y+cellDimension.height<minlat-cellDimension.height/2)) {
-        nextCellRefs.emplace_back(cellIndexData.children[3],cx+1,cy);
+        nextCellRefs.emplace_back(cellIndexData.children[3],cx+1,cy,
+                                  topLevelCell!=nullptr ? topLevelCell->childIndex[3] : 0);
       }
     }
   }
@@ -236,6 +321,8 @@ namespace osmscout {
       scanner.ReadNumber(maxLevel);
       scanner.ReadFileOffset(topLevelOffset);
 
+      ReadTopLevels();
+
       return !scanner.HasError();
     }
     catch (IOException& e) {
@@ -287,9 +374,11 @@ namespace osmscout {
     cellRefs.reserve(2000);
     nextCellRefs.reserve(2000);
 
-    cellRefs.emplace_back(topLevelOffset,0,0);
+    cellRefs.emplace_back(topLevelOffset,0,0,0);
 
     try {
+      FileCursor cursor(scanner);
+
       // For all levels:
       // * Take the tiles and offsets of the last level
       // * Calculate the new tiles and offsets that still interfere with given area
@@ -303,14 +392,28 @@ namespace osmscout {
            level++) {
         nextCellRefs.clear();
 
-        for (const auto& cellRef : cellRefs) {
-          IndexCell  cellIndexData;
-          FileOffset cellDataOffset;
+        // Visit the cells of the level in file order
+        std::sort(cellRefs.begin(),
+                  cellRefs.end(),
+                  [](const CellRef& a, const CellRef& b) {
+                    return a.offset<b.offset;
+                  });
 
-          if (!GetIndexCell(level,
-                            cellRef.offset,
-                            cellIndexData,
-                            cellDataOffset)) {
+        for (const auto& cellRef : cellRefs) {
+          const TopLevelCell* topLevelCell=nullptr;
+          IndexCell           cellIndexData;
+          FileOffset          cellDataOffset;
+
+          if (level<topLevels) {
+            topLevelCell=&topLevelCells[cellRef.topLevelIndex];
+            cellIndexData=topLevelCell->cell;
+            cellDataOffset=cellIndexData.data;
+          }
+          else if (!GetIndexCell(cursor,
+                                 level,
+                                 cellRef.offset,
+                                 cellIndexData,
+                                 cellDataOffset)) {
             log.Error() << "Cannot find offset " << cellRef.offset
                         << " in level " << level
                         << " in file '" << scanner.GetFilename() << "'";
@@ -320,7 +423,8 @@ namespace osmscout {
 
           // Now read the area offsets by type in this index entry
 
-          if (!ReadCellData(typeConfig,
+          if (!ReadCellData(cursor,
+                            typeConfig,
                             types,
                             cellDataOffset,
                             spans)) {
@@ -340,6 +444,7 @@ namespace osmscout {
                                   maxlon,
                                   maxlat,
                                   cellIndexData,
+                                  topLevelCell,
                                   cellDimension[level+1],
                                   cx,
                                   cy,
@@ -161,13 +161,12 @@ namespace osmscout {
     }
   }
 
-  bool AreaNodeIndex::GetOffsetsList(const TypeData& typeData,
+  bool AreaNodeIndex::GetOffsetsList(FileCursor& cursor,
+                                     const TypeData& typeData,
                                      const GeoBox& boundingBox,
                                      std::vector<FileOffset>& offsets) const
   {
-    std::lock_guard<std::mutex> guard(lookupMutex);
-
-    scanner.SetPos(typeData.indexOffset);
+    cursor.SetPos(typeData.indexOffset);
 
     FileOffset previousOffset=0;
 
@@ -175,8 +174,8 @@ namespace osmscout {
       GeoCoord   coord;
       FileOffset fileOffset;
 
-      scanner.ReadCoord(coord);
-      scanner.ReadNumber(fileOffset);
+      cursor.ReadCoord(coord);
+      cursor.ReadNumber(fileOffset);
 
       fileOffset+=previousOffset;
 
@@ -190,12 +189,11 @@ namespace osmscout {
     return true;
   }
 
-  bool AreaNodeIndex::GetOffsetsTileList(const TypeData& typeData,
+  bool AreaNodeIndex::GetOffsetsTileList(FileCursor& cursor,
+                                         const TypeData& typeData,
                                          const GeoBox& boundingBox,
                                          std::vector<FileOffset>& offsets) const
   {
-    std::lock_guard<std::mutex> guard(lookupMutex);
-
     TileIdBox tileBox(TileId::GetTile(gridMag,boundingBox.GetMinCoord()),
                       TileId::GetTile(gridMag,boundingBox.GetMaxCoord()));
 
@@ -203,7 +201,7 @@ namespace osmscout {
       auto tile=typeData.listTiles.find(tileId);
 
       if (tile!=typeData.listTiles.end()) {
-        scanner.SetPos(tile->second.fileOffset);
+        cursor.SetPos(tile->second.fileOffset);
 
         FileOffset previousOffset=0;
 
@@ -212,8 +210,8 @@ namespace osmscout {
             GeoCoord   coord;
             FileOffset fileOffset;
 
-            scanner.ReadCoord(coord);
-            scanner.ReadNumber(fileOffset);
+            cursor.ReadCoord(coord);
+            cursor.ReadNumber(fileOffset);
 
             fileOffset+=previousOffset;
 
@@ -228,7 +226,7 @@ namespace osmscout {
           for (auto i=1; i<=tile->second.entryCount; i++) {
             FileOffset fileOffset;
 
-            scanner.ReadNumber(fileOffset);
+            cursor.ReadNumber(fileOffset);
 
             fileOffset+=previousOffset;
 
@@ -243,7 +241,8 @@ namespace osmscout {
     return true;
   }
 
-  bool AreaNodeIndex::GetOffsetsBitmap(const TypeData& typeData,
+  bool AreaNodeIndex::GetOffsetsBitmap(FileCursor& cursor,
+                                       const TypeData& typeData,
                                        const GeoBox& boundingBox,
                                        std::vector<FileOffset>& offsets) const
   {
@@ -278,21 +277,20 @@ namespace osmscout {
 
         // For each row
         for (auto y=minyc; y<=maxyc; y++) {
-          std::lock_guard<std::mutex> guard(lookupMutex);
-          FileOffset                  initialCellDataOffset=0;
-          size_t                      cellDataOffsetCount=0;
-          FileOffset                  cellIndexOffset=tileBitmap->second.fileOffset+
-                                                      ((y-bitmapTileBox.GetMinY())*bitmapTileBox.GetWidth()+
-                                                       minxc-bitmapTileBox.GetMinX())*tileBitmap->second.dataOffsetBytes;
+          FileOffset initialCellDataOffset=0;
+          size_t     cellDataOffsetCount=0;
+          FileOffset cellIndexOffset=tileBitmap->second.fileOffset+
+                                     ((y-bitmapTileBox.GetMinY())*bitmapTileBox.GetWidth()+
+                                      minxc-bitmapTileBox.GetMinX())*tileBitmap->second.dataOffsetBytes;
 
-          scanner.SetPos(cellIndexOffset);
+          cursor.SetPos(cellIndexOffset);
 
           // For each column in row
           for (size_t x=minxc; x<=maxxc; x++) {
             FileOffset cellDataOffset;
 
-            scanner.ReadFileOffset(cellDataOffset,
-                                   tileBitmap->second.dataOffsetBytes);
+            cursor.ReadFileOffset(cellDataOffset,
+                                  tileBitmap->second.dataOffsetBytes);
 
             if (cellDataOffset==0) {
               continue;
@@ -314,19 +312,19 @@ namespace osmscout {
 
           assert(initialCellDataOffset>=cellIndexOffset);
 
-          scanner.SetPos(initialCellDataOffset);
+          cursor.SetPos(initialCellDataOffset);
 
           // For each data cell in row found
           for (size_t i=0; i<cellDataOffsetCount; i++) {
             uint32_t   dataCount;
             FileOffset previousOffset=0;
 
-            scanner.ReadNumber(dataCount);
+            cursor.ReadNumber(dataCount);
 
             for (size_t d=0; d<dataCount; d++) {
               FileOffset fileOffset;
 
-              scanner.ReadNumber(fileOffset);
+              cursor.ReadNumber(fileOffset);
 
               fileOffset+=previousOffset;
 
@@ -354,7 +352,11 @@ namespace osmscout {
 
     offsets.reserve(std::min((size_t)10000,offsets.capacity()));
 
+    size_t initialSize=offsets.size();
+
     try {
+      FileCursor cursor(scanner);
+
       for (const TypeInfoRef& type : requestedTypes) {
         if (type->IsInternal()) {
           continue;
@@ -370,15 +372,15 @@ namespace osmscout {
           if (!nodeTypeData[index].isComplex &&
               nodeTypeData[index].indexOffset!=0 &&
               nodeTypeData[index].entryCount!=0) {
-            if (!GetOffsetsList(nodeTypeData[index],boundingBox,offsets)) {
+            if (!GetOffsetsList(cursor,nodeTypeData[index],boundingBox,offsets)) {
               return false;
             }
           }
           else if (nodeTypeData[index].isComplex) {
-            if (!GetOffsetsTileList(nodeTypeData[index],boundingBox,offsets)) {
+            if (!GetOffsetsTileList(cursor,nodeTypeData[index],boundingBox,offsets)) {
               return false;
             }
-            if (!GetOffsetsBitmap(nodeTypeData[index],boundingBox,offsets)) {
+            if (!GetOffsetsBitmap(cursor,nodeTypeData[index],boundingBox,offsets)) {
               return false;
             }
           }
@@ -396,6 +398,9 @@ namespace osmscout {
       return false;
     }
 
+    // Return nodes in file order, so that they can be read sequentially
+    std::sort(offsets.begin()+initialSize,offsets.end());
+
     time.Stop();
 
     if (time.GetMilliseconds()>100) {
@@ -32,17 +32,51 @@ namespace osmscout {
 
   const char* const AreaWayIndex::AREA_WAY_IDX="areaway.idx";
 
-  FileOffset AreaWayIndex::TypeData::GetDataOffset() const
+  /**
+   * Narrows the given column range of the given row to the columns, that may
+   * contain data according to the presence summary. Returns false, if the row
+   * does not contain any data in the given range.
+   */
+  bool AreaWayIndex::TypeData::GetPresentColumns(uint32_t y,
+                                                 uint32_t& minX,
+                                                 uint32_t& maxX) const
   {
-    return bitmapOffset+tileBox.GetCount()*(FileOffset)dataOffsetBytes;
-  }
+    uint32_t presenceY=y >> presenceShift;
+    uint32_t presenceMinX=minX >> presenceShift;
+    uint32_t presenceMaxX=maxX >> presenceShift;
+    size_t   rowStart=(size_t)(presenceY-presenceBox.GetMinY())*presenceBox.GetWidth();
+    uint32_t first=presenceMaxX+1;
+    uint32_t last=0;
+
+    for (uint32_t x=presenceMinX; x<=presenceMaxX; x++) {
+      size_t bit=rowStart+x-presenceBox.GetMinX();
+
+      if ((presence[bit/8] & (1 << (bit%8)))!=0) {
+        first=std::min(first,x);
+        last=x;
+      }
+    }
 
-  FileOffset AreaWayIndex::TypeData::GetCellOffset(size_t x, size_t y) const
-  {
-    return bitmapOffset+((y-tileBox.GetMinY())*tileBox.GetWidth()+x-tileBox.GetMinX())*dataOffsetBytes;
+    if (first>presenceMaxX) {
+      return false;
+    }
+
+    minX=std::max(minX,first << presenceShift);
+    maxX=std::min(maxX,((last+1) << presenceShift)-1);
+
+    return true;
   }
 
   AreaWayIndex::TypeData::TypeData()
+  : indexLevel(0),
+    tileBox(TileId(0,0),
+            TileId(0,0)),
+    presenceShift(0),
+    presenceBox(TileId(0,0),
+                TileId(0,0))
+  {}
+
+  AreaWayIndex::LevelData::LevelData()
   : indexLevel(0),
     dataOffsetBytes(0),
     bitmapOffset(0),
@@ -50,6 +84,16 @@ namespace osmscout {
             TileId(0,0))
   {}
 
+  FileOffset AreaWayIndex::LevelData::GetDataOffset() const
+  {
+    return bitmapOffset+tileBox.GetCount()*(FileOffset)dataOffsetBytes;
+  }
+
+  FileOffset AreaWayIndex::LevelData::GetCellOffset(size_t x, size_t y) const
+  {
+    return bitmapOffset+((y-tileBox.GetMinY())*tileBox.GetWidth()+x-tileBox.GetMinX())*dataOffsetBytes;
+  }
+
   AreaWayIndex::AreaWayIndex()
   {
     // no code
@@ -98,34 +142,69 @@ namespace osmscout {
 
         data.type=typeConfig->GetWayTypeInfo(typeId);
 
-        scanner.ReadFileOffset(data.bitmapOffset);
+        uint32_t indexLevel;
+        scanner.ReadNumber(indexLevel);
+        data.indexLevel=MagnificationLevel(indexLevel);
 
-        if (data.bitmapOffset>0) {
-          scanner.Read(data.dataOffsetBytes);
+        uint32_t minX;
+        uint32_t maxX;
+        uint32_t minY;
+        uint32_t maxY;
 
-          uint32_t indexLevel;
-          scanner.ReadNumber(indexLevel);
-          data.indexLevel=MagnificationLevel(indexLevel);
+        scanner.ReadNumber(minX);
+        scanner.ReadNumber(maxX);
+        scanner.ReadNumber(minY);
+        scanner.ReadNumber(maxY);
 
-          uint32_t minX;
-          uint32_t maxX;
-          uint32_t minY;
-          uint32_t maxY;
+        data.tileBox=TileIdBox(TileId(minX,minY),
+                               TileId(maxX,maxY));
 
-          scanner.ReadNumber(minX);
-          scanner.ReadNumber(maxX);
-          scanner.ReadNumber(minY);
-          scanner.ReadNumber(maxY);
+        data.boundingBox=data.tileBox.GetBoundingBox(Magnification(data.indexLevel));
 
-          data.tileBox=TileIdBox(TileId(minX,minY),
-                                 TileId(maxX,maxY));
+        scanner.Read(data.presenceShift);
 
-          data.boundingBox=data.tileBox.GetBoundingBox(Magnification(data.indexLevel));
-        }
+        data.presenceBox=TileIdBox(TileId(minX >> data.presenceShift,minY >> data.presenceShift),
+                                   TileId(maxX >> data.presenceShift,maxY >> data.presenceShift));
+        data.presence.resize((data.presenceBox.GetCount()+7)/8);
+
+        scanner.Read((char*)data.presence.data(),
+                     data.presence.size());
 
         wayTypeData.push_back(data);
       }
 
+      uint32_t levelEntries;
+
+      scanner.Read(levelEntries);
+
+      levelData.resize(levelEntries);
+
+      for (auto& level : levelData) {
+        uint32_t indexLevel;
+
+        scanner.ReadNumber(indexLevel);
+        level.indexLevel=MagnificationLevel(indexLevel);
+
+        scanner.ReadFileOffset(level.bitmapOffset);
+        scanner.Read(level.dataOffsetBytes);
+
+        // Types of the level in the order of the type table
+        for (size_t i=0; i<wayTypeData.size(); i++) {
+          if (wayTypeData[i].indexLevel!=level.indexLevel) {
+            continue;
+          }
+
+          if (level.types.empty()) {
+            level.tileBox=wayTypeData[i].tileBox;
+          }
+          else {
+            level.tileBox=level.tileBox.Include(wayTypeData[i].tileBox);
+          }
+
+          level.types.push_back(i);
+        }
+      }
+
       return !scanner.HasError();
     }
     catch (IOException& e) {
@@ -135,49 +214,63 @@ namespace osmscout {
     }
   }
 
-  void AreaWayIndex::GetOffsets(const TypeData& typeData,
-                                const GeoBox& boundingBox,
-                                std::unordered_set<FileOffset>& offsets) const
+  /**
+   * Appends the offsets of all ways of the requested types of the level in the
+   * given tiles, which must be part of the tile box of the level. Each row is
+   * read once for all requested types. Rows and columns without data for any
+   * requested type according to their presence summaries are skipped without
+   * reading the bitmap, records of other types are skipped by their size.
+   */
+  void AreaWayIndex::GetOffsets(FileCursor& cursor,
+                                const LevelData& level,
+                                const std::vector<bool>& requestedTypes,
+                                const TileIdBox& boundingTileBox,
+                                std::vector<FileOffset>& offsets) const
   {
-    if (typeData.bitmapOffset==0) {
+    FileOffset dataOffset=level.GetDataOffset();
 
-      // No data for this type available
-      return;
-    }
-
-    if (!boundingBox.Intersects(typeData.boundingBox)) {
-
-      // No data available in given bounding box
-      return;
-    }
-
-    TileIdBox boundingTileBox(Magnification(typeData.indexLevel),
-                              boundingBox);
+    // For each row
+    for (uint32_t y=boundingTileBox.GetMinY(); y<=boundingTileBox.GetMaxY(); y++) {
+      uint32_t minX=boundingTileBox.GetMaxX()+1;
+      uint32_t maxX=0;
+
+      // Union of the present columns of all requested types in the row
+      for (size_t t=0; t<level.types.size(); t++) {
+        const TypeData& typeData=wayTypeData[level.types[t]];
+
+        if (!requestedTypes[t] ||
+            y<typeData.tileBox.GetMinY() ||
+            y>typeData.tileBox.GetMaxY() ||
+            boundingTileBox.GetMaxX()<typeData.tileBox.GetMinX() ||
+            boundingTileBox.GetMinX()>typeData.tileBox.GetMaxX()) {
+          continue;
+        }
 
-    if (!boundingTileBox.Intersects(typeData.tileBox)) {
-      // No data available in given bounding box
-      return;
-    }
+        uint32_t typeMinX=std::max(boundingTileBox.GetMinX(),typeData.tileBox.GetMinX());
+        uint32_t typeMaxX=std::min(boundingTileBox.GetMaxX(),typeData.tileBox.GetMaxX());
 
-    boundingTileBox=boundingTileBox.Intersection(typeData.tileBox);
+        if (typeData.GetPresentColumns(y,typeMinX,typeMaxX)) {
+          minX=std::min(minX,typeMinX);
+          maxX=std::max(maxX,typeMaxX);
+        }
+      }
 
-    FileOffset dataOffset=typeData.GetDataOffset();
+      if (minX>maxX) {
+        continue;
+      }
 
-    // For each row
-    for (size_t y=boundingTileBox.GetMinY(); y<=boundingTileBox.GetMaxY(); y++) {
-      std::lock_guard<std::mutex> guard(lookupMutex);
-      FileOffset                  initialCellDataOffset=0;
-      size_t                      cellDataOffsetCount=0;
-      FileOffset                  bitmapCellOffset=typeData.GetCellOffset(boundingTileBox.GetMinX(),y);
+      FileOffset initialCellDataOffset=0;
+      size_t     cellDataOffsetCount=0;
+      FileOffset bitmapCellOffset=level.GetCellOffset(minX,y);
 
-      scanner.SetPos(bitmapCellOffset);
+      cursor.SetPos(bitmapCellOffset);
 
       // For each column in row
-      for (size_t x=boundingTileBox.GetMinX(); x<=boundingTileBox.GetMaxX(); x++) {
+      for (uint32_t x=minX; x<=maxX; x++) {
         FileOffset cellDataOffset;
 
-        scanner.ReadFileOffset(cellDataOffset,
-                               typeData.dataOffsetBytes);
+        cursor.ReadFileOffset(cellDataOffset,
+                              level.dataOffsetBytes);
 
         if (cellDataOffset==0) {
           continue;
@@ -202,30 +295,53 @@ namespace osmscout {
       assert(initialCellDataOffset>=bitmapCellOffset);
 
       // first data entry in the row
-      scanner.SetPos(initialCellDataOffset);
+      cursor.SetPos(initialCellDataOffset);
 
       // For each data cell (in range) in row found
       for (size_t i=0; i<cellDataOffsetCount; i++) {
-        uint32_t   dataCount;
-        FileOffset lastOffset=0;
+        uint32_t typeCount;
+
+        cursor.ReadNumber(typeCount);
+
+        // For each type with data in the cell
+        for (size_t t=0; t<typeCount; t++) {
+          uint32_t   typeIndex;
+          FileOffset dataSize;
+
+          cursor.ReadNumber(typeIndex);
+          cursor.ReadNumber(dataSize);
+
+          if (typeIndex>=requestedTypes.size() ||
+              !requestedTypes[typeIndex]) {
+            cursor.SetPos(cursor.GetPos()+dataSize);
+            continue;
+          }
 
-        scanner.ReadNumber(dataCount);
+          uint32_t   dataCount;
+          FileOffset lastOffset=0;
 
-        for (size_t d=0; d<dataCount; d++) {
-          FileOffset objectOffset;
+          cursor.ReadNumber(dataCount);
 
-          scanner.ReadNumber(objectOffset);
+          for (size_t d=0; d<dataCount; d++) {
+            FileOffset objectOffset;
 
-          objectOffset+=lastOffset;
+            cursor.ReadNumber(objectOffset);
 
-          offsets.insert(objectOffset);
+            objectOffset+=lastOffset;
 
-          lastOffset=objectOffset;
+            offsets.push_back(objectOffset);
+
+            lastOffset=objectOffset;
+          }
         }
       }
     }
   }
 
+  /**
+   * Appends the file offsets of all ways of the given types intersecting the given
+   * area to offsets. The appended offsets are sorted by file offset and unique.
+   */
   bool AreaWayIndex::GetOffsets(const GeoBox& boundingBox,
                                 const TypeInfoSet& types,
                                 std::vector<FileOffset>& offsets,
@@ -236,18 +352,51 @@ namespace osmscout {
     offsets.reserve(std::min((size_t)10000,offsets.capacity()));
     loadedTypes.Clear();
 
-    std::unordered_set<FileOffset> uniqueOffsets;
+    size_t initialSize=offsets.size();
 
     try {
+      FileCursor        cursor(scanner);
+      std::vector<bool> requestedTypes;
+
       for (const auto& data : wayTypeData) {
         if (types.IsSet(data.type)) {
-          GetOffsets(data,
-                     boundingBox,
-                     uniqueOffsets);
-
           loadedTypes.Set(data.type);
         }
       }
+
+      for (const auto& level : levelData) {
+        bool hasRequestedTypes=false;
+
+        requestedTypes.assign(level.types.size(),false);
+
+        for (size_t t=0; t<level.types.size(); t++) {
+          const TypeData& data=wayTypeData[level.types[t]];
+
+          if (types.IsSet(data.type) &&
+              boundingBox.Intersects(data.boundingBox)) {
+            requestedTypes[t]=true;
+            hasRequestedTypes=true;
+          }
+        }
+
+        if (!hasRequestedTypes) {
+          continue;
+        }
+
+        TileIdBox boundingTileBox(Magnification(level.indexLevel),
+                                  boundingBox);
+
+        if (!boundingTileBox.Intersects(level.tileBox)) {
+          // No data available in given bounding box
+          continue;
+        }
+
+        GetOffsets(cursor,
+                   level,
+                   requestedTypes,
+                   boundingTileBox.Intersection(level.tileBox),
+                   offsets);
+      }
     }
     catch (IOException& e) {
       log.Error() << e.GetDescription();
@@ -255,7 +404,11 @@ namespace osmscout {
       return false;
     }
 
-    offsets.insert(offsets.end(),uniqueOffsets.begin(),uniqueOffsets.end());
+    // Ways are found multiple times if they cover multiple cells,
+    // return them in file order, so that they can be read sequentially
+    std::sort(offsets.begin()+initialSize,offsets.end());
+    offsets.erase(std::unique(offsets.begin()+initialSize,offsets.end()),
+                  offsets.end());
 
     //std::cout << "Found " << wayWayOffsets.size() << "+" << relationWayOffsets.size()<< " offsets in 'areaway.idx'" << std::endl;
 
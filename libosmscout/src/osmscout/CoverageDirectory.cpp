@@ -0,0 +1,233 @@
+/*
+  This source is part of the libosmscout library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/CoverageDirectory.h>
+
+#include <algorithm>
+
+namespace osmscout {
+
+  /**
+   * Cells of the default leaf level are about 1.4 x 0.7 degree in size
+   */
+  const uint32_t CoverageDirectory::DEFAULT_LEVEL=8;
+
+  /**
+   * Returns the cell of the given level containing the given coordinate
+   */
+  static Pixel GetCell(uint32_t level,
+                       const GeoCoord& coord)
+  {
+    uint32_t cellCount=1u << level;
+    double   cellWidth=360.0/cellCount;
+    double   cellHeight=180.0/cellCount;
+
+    return {std::min(cellCount-1,(uint32_t)std::max(0.0,(coord.GetLon()+180.0)/cellWidth)),
+            std::min(cellCount-1,(uint32_t)std::max(0.0,(coord.GetLat()+90.0)/cellHeight))};
+  }
+
+  CoverageDirectory::CoverageDirectory(uint32_t maxLevel)
+  : levelCount(maxLevel+1),
+    levels(levelCount)
+  {
+    // no code
+  }
+
+  void CoverageDirectory::Clear()
+  {
+    for (auto& level : levels) {
+      level.clear();
+    }
+
+    databases.clear();
+    uncoveredDatabases.clear();
+  }
+
+  /**
+   * Adds the database to the given cell and all its parent cells
+   */
+  void CoverageDirectory::AddCell(uint32_t level,
+                                  const Pixel& cell,
+                                  DatabaseId id)
+  {
+    Pixel current(cell);
+
+    while (true) {
+      std::vector<DatabaseId>& ids=levels[level][current.GetId()];
+
+      // If the database is already registered, it is also registered for all parent cells
+      if (!ids.empty() &&
+          ids.back()==id) {
+        return;
+      }
+
+      ids.push_back(id);
+
+      if (level==0) {
+        return;
+      }
+
+      level--;
+      current=Pixel(current.x/2,current.y/2);
+    }
+  }
+
+  /**
+   * Adds a database with the given (open) coverage index. If the index is not
+   * available, the database is assumed to cover everything.
+   */
+  void CoverageDirectory::AddDatabase(DatabaseId id,
+                                      const CoverageIndexRef& index)
+  {
+    if (!index ||
+        !index->IsOpen()) {
+      uncoveredDatabases.push_back(id);
+      return;
+    }
+
+    databases[id]=index;
+
+    uint32_t leafLevel=levelCount-1;
+    uint32_t cellLevel=index->GetCellLevel();
+    Pixel    minCell=index->GetMinCell();
+    Pixel    maxCell=index->GetMaxCell();
+
+    for (uint32_t y=minCell.y; y<=maxCell.y; y++) {
+      for (uint32_t x=minCell.x; x<=maxCell.x; x++) {
+        if (!index->IsCovered(Pixel(x,y))) {
+          continue;
+        }
+
+        if (cellLevel>=leafLevel) {
+          uint32_t shift=cellLevel-leafLevel;
+
+          AddCell(leafLevel,
+                  Pixel(x >> shift,y >> shift),
+                  id);
+        }
+        else {
+          // The coverage cell spans multiple leaf cells
+          uint32_t shift=leafLevel-cellLevel;
+
+          for (uint32_t ly=y << shift; ly<(y+1) << shift; ly++) {
+            for (uint32_t lx=x << shift; lx<(x+1) << shift; lx++) {
+              AddCell(leafLevel,
+                      Pixel(lx,ly),
+                      id);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Returns all databases covering the given coordinate
+   */
+  void CoverageDirectory::GetDatabases(const GeoCoord& coord,
+                                       std::vector<DatabaseId>& result) const
+  {
+    result=uncoveredDatabases;
+
+    auto entry=levels[levelCount-1].find(GetCell(levelCount-1,coord).GetId());
+
+    if (entry!=levels[levelCount-1].end()) {
+      for (const auto id : entry->second) {
+        if (databases.at(id)->IsCovered(coord)) {
+          result.push_back(id);
+        }
+      }
+    }
+
+    std::sort(result.begin(),result.end());
+    result.erase(std::unique(result.begin(),result.end()),
+                 result.end());
+  }
+
+  /**
+   * Appends the databases of the given cell, if it is completely part of the given range
+   * of leaf cells, else descends into its children.
+   */
+  void CoverageDirectory::GetDatabases(uint32_t level,
+                                       const Pixel& cell,
+                                       const Pixel& minLeaf,
+                                       const Pixel& maxLeaf,
+                                       std::vector<DatabaseId>& result) const
+  {
+    auto entry=levels[level].find(cell.GetId());
+
+    if (entry==levels[level].end()) {
+      return;
+    }
+
+    uint32_t leafLevel=levelCount-1;
+    uint32_t shift=leafLevel-level;
+
+    // The cell does not intersect the range
+    if (cell.x<minLeaf.x >> shift ||
+        cell.x>maxLeaf.x >> shift ||
+        cell.y<minLeaf.y >> shift ||
+        cell.y>maxLeaf.y >> shift) {
+      return;
+    }
+
+    // We are at the leaf level or the cell is completely part of the range
+    if (level==leafLevel ||
+        (cell.x << shift>=minLeaf.x &&
+         ((cell.x+1) << shift)-1<=maxLeaf.x &&
+         cell.y << shift>=minLeaf.y &&
+         ((cell.y+1) << shift)-1<=maxLeaf.y)) {
+      result.insert(result.end(),
+                    entry->second.begin(),
+                    entry->second.end());
+      return;
+    }
+
+    for (uint32_t y=cell.y*2; y<=cell.y*2+1; y++) {
+      for (uint32_t x=cell.x*2; x<=cell.x*2+1; x++) {
+        GetDatabases(level+1,
+                     Pixel(x,y),
+                     minLeaf,
+                     maxLeaf,
+                     result);
+      }
+    }
+  }
+
+  /**
+   * Returns all databases, that (may) cover the given bounding box. The result
+   * is exact on the level of the leaf cells of the directory.
+   */
+  void CoverageDirectory::GetDatabases(const GeoBox& boundingBox,
+                                       std::vector<DatabaseId>& result) const
+  {
+    result=uncoveredDatabases;
+
+    if (boundingBox.IsValid()) {
+      GetDatabases(0,
+                   Pixel(0,0),
+                   GetCell(levelCount-1,boundingBox.GetMinCoord()),
+                   GetCell(levelCount-1,boundingBox.GetMaxCoord()),
+                   result);
+    }
+
+    std::sort(result.begin(),result.end());
+    result.erase(std::unique(result.begin(),result.end()),
+                 result.end());
+  }
+}
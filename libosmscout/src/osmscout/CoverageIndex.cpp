@@ -68,7 +68,8 @@ namespace osmscout {
       width=maxCell.x-minCell.x+1;
       height=maxCell.y-minCell.y+1;
 
-      bitmap.resize((width*height)/8,0);
+      // The import writes at least one byte, also for very small bitmaps
+      bitmap.resize(std::max((uint32_t)1,(width*height)/8),0);
 
       for (auto& b : bitmap) {
         scanner.Read(b);
@@ -149,6 +149,66 @@ namespace osmscout {
     return indexMMap;
   }
 
+  DatabaseWarmupParameter::DatabaseWarmupParameter()
+  : dataFiles(true),
+    areaIndexes(true),
+    lowZoomOptimizations(true),
+    waterIndex(true),
+    locationIndex(false)
+  {
+    // no code
+  }
+
+  void DatabaseWarmupParameter::SetDataFiles(bool dataFiles)
+  {
+    this->dataFiles=dataFiles;
+  }
+
+  void DatabaseWarmupParameter::SetAreaIndexes(bool areaIndexes)
+  {
+    this->areaIndexes=areaIndexes;
+  }
+
+  void DatabaseWarmupParameter::SetLowZoomOptimizations(bool lowZoomOptimizations)
+  {
+    this->lowZoomOptimizations=lowZoomOptimizations;
+  }
+
+  void DatabaseWarmupParameter::SetWaterIndex(bool waterIndex)
+  {
+    this->waterIndex=waterIndex;
+  }
+
+  void DatabaseWarmupParameter::SetLocationIndex(bool locationIndex)
+  {
+    this->locationIndex=locationIndex;
+  }
+
+  bool DatabaseWarmupParameter::GetDataFiles() const
+  {
+    return dataFiles;
+  }
+
+  bool DatabaseWarmupParameter::GetAreaIndexes() const
+  {
+    return areaIndexes;
+  }
+
+  bool DatabaseWarmupParameter::GetLowZoomOptimizations() const
+  {
+    return lowZoomOptimizations;
+  }
+
+  bool DatabaseWarmupParameter::GetWaterIndex() const
+  {
+    return waterIndex;
+  }
+
+  bool DatabaseWarmupParameter::GetLocationIndex() const
+  {
+    return locationIndex;
+  }
+
   NodeRegionSearchResultEntry::NodeRegionSearchResultEntry(const NodeRef &node,
                                                            const Distance &distance)
   : node(node),
@@ -178,7 +238,9 @@ namespace osmscout {
 
   Database::Database(const DatabaseParameter& parameter)
    : parameter(parameter),
-     isOpen(false)
+     isOpen(false),
+     areaLODDataFileChecked(false),
+     wayLODDataFileChecked(false)
   {
     log.Debug() << "Database::Database()";
   }
@@ -271,6 +333,20 @@ namespace osmscout {
       optimizeAreasLowZoom=nullptr;
     }
 
+    if (areaLODDataFile) {
+      areaLODDataFile->Close();
+      areaLODDataFile=nullptr;
+    }
+
+    areaLODDataFileChecked=false;
+
+    if (wayLODDataFile) {
+      wayLODDataFile->Close();
+      wayLODDataFile=nullptr;
+    }
+
+    wayLODDataFileChecked=false;
+
     isOpen=false;
   }
 
@@ -601,6 +677,162 @@ namespace osmscout {
     return optimizeWaysLowZoom;
   }
 
+  /**
+   * Return the optional file with the simplified area geometries or nullptr,
+   * if the database was imported without it.
+   */
+  AreaLODDataFileRef Database::GetAreaLODDataFile() const
+  {
+    std::lock_guard<std::mutex> guard(areaLODDataFileMutex);
+
+    if (!IsOpen()) {
+      return nullptr;
+    }
+
+    if (!areaLODDataFileChecked) {
+      areaLODDataFileChecked=true;
+
+      if (!ExistsInFilesystem(AppendFileToDir(path,AreaLODDataFile::AREASLOD_DAT))) {
+        return nullptr;
+      }
+
+      areaLODDataFile=std::make_shared<AreaLODDataFile>(parameter.GetAreaDataCacheSize());
+
+      StopClock timer;
+
+      if (!areaLODDataFile->Open(typeConfig,
+                                 path,
+                                 parameter.GetAreasDataMMap())) {
+        log.Error() << "Cannot open '" << AreaLODDataFile::AREASLOD_DAT << "'!";
+        areaLODDataFile=nullptr;
+
+        return nullptr;
+      }
+
+      timer.Stop();
+
+      log.Debug() << "Opening AreaLODDataFile: " << timer.ResultString();
+    }
+
+    return areaLODDataFile;
+  }
+
+  /**
+   * Return the optional file with the simplified way geometries or nullptr,
+   * if the database was imported without it.
+   */
+  WayLODDataFileRef Database::GetWayLODDataFile() const
+  {
+    std::lock_guard<std::mutex> guard(wayLODDataFileMutex);
+
+    if (!IsOpen()) {
+      return nullptr;
+    }
+
+    if (!wayLODDataFileChecked) {
+      wayLODDataFileChecked=true;
+
+      if (!ExistsInFilesystem(AppendFileToDir(path,WayLODDataFile::WAYSLOD_DAT))) {
+        return nullptr;
+      }
+
+      wayLODDataFile=std::make_shared<WayLODDataFile>(parameter.GetWayDataCacheSize());
+
+      StopClock timer;
+
+      if (!wayLODDataFile->Open(typeConfig,
+                                path,
+                                parameter.GetWaysDataMMap())) {
+        log.Error() << "Cannot open '" << WayLODDataFile::WAYSLOD_DAT << "'!";
+        wayLODDataFile=nullptr;
+
+        return nullptr;
+      }
+
+      timer.Stop();
+
+      log.Debug() << "Opening WayLODDataFile: " << timer.ResultString();
+    }
+
+    return wayLODDataFile;
+  }
+
+  /**
+   * Opens the selected data files and indexes in parallel background threads.
+   * Opening reads the file headers and the in-memory parts of the indexes (for
+   * example the top levels of the area area index), so that the first
+   * rendering after opening the database does not have to do it.
+   *
+   * Warming up is optional, everything not warmed up is still opened on first use.
+   * The database must stay open and alive until the returned future is ready.
+   *
+   * The returned future is created by std::async, so its destructor blocks until
+   * warming up is finished. A caller, that wants to continue in the meantime,
+   * has to keep the future (for example as a member next to the database)
+   * instead of discarding it; a discarded future makes the call synchronous.
+   *
+   * @param warmupParameter
+   *    Selection of the data files and indexes to open
+   * @return
+   *    Future, that is ready after everything is opened. Its value is false, if
+   *    one of the data files or indexes could not be opened.
+   */
+  std::future<bool> Database::Warmup(const DatabaseWarmupParameter& warmupParameter) const
+  {
+    return std::async(std::launch::async,[this,warmupParameter]() {
+      StopClock                          time;
+      std::vector<std::function<bool()>> tasks;
+      std::vector<std::future<bool>>     results;
+      bool                               success=true;
+
+      if (warmupParameter.GetDataFiles()) {
+        tasks.emplace_back([this]() { return GetNodeDataFile()!=nullptr; });
+        tasks.emplace_back([this]() { return GetWayDataFile()!=nullptr; });
+        tasks.emplace_back([this]() { return GetAreaDataFile()!=nullptr; });
+        // simplified geometries are optional
+        tasks.emplace_back([this]() { GetWayLODDataFile(); return true; });
+        tasks.emplace_back([this]() { GetAreaLODDataFile(); return true; });
+      }
+
+      if (warmupParameter.GetAreaIndexes()) {
+        tasks.emplace_back([this]() { return GetAreaNodeIndex()!=nullptr; });
+        tasks.emplace_back([this]() { return GetAreaWayIndex()!=nullptr; });
+        tasks.emplace_back([this]() { return GetAreaAreaIndex()!=nullptr; });
+      }
+
+      if (warmupParameter.GetLowZoomOptimizations()) {
+        tasks.emplace_back([this]() { return GetOptimizeWaysLowZoom()!=nullptr; });
+        tasks.emplace_back([this]() { return GetOptimizeAreasLowZoom()!=nullptr; });
+      }
+
+      if (warmupParameter.GetWaterIndex()) {
+        tasks.emplace_back([this]() { return GetWaterIndex()!=nullptr; });
+      }
+
+      if (warmupParameter.GetLocationIndex()) {
+        tasks.emplace_back([this]() { return GetLocationIndex()!=nullptr; });
+      }
+
+      results.reserve(tasks.size());
+
+      for (const auto& task : tasks) {
+        results.push_back(std::async(std::launch::async,task));
+      }
+
+      for (auto& result : results) {
+        if (!result.get()) {
+          success=false;
+        }
+      }
+
+      time.Stop();
+
+      log.Debug() << "Warming up database '" << path << "' took " << time.ResultString();
+
+      return success;
+    });
+  }
+
   bool Database::GetBoundingBox(GeoBox& boundingBox) const
   {
     BoundingBoxDataFileRef boundingBoxDataFile=GetBoundingBoxDataFile();
@@ -660,7 +892,8 @@ namespace osmscout {
 
   bool Database::GetNodesByOffset(const std::vector<FileOffset>& offsets,
                                   const GeoBox& boundingBox,
-                                  std::vector<NodeRef>& nodes) const
+                                  std::vector<NodeRef>& nodes,
+                                  const BreakerRef& breaker) const
   {
     NodeDataFileRef nodeDataFile=GetNodeDataFile();
 
@@ -674,7 +907,8 @@ namespace osmscout {
                                           offsets.end(),
                                           offsets.size(),
                                           boundingBox,
-                                          nodes);
+                                          nodes,
+                                          breaker);
 
     time.Stop();
 
@@ -872,7 +1106,8 @@ namespace osmscout {
   }
 
   bool Database::GetAreasByBlockSpans(const std::vector<DataBlockSpan>& spans,
-                                      std::vector<AreaRef>& areas) const
+                                      std::vector<AreaRef>& areas,
+                                      const BreakerRef& breaker) const
   {
     AreaDataFileRef areaDataFile=GetAreaDataFile();
 
@@ -882,7 +1117,40 @@ namespace osmscout {
 
     return areaDataFile->GetByBlockSpans(spans.begin(),
                                          spans.end(),
-                                         areas);
+                                         areas,
+                                         breaker);
+  }
+
+  /**
+   * Like GetAreasByBlockSpans() but returns the simplified geometries for
+   * the given magnification, if the database holds them.
+   */
+  bool Database::GetAreasByBlockSpans(const std::vector<DataBlockSpan>& spans,
+                                      const Magnification& magnification,
+                                      std::vector<AreaRef>& areas,
+                                      const BreakerRef& breaker) const
+  {
+    AreaDataFileRef areaDataFile=GetAreaDataFile();
+
+    if (!areaDataFile) {
+      return false;
+    }
+
+    AreaLODDataFileRef areaLODDataFile=GetAreaLODDataFile();
+
+    if (!areaLODDataFile) {
+      return areaDataFile->GetByBlockSpans(spans.begin(),
+                                           spans.end(),
+                                           areas,
+                                           breaker);
+    }
+
+    return areaLODDataFile->GetByBlockSpans(spans.begin(),
+                                            spans.end(),
+                                            magnification,
+                                            *areaDataFile,
+                                            areas,
+                                            breaker);
   }
 
   bool Database::GetWayByOffset(const FileOffset& offset,
@@ -906,7 +1174,8 @@ namespace osmscout {
   }
 
   bool Database::GetWaysByOffset(const std::vector<FileOffset>& offsets,
-                                 std::vector<WayRef>& ways) const
+                                 std::vector<WayRef>& ways,
+                                 const BreakerRef& breaker) const
   {
     WayDataFileRef wayDataFile=GetWayDataFile();
 
@@ -916,7 +1185,45 @@ namespace osmscout {
 
     StopClock time;
 
-    bool result=wayDataFile->GetByOffset(offsets.begin(),offsets.end(),offsets.size(),ways);
+    bool result=wayDataFile->GetByOffset(offsets.begin(),offsets.end(),offsets.size(),ways,breaker);
+
+    if (time.GetMilliseconds()>100) {
+      log.Warn() << "Retrieving " << ways.size() << " ways by offset took " << time.ResultString();
+    }
+
+    return result;
+  }
+
+  /**
+   * Like GetWaysByOffset() but returns the simplified geometries for
+   * the given magnification, if the database holds them.
+   */
+  bool Database::GetWaysByOffset(const std::vector<FileOffset>& offsets,
+                                 const Magnification& magnification,
+                                 std::vector<WayRef>& ways,
+                                 const BreakerRef& breaker) const
+  {
+    WayDataFileRef wayDataFile=GetWayDataFile();
+
+    if (!wayDataFile) {
+      return false;
+    }
+
+    WayLODDataFileRef wayLODDataFile=GetWayLODDataFile();
+
+    if (!wayLODDataFile) {
+      return GetWaysByOffset(offsets,ways,breaker);
+    }
+
+    StopClock time;
+
+    bool result=wayLODDataFile->GetByOffset(offsets.begin(),
+                                            offsets.end(),
+                                            offsets.size(),
+                                            magnification,
+                                            *wayDataFile,
+                                            ways,
+                                            breaker);
 
     if (time.GetMilliseconds()>100) {
       log.Warn() << "Retrieving " << ways.size() << " ways by offset took " << time.ResultString();
@@ -0,0 +1,38 @@
+/*
+  This source is part of the libosmscout library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/LODDataFile.h>
+
+namespace osmscout {
+
+  const char* const WayLODDataFile::WAYSLOD_DAT="wayslod.dat";
+
+  WayLODDataFile::WayLODDataFile(size_t cacheSize)
+  : LODDataFile<Way>(WAYSLOD_DAT,cacheSize)
+  {
+    // no code
+  }
+
+  const char* const AreaLODDataFile::AREASLOD_DAT="areaslod.dat";
+
+  AreaLODDataFile::AreaLODDataFile(size_t cacheSize)
+  : LODDataFile<Area>(AREASLOD_DAT,cacheSize)
+  {
+    // no code
+  }
+}
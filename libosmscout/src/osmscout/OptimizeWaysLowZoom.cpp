@@ -144,12 +144,11 @@ namespace osmscout
     return magnification<=this->magnification;
   }
 
-  void OptimizeWaysLowZoom::GetOffsets(const TypeData& typeData,
+  void OptimizeWaysLowZoom::GetOffsets(FileCursor& cursor,
+                                       const TypeData& typeData,
                                        const GeoBox& boundingBox,
                                        std::set<FileOffset>& offsets) const
   {
-    std::lock_guard<std::mutex> guard(lookupMutex);
-
     if (typeData.bitmapOffset==0) {
       // No data for this type available
       return;
@@ -186,14 +185,14 @@ namespace osmscout
                                  ((y-typeData.cellYStart)*typeData.cellXCount+
                                   minxc-typeData.cellXStart)*typeData.dataOffsetBytes;
 
-      scanner.SetPos(cellIndexOffset);
+      cursor.SetPos(cellIndexOffset);
 
       // For each column in row
       for (size_t x=minxc; x<=maxxc; x++) {
         FileOffset cellDataOffset;
 
-        scanner.ReadFileOffset(cellDataOffset,
-                               typeData.dataOffsetBytes);
+        cursor.ReadFileOffset(cellDataOffset,
+                              typeData.dataOffsetBytes);
 
         if (cellDataOffset==0) {
           continue;
@@ -212,7 +211,7 @@ namespace osmscout
 
       assert(initialCellDataOffset>=cellIndexOffset);
 
-      scanner.SetPos(initialCellDataOffset);
+      cursor.SetPos(initialCellDataOffset);
 
       // For each data cell in row found
       for (size_t i=0; i<cellDataOffsetCount; i++) {
@@ -220,12 +219,12 @@ namespace osmscout
         FileOffset lastOffset=0;
 
 
-        scanner.ReadNumber(dataCount);
+        cursor.ReadNumber(dataCount);
 
         for (size_t d=0; d<dataCount; d++) {
           FileOffset objectOffset;
 
-          scanner.ReadNumber(objectOffset);
+          cursor.ReadNumber(objectOffset);
 
           objectOffset+=lastOffset;
 
@@ -287,6 +286,8 @@ namespace osmscout
     loadedWayTypes.Clear();
 
     try {
+      FileCursor cursor(scanner);
+
       for (const auto& type : wayTypesData) {
         if (wayTypes.IsSet(type.first)) {
           auto match=type.second.cend();
@@ -302,7 +303,8 @@ namespace osmscout
 
           if (match!=type.second.end()) {
             if (match->bitmapOffset!=0) {
-              GetOffsets(*match,
+              GetOffsets(cursor,
+                         *match,
                          boundingBox,
                          offsets);
             }
@@ -19,6 +19,9 @@
 
 #include <osmscout/Tag.h>
 
+#include <algorithm>
+#include <cstring>
+
 #include <osmscout/util/Logger.h>
 #include <osmscout/util/String.h>
 
@@ -31,6 +34,11 @@ namespace osmscout {
     // no code
   }
 
+  bool TagCondition::GetTriggerTags(std::vector<TagId>& /*tags*/) const
+  {
+    return false;
+  }
+
   TagNotCondition::TagNotCondition(const TagConditionRef& condition)
   : condition(condition)
   {
@@ -74,12 +82,59 @@ namespace osmscout {
     }
   }
 
+  bool TagBoolCondition::GetTriggerTags(std::vector<TagId>& tags) const
+  {
+    switch (type) {
+    case boolAnd: {
+      // Any child condition is sufficient, take the one with the least tags
+      bool                found=false;
+      std::vector<TagId>  bestTags;
+
+      for (const auto &condition : conditions) {
+        std::vector<TagId> childTags;
+
+        if (condition->GetTriggerTags(childTags) &&
+            (!found || childTags.size()<bestTags.size())) {
+          bestTags=std::move(childTags);
+          found=true;
+        }
+      }
+
+      if (found) {
+        tags.insert(tags.end(),bestTags.begin(),bestTags.end());
+      }
+
+      return found;
+    }
+    case boolOr:
+      // Every child condition must have trigger tags
+      for (const auto &condition : conditions) {
+        if (!condition->GetTriggerTags(tags)) {
+          return false;
+        }
+      }
+
+      return !conditions.empty();
+    default:
+      assert(false);
+
+      return false;
+    }
+  }
+
   TagExistsCondition::TagExistsCondition(TagId tag)
   : tag(tag)
   {
     // no code
   }
 
+  bool TagExistsCondition::GetTriggerTags(std::vector<TagId>& tags) const
+  {
+    tags.push_back(tag);
+
+    return true;
+  }
+
   TagBinaryCondition::TagBinaryCondition(TagId tag,
                                          BinaryOperator binaryOperator,
                                          const std::string& tagValue)
@@ -177,6 +232,13 @@ namespace osmscout {
     }
   }
 
+  bool TagBinaryCondition::GetTriggerTags(std::vector<TagId>& tags) const
+  {
+    tags.push_back(tag);
+
+    return true;
+  }
+
   TagIsInCondition::TagIsInCondition(TagId tag)
   : tag(tag)
   {
@@ -199,6 +261,13 @@ namespace osmscout {
     return tagValues.find(t->second)!=tagValues.end();
   }
 
+  bool TagIsInCondition::GetTriggerTags(std::vector<TagId>& tags) const
+  {
+    tags.push_back(tag);
+
+    return true;
+  }
+
   TagInfo::TagInfo(TagId id,
                    const std::string& name)
   : id(id),
@@ -207,6 +276,47 @@ namespace osmscout {
     // no code
   }
 
+  /**
+   * Hash of the tag name, calculated once per lookup. Consumes eight bytes
+   * per step.
+   */
+  static inline uint64_t HashTagName(const char* name,
+                                     size_t length)
+  {
+    uint64_t hash=length*0x9e3779b97f4a7c15ull;
+    uint64_t word;
+    size_t   i=0;
+
+    for (; i+8<=length; i+=8) {
+      std::memcpy(&word,name+i,8);
+      hash=(hash^word)*0xff51afd7ed558ccdull;
+      hash^=hash >> 32;
+    }
+
+    word=0;
+    std::memcpy(&word,name+i,length-i);
+    hash=(hash^word)*0xc4ceb9fe1a85ec53ull;
+    hash^=hash >> 29;
+
+    return hash;
+  }
+
+  /**
+   * Mixes the name hash with the displacement seed of its bucket
+   */
+  static inline uint64_t HashSlot(uint64_t hash,
+                                  uint32_t seed)
+  {
+    hash^=(uint64_t(seed)+1)*0x9e3779b97f4a7c15ull;
+    hash^=hash >> 30;
+    hash*=0xbf58476d1ce4e5b9ull;
+    hash^=hash >> 27;
+    hash*=0x94d049bb133111ebull;
+    hash^=hash >> 31;
+
+    return hash;
+  }
+
   TagRegistry::TagRegistry()
   : nextTagId(0)
   {
@@ -245,6 +355,10 @@ namespace osmscout {
     tags.push_back(tagInfo);
     stringToTagMap[tagInfo.GetName()]=tagInfo.GetId();
 
+    // The perfect hash does not know the new tag
+    hashSeeds.clear();
+    hashSlots.clear();
+
     return tagInfo.GetId();
   }
 
@@ -268,6 +382,11 @@ namespace osmscout {
 
   TagId TagRegistry::GetTagId(const char* name) const
   {
+    if (!hashSlots.empty()) {
+      return LookupTagId(name,
+                         std::strlen(name));
+    }
+
     auto iter=stringToTagMap.find(name);
 
     if (iter!=stringToTagMap.end()) {
@@ -280,6 +399,11 @@ namespace osmscout {
 
   TagId TagRegistry::GetTagId(const std::string& name) const
   {
+    if (!hashSlots.empty()) {
+      return LookupTagId(name.data(),
+                         name.length());
+    }
+
     auto iter=stringToTagMap.find(name);
 
     if (iter!=stringToTagMap.end()) {
@@ -290,6 +414,122 @@ namespace osmscout {
     }
   }
 
+  TagId TagRegistry::LookupTagId(const char* name,
+                                 size_t length) const
+  {
+    uint64_t    hash=HashTagName(name,length);
+    uint32_t    seed=hashSeeds[(hash >> 32u)%hashSeeds.size()];
+    TagId       tagId=hashSlots[HashSlot(hash,seed) & (hashSlots.size()-1)];
+    const auto& tagName=tags[tagId].GetName();
+
+    if (tagName.length()==length &&
+        std::memcmp(tagName.data(),name,length)==0) {
+      return tagId;
+    }
+
+    return tagIgnore;
+  }
+
+  /**
+   * Builds the table using "hash and displace": tags are distributed into
+   * buckets by their name hash. Starting with the biggest bucket, a seed is
+   * searched for every bucket that places all its tags into free slots.
+   * A lookup then costs one hash of the name and one string compare.
+   */
+  void TagRegistry::CompileLookupTable()
+  {
+    struct Key
+    {
+      uint64_t hash;
+      TagId    id;
+    };
+
+    hashSeeds.clear();
+    hashSlots.clear();
+
+    // Tag 0 is the empty tagIgnore and is not part of the table
+    if (tags.size()<=1) {
+      return;
+    }
+
+    size_t keyCount=tags.size()-1;
+    size_t slotCount=1;
+
+    while (slotCount<2*keyCount) {
+      slotCount*=2;
+    }
+
+    std::vector<std::vector<Key>> buckets(std::max(keyCount/2,size_t(1)));
+
+    for (const auto& tag : tags) {
+      if (tag.GetId()==tagIgnore) {
+        continue;
+      }
+
+      uint64_t hash=HashTagName(tag.GetName().data(),tag.GetName().length());
+
+      buckets[(hash >> 32u)%buckets.size()].push_back(Key{hash,tag.GetId()});
+    }
+
+    std::vector<size_t> bucketOrder(buckets.size());
+
+    for (size_t i=0; i<bucketOrder.size(); i++) {
+      bucketOrder[i]=i;
+    }
+
+    std::stable_sort(bucketOrder.begin(),bucketOrder.end(),[&buckets](size_t a, size_t b) {
+      return buckets[a].size()>buckets[b].size();
+    });
+
+    std::vector<uint32_t> seeds(buckets.size(),0);
+    std::vector<TagId>    slots(slotCount,tagIgnore);
+    std::vector<size_t>   bucketSlots;
+    const uint32_t        maxSeed=1u << 16u;
+
+    for (size_t bucketIndex : bucketOrder) {
+      const auto& bucket=buckets[bucketIndex];
+
+      if (bucket.empty()) {
+        break;
+      }
+
+      bool placed=false;
+
+      for (uint32_t seed=0; seed<maxSeed && !placed; seed++) {
+        bucketSlots.clear();
+        placed=true;
+
+        for (const auto& key : bucket) {
+          size_t slot=HashSlot(key.hash,seed) & (slotCount-1);
+
+          if (slots[slot]!=tagIgnore ||
+              std::find(bucketSlots.begin(),bucketSlots.end(),slot)!=bucketSlots.end()) {
+            placed=false;
+            break;
+          }
+
+          bucketSlots.push_back(slot);
+        }
+
+        if (placed) {
+          seeds[bucketIndex]=seed;
+
+          for (size_t i=0; i<bucket.size(); i++) {
+            slots[bucketSlots[i]]=bucket[i].id;
+          }
+        }
+      }
+
+      if (!placed) {
+        log.Warn() << "Cannot build perfect hash for tag names, using default lookup";
+        return;
+      }
+    }
+
+    hashSeeds=std::move(seeds);
+    hashSlots=std::move(slots);
+  }
+
   bool TagRegistry::IsNameTag(TagId tag, uint32_t& priority) const
   {
     if (nameTagIdToPrioMap.empty()) {
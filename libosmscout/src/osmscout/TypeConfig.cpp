@@ -356,14 +356,16 @@ namespace osmscout {
 
   FeatureValueBuffer::FeatureValueBuffer()
     : featureBits(nullptr),
-      featureValueBuffer(nullptr)
+      featureValueBuffer(nullptr),
+      valuesInArena(false)
   {
     // no code
   }
 
   FeatureValueBuffer::FeatureValueBuffer(const FeatureValueBuffer& other)
     : featureBits(nullptr),
-      featureValueBuffer(nullptr)
+      featureValueBuffer(nullptr),
+      valuesInArena(false)
   {
     Set(other);
   }
@@ -423,22 +425,37 @@ namespace osmscout {
         }
       }
 
-      ::operator delete((void*)featureValueBuffer);
+      if (!valuesInArena) {
+        ::operator delete((void*)featureValueBuffer);
+      }
       featureValueBuffer=nullptr;
+      valuesInArena=false;
     }
 
     if (featureBits!=nullptr) {
-      delete [] featureBits;
+      if (!arena) {
+        delete [] featureBits;
+      }
       featureBits=nullptr;
     }
 
+    // Arena memory is released together with the arena
+    arena=nullptr;
     type=nullptr;
   }
 
   void FeatureValueBuffer::AllocateBits()
   {
     if (type && type->HasFeatures()) {
-      featureBits=new uint8_t[type->GetFeatureMaskBytes()]();
+      arena=ArenaScope::GetCurrentArena();
+
+      if (arena) {
+        featureBits=static_cast<uint8_t*>(arena->Allocate(type->GetFeatureMaskBytes(),1));
+        std::fill(featureBits,featureBits+type->GetFeatureMaskBytes(),0);
+      }
+      else {
+        featureBits=new uint8_t[type->GetFeatureMaskBytes()]();
+      }
     }
     else
     {
@@ -451,7 +468,15 @@ namespace osmscout {
     if (featureValueBuffer==nullptr &&
         type &&
         type->HasFeatures()) {
-      featureValueBuffer=static_cast<char*>(::operator new(type->GetFeatureValueBufferSize()));
+      // The arena is not thread-safe, it may only be used while its scope is active
+      if (arena &&
+          ArenaScope::GetCurrentArena()==arena) {
+        featureValueBuffer=static_cast<char*>(arena->Allocate(type->GetFeatureValueBufferSize()));
+        valuesInArena=true;
+      }
+      else {
+        featureValueBuffer=static_cast<char*>(::operator new(type->GetFeatureValueBufferSize()));
+      }
     }
   }
 
@@ -810,11 +835,74 @@ namespace osmscout {
     }
   }
 
+  /**
+   * Candidate buffer of the condition dispatch, reused between calls to
+   * avoid an allocation per classified object
+   */
+  static thread_local std::vector<uint32_t> conditionCandidates;
+
+  void TypeConfig::ConditionDispatch::Clear()
+  {
+    entries.clear();
+    tagEntries.clear();
+    untaggedEntries.clear();
+  }
+
+  void TypeConfig::ConditionDispatch::Add(const TypeInfoRef& type,
+                                          const TypeInfo::TypeCondition& condition)
+  {
+    uint32_t           index=static_cast<uint32_t>(entries.size());
+    std::vector<TagId> triggerTags;
+
+    entries.push_back(Entry{type,condition.types,condition.condition});
+
+    if (!condition.condition->GetTriggerTags(triggerTags)) {
+      untaggedEntries.push_back(index);
+
+      return;
+    }
+
+    for (TagId tag : triggerTags) {
+      if (tag>=tagEntries.size()) {
+        tagEntries.resize(tag+1);
+      }
+
+      // The same tag may be part of multiple sub conditions
+      if (tagEntries[tag].empty() ||
+          tagEntries[tag].back()!=index) {
+        tagEntries[tag].push_back(index);
+      }
+    }
+  }
+
+  void TypeConfig::ConditionDispatch::GetCandidates(const TagMap& tagMap,
+                                                    std::vector<uint32_t>& candidates) const
+  {
+    candidates.assign(untaggedEntries.begin(),
+                      untaggedEntries.end());
+
+    for (const auto& tag : tagMap) {
+      if (tag.first<tagEntries.size()) {
+        candidates.insert(candidates.end(),
+                          tagEntries[tag.first].begin(),
+                          tagEntries[tag.first].end());
+      }
+    }
+
+    // Conditions must be evaluated in order of their definition
+    if (candidates.size()>1) {
+      std::sort(candidates.begin(),candidates.end());
+      candidates.erase(std::unique(candidates.begin(),candidates.end()),
+                       candidates.end());
+    }
+  }
+
   TypeConfig::TypeConfig()
    : nodeTypeIdBytes(1),
      wayTypeIdBytes(1),
      areaTypeIdBits(1),
-     areaTypeIdBytes(1)
+     areaTypeIdBytes(1),
+     conditionsCompiled(false)
   {
     log.Debug() << "TypeConfig::TypeConfig()";
 
@@ -994,6 +1082,9 @@ namespace osmscout {
       return existingType->second;
     }
 
+    // Dispatch tables do not know the new type
+    conditionsCompiled=false;
+
     // All ways have a layer
     if (typeInfo->CanBeWay()) {
       if (!typeInfo->HasFeature(LayerFeature::NAME)) {
@@ -1151,6 +1242,23 @@ namespace osmscout {
       return typeInfoIgnore;
     }
 
+    if (conditionsCompiled) {
+      std::vector<uint32_t>& candidates=conditionCandidates;
+
+      nodeConditions.GetCandidates(tagMap,
+                                   candidates);
+
+      for (uint32_t index : candidates) {
+        const auto& entry=nodeConditions.entries[index];
+
+        if (entry.condition->Evaluate(tagMap)) {
+          return entry.type;
+        }
+      }
+
+      return typeInfoIgnore;
+    }
+
     for (const auto &type : types) {
       if (!type->HasConditions() ||
           !type->CanBeNode()) {
@@ -1182,6 +1290,31 @@ namespace osmscout {
       return false;
     }
 
+    if (conditionsCompiled) {
+      std::vector<uint32_t>& candidates=conditionCandidates;
+
+      wayAreaConditions.GetCandidates(tagMap,
+                                      candidates);
+
+      for (uint32_t index : candidates) {
+        const auto& entry=wayAreaConditions.entries[index];
+
+        if (entry.condition->Evaluate(tagMap)) {
+          if (entry.types & TypeInfo::typeWay) {
+            wayType=entry.type;
+          }
+
+          if (entry.types & TypeInfo::typeArea) {
+            areaType=entry.type;
+          }
+
+          return true;
+        }
+      }
+
+      return false;
+    }
+
     for (const auto& type : types) {
       if (!((type->CanBeWay() ||
              type->CanBeArea()) &&
@@ -1224,9 +1357,28 @@ namespace osmscout {
     }
 
     auto relationType=tagMap.find(tagType);
+    bool isMultipolygon=relationType!=tagMap.end() &&
+                        relationType->second=="multipolygon";
+
+    if (conditionsCompiled) {
+      const ConditionDispatch& dispatch=isMultipolygon ? multipolygonConditions : relationConditions;
+      std::vector<uint32_t>&   candidates=conditionCandidates;
+
+      dispatch.GetCandidates(tagMap,
+                             candidates);
+
+      for (uint32_t index : candidates) {
+        const auto& entry=dispatch.entries[index];
+
+        if (entry.condition->Evaluate(tagMap)) {
+          return entry.type;
+        }
+      }
+
+      return typeInfoIgnore;
+    }
 
-    if (relationType!=tagMap.end() &&
-        relationType->second=="multipolygon") {
+    if (isMultipolygon) {
       for (const auto& type : types) {
         if (!type->HasConditions() ||
             !type->CanBeArea()) {
@@ -1266,6 +1418,47 @@ namespace osmscout {
     return typeInfoIgnore;
   }
 
+  void TypeConfig::CompileLookupTables()
+  {
+    tagRegistry.CompileLookupTable();
+
+    nodeConditions.Clear();
+    wayAreaConditions.Clear();
+    multipolygonConditions.Clear();
+    relationConditions.Clear();
+
+    // Same filtering and order as in the linear search of the Get*Type() methods
+    for (const auto& type : types) {
+      if (!type->HasConditions()) {
+        continue;
+      }
+
+      for (const auto& cond : type->GetConditions()) {
+        if (type->CanBeNode() &&
+            (cond.types & TypeInfo::typeNode)) {
+          nodeConditions.Add(type,cond);
+        }
+
+        if ((type->CanBeWay() || type->CanBeArea()) &&
+            ((cond.types & TypeInfo::typeWay) || (cond.types & TypeInfo::typeArea))) {
+          wayAreaConditions.Add(type,cond);
+        }
+
+        if (type->CanBeArea() &&
+            (cond.types & TypeInfo::typeArea)) {
+          multipolygonConditions.Add(type,cond);
+        }
+
+        if (type->CanBeRelation() &&
+            (cond.types & TypeInfo::typeRelation)) {
+          relationConditions.Add(type,cond);
+        }
+      }
+    }
+
+    conditionsCompiled=true;
+  }
+
   /**
    * Loads the type configuration from the given *.ost file.
    *
@@ -1315,6 +1508,10 @@ namespace osmscout {
 
       delete parser;
       delete scanner;
+
+      if (success) {
+        CompileLookupTables();
+      }
     }
     catch (IOException& e) {
       log.Error() << e.GetDescription();
@@ -31,7 +31,10 @@ namespace osmscout {
 
   const char* const WaterIndex::WATER_IDX="water.idx";
 
+  const size_t WaterIndex::cellTemplateCacheSize;
+
   WaterIndex::WaterIndex()
+  : cellTemplateCache(cellTemplateCacheSize)
   {
     // no code
   }
@@ -45,6 +48,12 @@ namespace osmscout {
   {
     datafilename=AppendFileToDir(path,WATER_IDX);
 
+    {
+      std::lock_guard<std::mutex> guard(cellTemplateCacheMutex);
+
+      cellTemplateCache.Flush();
+    }
+
     try {
       scanner.Open(datafilename,FileScanner::FastRandom,memoryMappedData);
 
@@ -159,6 +168,50 @@ namespace osmscout {
     }
   }
 
+  /**
+   * Reads the ground tiles of the coast cell with data at the given offset
+   */
+  void WaterIndex::ReadCellTemplate(FileCursor& cursor,
+                                    FileOffset offset,
+                                    std::vector<GroundTile>& cellTiles) const
+  {
+    uint32_t tileCount;
+
+    cursor.SetPos(offset);
+    cursor.ReadNumber(tileCount);
+
+    cellTiles.resize(tileCount+1);
+
+    // The cell itself, the following tiles define its land and water parts
+    cellTiles[0].type=GroundTile::coast;
+
+    for (size_t t=1; t<=tileCount; t++) {
+      GroundTile& tile=cellTiles[t];
+      uint8_t     tileType;
+      uint32_t    coordCount;
+
+      cursor.Read(tileType);
+
+      tile.type=(GroundTile::Type)tileType;
+
+      cursor.ReadNumber(coordCount);
+
+      tile.coords.resize(coordCount);
+
+      for (size_t n=0; n<coordCount; n++) {
+        uint16_t x;
+        uint16_t y;
+
+        cursor.Read(x);
+        cursor.Read(y);
+
+        tile.coords[n].Set(x & ~(1 << 15),
+                           y,
+                           (x & (1 << 15))!=0);
+      }
+    }
+  }
+
   void WaterIndex::GetGroundTileFromData(const Level& level,
                                           uint32_t cx1,
                                           uint32_t cx2,
@@ -166,9 +219,9 @@ namespace osmscout {
                                           uint32_t cy2,
                                           std::list<GroundTile>& tiles) const
   {
+    FileCursor cursor(scanner);
     GroundTile tile;
 
-    tile.coords.reserve(5);
     tile.cellWidth=level.cellWidth;
     tile.cellHeight=level.cellHeight;
 
@@ -192,67 +245,71 @@ namespace osmscout {
             y<level.cellYStart ||
             y>level.cellYEnd) {
           tile.type=GroundTile::unknown;
-          tile.coords.clear();
 
           tiles.push_back(tile);
+
+          continue;
         }
-        else {
-          std::lock_guard<std::mutex> guard(lookupMutex);
-          uint32_t                    cellId=(y-level.cellYStart)*level.cellXCount+x-level.cellXStart;
-          uint32_t                    index=cellId*level.dataOffsetBytes;
-          FileOffset                  cell;
 
-          scanner.SetPos(level.indexDataOffset+index);
+        uint32_t   cellId=(y-level.cellYStart)*level.cellXCount+x-level.cellXStart;
+        uint32_t   index=cellId*level.dataOffsetBytes;
+        FileOffset cell;
 
-          scanner.ReadFileOffset(cell,level.dataOffsetBytes);
+        cursor.SetPos(level.indexDataOffset+index);
 
-          if (cell==(FileOffset)GroundTile::land ||
-              cell==(FileOffset)GroundTile::water ||
-              cell==(FileOffset)GroundTile::coast ||
-              cell==(FileOffset)GroundTile::unknown) {
-            tile.type=(GroundTile::Type)cell;
-            tile.coords.clear();
+        cursor.ReadFileOffset(cell,level.dataOffsetBytes);
 
-            tiles.push_back(tile);
-          }
-          else {
-            uint32_t tileCount;
+        // Fast path for cells completely of one type, there is no cell data to decode
+        if (cell==(FileOffset)GroundTile::land ||
+            cell==(FileOffset)GroundTile::water ||
+            cell==(FileOffset)GroundTile::coast ||
+            cell==(FileOffset)GroundTile::unknown) {
+          tile.type=(GroundTile::Type)cell;
 
-            tile.type=GroundTile::coast;
-            tile.coords.clear();
+          tiles.push_back(tile);
 
-            tiles.push_back(tile);
+          continue;
+        }
 
-            scanner.SetPos(level.dataOffset+cell);
-            scanner.ReadNumber(tileCount);
+        FileOffset      cellDataOffset=level.dataOffset+cell;
+        CellTemplateRef cellTiles;
 
-            for (size_t t=0; t<tileCount; t++) {
-              uint8_t  tileType;
-              uint32_t coordCount;
+        {
+          std::lock_guard<std::mutex>  guard(cellTemplateCacheMutex);
+          CellTemplateCache::CacheRef cacheRef;
 
-              scanner.Read(tileType);
+          if (cellTemplateCache.GetEntry(cellDataOffset,cacheRef)) {
+            cellTiles=cacheRef->value;
+          }
+        }
 
-              tile.type=(GroundTile::Type)tileType;
+        if (!cellTiles) {
+          // Decode the cell without holding the lock, other lookups may proceed meanwhile
+          std::shared_ptr<std::vector<GroundTile>> decodedTiles=std::make_shared<std::vector<GroundTile>>();
 
-              scanner.ReadNumber(coordCount);
+          ReadCellTemplate(cursor,
+                           cellDataOffset,
+                           *decodedTiles);
 
-              tile.coords.resize(coordCount);
+          cellTiles=decodedTiles;
 
-              for (size_t n=0; n<coordCount; n++) {
-                uint16_t x;
-                uint16_t y;
+          std::lock_guard<std::mutex>   guard(cellTemplateCacheMutex);
+          CellTemplateCache::CacheEntry cacheEntry(cellDataOffset,cellTiles);
 
-                scanner.Read(x);
-                scanner.Read(y);
+          cellTemplateCache.SetEntry(cacheEntry);
+        }
 
-                tile.coords[n].Set(x & ~(1 << 15),
-                                   y,
-                                   (x & (1 << 15))!=0);
-              }
+        for (const auto& cellTile : *cellTiles) {
+          tiles.push_back(cellTile);
 
-              tiles.push_back(tile);
-            }
-          }
+          GroundTile& groundTile=tiles.back();
+
+          groundTile.xAbs=tile.xAbs;
+          groundTile.yAbs=tile.yAbs;
+          groundTile.xRel=tile.xRel;
+          groundTile.yRel=tile.yRel;
+          groundTile.cellWidth=tile.cellWidth;
+          groundTile.cellHeight=tile.cellHeight;
         }
       }
     }
@@ -313,9 +370,8 @@ namespace osmscout {
 
   void WaterIndex::DumpStatistics()
   {
-    size_t entries=0;
-    size_t memory=0;
+    std::lock_guard<std::mutex> guard(cellTemplateCacheMutex);
 
-    log.Info() << "WaterIndex size " << entries << ", memory " << memory;
+    cellTemplateCache.DumpStatistics(WATER_IDX,CellTemplateCacheValueSizer());
   }
 }
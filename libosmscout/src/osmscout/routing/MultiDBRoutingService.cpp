@@ -30,6 +30,7 @@
 #include <osmscout/Pixel.h>
 
 #include <osmscout/system/Assert.h>
+#include <osmscout/util/File.h>
 
 #include <osmscout/util/Geometry.h>
 #include <osmscout/util/Logger.h>
@@ -95,6 +96,19 @@ namespace osmscout {
 
       handle.routingDatabase=routingDatabase;
 
+      // The coverage index is optional, without it the database is asked for every position
+      CoverageIndexRef coverageIndex;
+
+      if (ExistsInFilesystem(AppendFileToDir(handle.database->GetPath(),CoverageIndex::COVERAGE_IDX))) {
+        coverageIndex=std::make_shared<CoverageIndex>();
+
+        if (!coverageIndex->Open(handle.database->GetPath())) {
+          coverageIndex.reset();
+        }
+      }
+
+      coverageDirectory.AddDatabase(handle.dbId,
+                                    coverageIndex);
     }
 
     return true;
@@ -114,15 +128,23 @@ namespace osmscout {
       handle.profile.reset();
     }
 
+    coverageDirectory.Clear();
+
     isOpen=false;
   }
 
   RoutePositionResult MultiDBRoutingService::GetClosestRoutableNode(const GeoCoord& coord,
                                                                     const Distance &radius) const
   {
-    RoutePositionResult position, closestPosition;
+    RoutePositionResult     position, closestPosition;
+    std::vector<DatabaseId> databases;
+
+    coverageDirectory.GetDatabases(GeoBox::BoxByCenterAndRadius(coord,radius),
+                                   databases);
+
+    for (DatabaseId dbId : databases) {
+      const DatabaseHandle& handle=handles[dbId];
 
-    for (auto& handle : handles) {
       position=handle.router->GetClosestRoutableNode(coord,
                                                      *handle.profile,
                                                      radius);
@@ -0,0 +1,97 @@
+/*
+  This source is part of the libosmscout library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/util/Arena.h>
+
+#include <cassert>
+#include <cstdint>
+#include <new>
+
+namespace osmscout {
+
+  static thread_local ArenaRef currentArena;
+
+  Arena::Arena(size_t blockSize)
+  : blockSize(blockSize),
+    current(nullptr),
+    remaining(0),
+    allocationCount(0),
+    allocatedBytes(0)
+  {
+    // no code
+  }
+
+  Arena::~Arena()
+  {
+    for (char* block : blocks) {
+      ::operator delete((void*)block);
+    }
+  }
+
+  void* Arena::Allocate(size_t size,
+                        size_t alignment)
+  {
+    assert(alignment<=alignof(std::max_align_t));
+
+    allocationCount++;
+    allocatedBytes+=size;
+
+    // Big allocations get their own block, so that the current block is not wasted
+    if (size>blockSize/4) {
+      char* block=static_cast<char*>(::operator new(size));
+
+      blocks.push_back(block);
+
+      return block;
+    }
+
+    size_t padding=(alignment-reinterpret_cast<std::uintptr_t>(current)%alignment)%alignment;
+
+    if (current==nullptr ||
+        padding+size>remaining) {
+      current=static_cast<char*>(::operator new(blockSize));
+      remaining=blockSize;
+      padding=0;
+
+      blocks.push_back(current);
+    }
+
+    char* result=current+padding;
+
+    current+=padding+size;
+    remaining-=padding+size;
+
+    return result;
+  }
+
+  ArenaScope::ArenaScope(const ArenaRef& arena)
+  : previous(currentArena)
+  {
+    currentArena=arena;
+  }
+
+  ArenaScope::~ArenaScope()
+  {
+    currentArena=previous;
+  }
+
+  const ArenaRef& ArenaScope::GetCurrentArena()
+  {
+    return currentArena;
+  }
+}
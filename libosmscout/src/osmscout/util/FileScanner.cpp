@@ -25,6 +25,7 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <algorithm>
 #include <limits>
 
 #if defined(HAVE_MMAP)
@@ -32,6 +33,10 @@
   #include <sys/mman.h>
 #endif
 
+#if defined(HAVE_PREAD)
+  #include <unistd.h>
+#endif
+
 #if defined(HAVE_FCNTL_H)
   #include <fcntl.h>
 #endif
@@ -434,6 +439,85 @@ namespace osmscout {
 #endif
   }
 
+  /**
+   * Reads the given number of bytes starting at the given file position into the buffer.
+   *
+   * In contrast to the other read methods the position of the reading cursor and the
+   * error state of the scanner are not changed, so the method can be called by multiple
+   * threads at the same time. It must not be mixed with concurrent sequential reading
+   * or closing of the scanner.
+   *
+   * throws IOException on error
+   */
+  void FileScanner::ReadAt(FileOffset pos,
+                           char* buffer,
+                           size_t bytes) const
+  {
+    if (file==nullptr) {
+      throw IOException(filename,"Cannot read byte array","File not open");
+    }
+
+    if (pos+bytes>size) {
+      throw IOException(filename,"Cannot read byte array at "+std::to_string(pos),"Cannot read beyond end of file");
+    }
+
+#if defined(HAVE_MMAP) || defined(_WIN32)
+    if (this->buffer!=nullptr) {
+      memcpy(buffer,&this->buffer[pos],bytes);
+
+      return;
+    }
+#endif
+
+#if defined(HAVE_PREAD)
+    size_t done=0;
+
+    while (done<bytes) {
+      ssize_t result=pread(fileno(file),buffer+done,bytes-done,(off_t)(pos+done));
+
+      if (result<0 && errno==EINTR) {
+        continue;
+      }
+
+      if (result<=0) {
+        throw IOException(filename,"Cannot read byte array at "+std::to_string(pos));
+      }
+
+      done+=(size_t)result;
+    }
+#else
+    // Without pread() we have to move the stream position and restore it afterwards
+    std::lock_guard<std::mutex> guard(positionalMutex);
+
+#if defined(HAVE_FSEEKO)
+    off_t oldPos=ftello(file);
+    bool  success=oldPos!=-1 &&
+                  fseeko(file,(off_t)pos,SEEK_SET)==0 &&
+                  fread(buffer,1,bytes,file)==bytes;
+
+    success=fseeko(file,oldPos,SEEK_SET)==0 && success;
+#elif defined(HAVE__FSEEKI64) && defined(HAVE__FTELLI64)
+    __int64 oldPos=_ftelli64(file);
+    bool    success=oldPos!=-1 &&
+                    _fseeki64(file,(__int64)pos,SEEK_SET)==0 &&
+                    fread(buffer,1,bytes,file)==bytes;
+
+    success=_fseeki64(file,oldPos,SEEK_SET)==0 && success;
+#else
+    long oldPos=ftell(file);
+    bool success=oldPos!=-1 &&
+                 fseek(file,(long)pos,SEEK_SET)==0 &&
+                 fread(buffer,1,bytes,file)==bytes;
+
+    success=fseek(file,oldPos,SEEK_SET)==0 && success;
+#endif
+
+    if (!success) {
+      throw IOException(filename,"Cannot read byte array at "+std::to_string(pos));
+    }
+#endif
+  }
+
   char* FileScanner::ReadInternal(size_t bytes)
   {
     if (HasError()) {
@@ -2500,6 +2584,139 @@ namespace osmscout {
     return refs;
   }
 
+  const size_t FileCursor::blockSize;
+
+  FileCursor::FileCursor(const FileScanner& scanner,
+                         FileOffset pos)
+  : scanner(scanner),
+    pos(pos),
+    data(nullptr),
+    dataStart(0),
+    dataSize(0)
+  {
+#if defined(HAVE_MMAP) || defined(_WIN32)
+    if (scanner.buffer!=nullptr) {
+      data=scanner.buffer;
+      dataSize=(size_t)scanner.size;
+    }
+#endif
+  }
+
+  /**
+   * Makes the given number of bytes at the current position accessible
+   * by reading the block starting at the current position into the buffer.
+   *
+   * throws IOException on error
+   */
+  void FileCursor::Fill(size_t bytes)
+  {
+    if (pos+bytes>scanner.size) {
+      throw IOException(scanner.filename,"Cannot read at "+std::to_string(pos),"Cannot read beyond end of file");
+    }
+
+    size_t blockBytes=(size_t)std::min((FileOffset)std::max(bytes,blockSize),
+                                       scanner.size-pos);
+
+    if (buffer.size()<blockBytes) {
+      buffer.resize(blockBytes);
+    }
+
+    scanner.ReadAt(pos,buffer.data(),blockBytes);
+
+    data=buffer.data();
+    dataStart=pos;
+    dataSize=blockBytes;
+  }
+
+  void FileCursor::Read(uint8_t& number)
+  {
+    number=(uint8_t)*Fetch(1);
+  }
+
+  void FileCursor::Read(uint16_t& number)
+  {
+    const char* dataPtr=Fetch(2);
+
+    number=(uint16_t)((unsigned char)dataPtr[0] | ((unsigned char)dataPtr[1] << 8));
+  }
+
+  void FileCursor::ReadFileOffset(FileOffset& fileOffset,
+                                  size_t bytes)
+  {
+    assert(bytes>0 && bytes<=8);
+
+    const char* dataPtr=Fetch(bytes);
+
+    fileOffset=0;
+
+    for (size_t i=0; i<bytes; i++) {
+      fileOffset|=((FileOffset)(unsigned char)dataPtr[i]) << (i*8);
+    }
+  }
+
+  void FileCursor::ReadNumber(uint32_t& number)
+  {
+    unsigned int shift=0;
+    char         byte;
+
+    number=0;
+
+    do {
+      byte=*Fetch(1);
+
+      number|=static_cast<uint32_t>(byte & 0x7f) << shift;
+
+      shift+=7;
+    } while ((byte & 0x80)!=0);
+  }
+
+  void FileCursor::ReadNumber(uint64_t& number)
+  {
+    unsigned int shift=0;
+    char         byte;
+
+    number=0;
+
+    do {
+      byte=*Fetch(1);
+
+      number|=static_cast<uint64_t>(byte & 0x7f) << shift;
+
+      shift+=7;
+    } while ((byte & 0x80)!=0);
+  }
+
+  void FileCursor::ReadCoord(GeoCoord& coord)
+  {
+    coord.DecodeFromBuffer((const unsigned char*)Fetch(coordByteSize));
+  }
+
+  void FileCursor::ReadTypeId(TypeId& id,
+                              uint8_t maxBytes)
+  {
+    if (maxBytes==1) {
+      uint8_t byteValue;
+
+      Read(byteValue);
+
+      id=byteValue;
+    }
+    else if (maxBytes==2) {
+      uint8_t byteValue;
+
+      Read(byteValue);
+
+      id=byteValue *256;
+
+      Read(byteValue);
+
+      id+=byteValue;
+    }
+    else {
+      assert(false);
+    }
+  }
+
   ObjectFileRefStreamReader::ObjectFileRefStreamReader(FileScanner& reader)
   : reader(reader),
     lastFileOffset(0)
@@ -38,10 +38,14 @@
 namespace osmscout {
 
   const uint64_t FileWriter::MAX_NODES=0x03FFFFFF; // 26 bits
+  const size_t   FileWriter::DEFAULT_WRITE_BEHIND_SIZE=4*1024*1024;
 
   FileWriter::FileWriter()
    : file(nullptr),
-     hasError(true)
+     hasError(true),
+     writeBehindSize(0),
+     bufferOffset(0),
+     bufferPos(0)
   {
     // no code
   }
@@ -55,10 +59,127 @@ namespace osmscout {
   }
 
   /**
+   * Write the given data either directly to the file or to the write-behind buffer.
+   * Returns the number of written elements, like fwrite().
+   */
+  size_t FileWriter::WriteData(const void* data,
+                               size_t size,
+                               size_t count)
+  {
+    if (writeBehindSize==0) {
+      return fwrite(data,size,count,file);
+    }
+
+    const char* bytes=static_cast<const char*>(data);
+    size_t      length=size*count;
+
+    if (bufferPos==writeBehindBuffer.size() &&
+        !writeBehindBuffer.empty() &&
+        writeBehindBuffer.size()+length>writeBehindSize) {
+      if (!StartBufferWrite()) {
+        return 0;
+      }
+    }
+
+    // After seeking back, data in the buffer is overwritten first
+    size_t overlap=std::min(length,writeBehindBuffer.size()-bufferPos);
+
+    std::copy(bytes,bytes+overlap,writeBehindBuffer.begin()+bufferPos);
+    writeBehindBuffer.insert(writeBehindBuffer.end(),bytes+overlap,bytes+length);
+    bufferPos+=length;
+
+    return count;
+  }
+
+  /**
+   * Executed by the background task: Write writeBuffer to the given file offset.
+   * The caller does not access the file while the task is running.
+   */
+  bool FileWriter::WriteBuffer(FileOffset offset)
+  {
+#if defined(HAVE_FSEEKO)
+    if (fseeko(file,(off_t)offset,SEEK_SET)!=0) {
+      return false;
+    }
+#elif defined(HAVE__FTELLI64)
+    if (_fseeki64(file,(__int64)offset,SEEK_SET)!=0) {
+      return false;
+    }
+#else
+    if (fseek(file,offset,SEEK_SET)!=0) {
+      return false;
+    }
+#endif
+
+    return fwrite(writeBuffer.data(),
+                  sizeof(char),
+                  writeBuffer.size(),
+                  file)==writeBuffer.size();
+  }
+
+  /**
+   * Hand over the current buffer to the background task and continue with an empty buffer
+   */
+  bool FileWriter::StartBufferWrite()
+  {
+    if (!WaitForBufferWrite()) {
+      return false;
+    }
+
+    std::swap(writeBehindBuffer,writeBuffer);
+
+    FileOffset offset=bufferOffset;
+
+    bufferOffset+=writeBuffer.size();
+    bufferPos=0;
+    writeBehindBuffer.reserve(writeBehindSize);
+
+    pendingWrite=std::async(std::launch::async,
+                            &FileWriter::WriteBuffer,this,
+                            offset);
+
+    return true;
+  }
+
+  bool FileWriter::WaitForBufferWrite()
+  {
+    if (!pendingWrite.valid()) {
+      return true;
+    }
+
+    bool result=pendingWrite.get();
+
+    writeBuffer.clear();
+
+    return result;
+  }
+
+  /**
+   * Write all buffered data and wait until it is written
+   */
+  bool FileWriter::FlushBuffer()
+  {
+    if (writeBehindSize==0) {
+      return true;
+    }
+
+    if (!writeBehindBuffer.empty() &&
+        !StartBufferWrite()) {
+      WaitForBufferWrite();
+      return false;
+    }
+
+    return WaitForBufferWrite();
+  }
+
+  /**
+   * Open the given file for writing. If writeBehindSize is not 0, data is collected
+   * in buffers of the given size and written by a background task.
    *
    * @throws IOException
    */
-  void FileWriter::Open(const std::string& filename)
+  void FileWriter::Open(const std::string& filename,
+                        size_t writeBehindSize)
   {
     if (file!=nullptr) {
       throw IOException(filename,"Error opening file for writing","File already opened");
@@ -73,6 +194,12 @@ namespace osmscout {
       throw IOException(filename,"Error opening file for writing");
     }
 
+    this->writeBehindSize=writeBehindSize;
+    bufferOffset=0;
+    bufferPos=0;
+    writeBehindBuffer.clear();
+    writeBehindBuffer.reserve(writeBehindSize);
+
     hasError=false;
   }
 
@@ -86,7 +213,10 @@ namespace osmscout {
       throw IOException(filename,"Cannot close file","File already closed");
     }
 
-    if (fclose(file)!=0) {
+    bool flushed=hasError || FlushBuffer();
+
+    if (fclose(file)!=0 ||
+        !flushed) {
       file=nullptr;
       throw IOException(filename,"Cannot close file");
     }
@@ -100,6 +230,8 @@ namespace osmscout {
       return;
     }
 
+    FlushBuffer();
+
     fclose(file);
 
     file=nullptr;
@@ -121,6 +253,10 @@ namespace osmscout {
       throw IOException(filename,"Cannot read position in file","File already in error state");
     }
 
+    if (writeBehindSize>0) {
+      return bufferOffset+bufferPos;
+    }
+
 #if defined(HAVE_FSEEKO)
     off_t filepos=ftello(file);
 
@@ -162,6 +298,26 @@ namespace osmscout {
       throw IOException(filename,"Cannot read position in file","File already in error state");
     }
 
+    if (writeBehindSize>0) {
+      // Positions within the current buffer are patched in memory
+      if (pos>=bufferOffset &&
+          pos<=bufferOffset+writeBehindBuffer.size()) {
+        bufferPos=pos-bufferOffset;
+        return;
+      }
+
+      hasError=!FlushBuffer();
+
+      if (hasError) {
+        throw IOException(filename,"Cannot set position in file");
+      }
+
+      bufferOffset=pos;
+      bufferPos=0;
+
+      return;
+    }
+
 #if defined(HAVE_FSEEKO)
     hasError=fseeko(file,(off_t)pos,SEEK_SET)!=0;
 #elif defined(HAVE__FTELLI64)
@@ -195,7 +351,7 @@ namespace osmscout {
       throw IOException(filename,"Cannot write char*","File already in error state");
     }
 
-    hasError=fwrite(buffer,sizeof(char),bytes,file)!=bytes;
+    hasError=WriteData(buffer,sizeof(char),bytes)!=bytes;
 
     if (hasError) {
       throw IOException(filename,"Cannot write char*");
@@ -214,7 +370,7 @@ namespace osmscout {
 
     size_t length=value.length()+1;
 
-    hasError=fwrite(value.c_str(),sizeof(char),length,file)!=length;
+    hasError=WriteData(value.c_str(),sizeof(char),length)!=length;
 
     if (hasError) {
       throw IOException(filename,"Cannot write std::string");
@@ -233,7 +389,7 @@ namespace osmscout {
 
     char value=boolean ? (char)1 : (char)0;
 
-    hasError=fwrite((const char*)&value,sizeof(char),1,file)!=1;
+    hasError=WriteData((const char*)&value,sizeof(char),1)!=1;
 
     if (hasError) {
       throw IOException(filename,"Cannot write bool");
@@ -250,7 +406,7 @@ namespace osmscout {
       throw IOException(filename,"Cannot write int8_t","File already in error state");
     }
 
-    hasError=fwrite(&number,sizeof(char),sizeof(int8_t),file)!=sizeof(int8_t);
+    hasError=WriteData(&number,sizeof(char),sizeof(int8_t))!=sizeof(int8_t);
 
     if (hasError) {
       throw IOException(filename,"Cannot write int8_t");
@@ -272,7 +428,7 @@ namespace osmscout {
     buffer[0]=((number >> 0u) & 0xff);
     buffer[1]=((number >> 8u) & 0xff);
 
-    hasError=fwrite(buffer,1,2,file)!=2;
+    hasError=WriteData(buffer,1,2)!=2;
 
     if (hasError) {
       throw IOException(filename,"Cannot write int16_t");
@@ -296,7 +452,7 @@ namespace osmscout {
     buffer[2]=((number >> 16u) & 0xff);
     buffer[3]=((number >> 24u) & 0xff);
 
-    hasError=fwrite(buffer,1,4,file)!=4;
+    hasError=WriteData(buffer,1,4)!=4;
 
     if (hasError) {
       throw IOException(filename,"Cannot write int32_t");
@@ -324,7 +480,7 @@ namespace osmscout {
     buffer[6]=((number >> 48u) & 0xff);
     buffer[7]=((number >> 56u) & 0xff);
 
-    hasError=fwrite(buffer,1,8,file)!=8;
+    hasError=WriteData(buffer,1,8)!=8;
 
     if (hasError) {
       throw IOException(filename,"Cannot write int64_t");
@@ -341,7 +497,7 @@ namespace osmscout {
       throw IOException(filename,"Cannot write uint8_t","File already in error state");
     }
 
-    hasError=fwrite(&number,1,1,file)!=1;
+    hasError=WriteData(&number,1,1)!=1;
 
     if (hasError) {
       throw IOException(filename,"Cannot write uint8_t");
@@ -363,7 +519,7 @@ namespace osmscout {
     buffer[0]=((number >> 0u) & 0xff);
     buffer[1]=((number >> 8u) & 0xff);
 
-    hasError=fwrite(buffer,1,2,file)!=2;
+    hasError=WriteData(buffer,1,2)!=2;
 
     if (hasError) {
       throw IOException(filename,"Cannot write uint16_t");
@@ -387,7 +543,7 @@ namespace osmscout {
     buffer[2]=uint8_t((number >> 16u) & 0xff);
     buffer[3]=uint8_t((number >> 24u) & 0xff);
 
-    hasError=fwrite(buffer,1,4,file)!=4;
+    hasError=WriteData(buffer,1,4)!=4;
 
     if (hasError) {
       throw IOException(filename,"Cannot write uint32_t");
@@ -415,7 +571,7 @@ namespace osmscout {
     buffer[6]=uint8_t((number >> 48u) & 0xff);
     buffer[7]=uint8_t((number >> 56u) & 0xff);
 
-    hasError=fwrite(buffer,1,8,file)!=8;
+    hasError=WriteData(buffer,1,8)!=8;
 
     if (hasError) {
       throw IOException(filename,"Cannot write uint64_t");
@@ -437,7 +593,7 @@ namespace osmscout {
     buffer[0]=uint8_t((number >> 0u) & 0xff);
     buffer[1]=uint8_t((number >> 8u) & 0xff);
 
-    hasError=fwrite(buffer,1,bytes,file)!=bytes;
+    hasError=WriteData(buffer,1,bytes)!=bytes;
 
     if (hasError) {
       throw IOException(filename,"Cannot write size restricted uint16_t");
@@ -461,7 +617,7 @@ namespace osmscout {
     buffer[2]=uint8_t((number >> 16u) & 0xff);
     buffer[3]=uint8_t((number >> 24u) & 0xff);
 
-    hasError=fwrite(buffer,1,bytes,file)!=bytes;
+    hasError=WriteData(buffer,1,bytes)!=bytes;
 
     if (hasError) {
       throw IOException(filename,"Cannot write size restricted uint32_t");
@@ -489,7 +645,7 @@ namespace osmscout {
     buffer[6]=uint8_t((number >> 48u) & 0xff);
     buffer[7]=uint8_t((number >> 56u) & 0xff);
 
-    hasError=fwrite(buffer,1,bytes,file)!=bytes;
+    hasError=WriteData(buffer,1,bytes)!=bytes;
 
     if (hasError) {
       throw IOException(filename,"Cannot write size restricted uint64_t");
@@ -527,7 +683,7 @@ namespace osmscout {
     buffer[6]=uint8_t((fileOffset >> 48u) & 0xff);
     buffer[7]=uint8_t((fileOffset >> 56u) & 0xff);
 
-    hasError=fwrite(buffer,1,8,file)!=8;
+    hasError=WriteData(buffer,1,8)!=8;
 
     if (hasError) {
       throw IOException(filename,"Cannot write FileOffset");
@@ -558,7 +714,7 @@ namespace osmscout {
     buffer[6]=uint8_t((fileOffset >> 48u) & 0xff);
     buffer[7]=uint8_t((fileOffset >> 56u) & 0xff);
 
-    hasError=fwrite(buffer,1,bytes,file)!=bytes;
+    hasError=WriteData(buffer,1,bytes)!=bytes;
 
     if (HasError()) {
       throw IOException(filename,"Cannot write size limited FileOffset");
@@ -583,7 +739,7 @@ namespace osmscout {
 
     bytes=EncodeNumber(number,buffer);
 
-    hasError=fwrite(buffer,sizeof(unsigned char),bytes,file)!=bytes;
+    hasError=WriteData(buffer,sizeof(unsigned char),bytes)!=bytes;
 
     if (hasError) {
       throw IOException(filename,"Cannot write int16_t number");
@@ -608,7 +764,7 @@ namespace osmscout {
 
     bytes=EncodeNumber(number,buffer);
 
-    hasError=fwrite(buffer,sizeof(unsigned char),bytes,file)!=bytes;
+    hasError=WriteData(buffer,sizeof(unsigned char),bytes)!=bytes;
 
     if (hasError) {
       throw IOException(filename,"Cannot write int32_t number");
@@ -633,7 +789,7 @@ namespace osmscout {
 
     bytes=EncodeNumber(number,buffer);
 
-    hasError=fwrite(buffer,sizeof(unsigned char),bytes,file)!=bytes;
+    hasError=WriteData(buffer,sizeof(unsigned char),bytes)!=bytes;
 
     if (hasError) {
       throw IOException(filename,"Cannot write int64_t number");
@@ -658,7 +814,7 @@ namespace osmscout {
 
     bytes=EncodeNumber(number,buffer);
 
-    hasError=fwrite(buffer,sizeof(unsigned char),bytes,file)!=bytes;
+    hasError=WriteData(buffer,sizeof(unsigned char),bytes)!=bytes;
 
     if (hasError) {
       throw IOException(filename,"Cannot write uint16_t number");
@@ -683,7 +839,7 @@ namespace osmscout {
 
     bytes=EncodeNumber(number,buffer);
 
-    hasError=fwrite(buffer,sizeof(unsigned char),bytes,file)!=bytes;
+    hasError=WriteData(buffer,sizeof(unsigned char),bytes)!=bytes;
 
     if (hasError) {
       throw IOException(filename,"Cannot write uint32_t number");
@@ -708,7 +864,7 @@ namespace osmscout {
 
     bytes=EncodeNumber(number,buffer);
 
-    hasError=fwrite(buffer,sizeof(unsigned char),bytes,file)!=bytes;
+    hasError=WriteData(buffer,sizeof(unsigned char),bytes)!=bytes;
 
     if (hasError) {
       throw IOException(filename,"Cannot write uint64_t number");
@@ -746,7 +902,7 @@ namespace osmscout {
 
     buffer[6]=uint8_t(((latValue >> 24u) & 0x07) | ((lonValue >> 20u) & 0x70));
 
-    hasError=fwrite(buffer,1,coordByteSize,file)!=coordByteSize;
+    hasError=WriteData(buffer,1,coordByteSize)!=coordByteSize;
 
     if (hasError) {
       throw IOException(filename,"Cannot write coordinate");
@@ -775,7 +931,7 @@ namespace osmscout {
 
     buffer[6]=0xff;
 
-    hasError=fwrite(buffer,1,coordByteSize,file)!=coordByteSize;
+    hasError=WriteData(buffer,1,coordByteSize)!=coordByteSize;
 
     if (hasError) {
       throw IOException(filename,"Cannot write coordinate");
@@ -1294,7 +1450,8 @@ namespace osmscout {
       throw IOException(filename,"Cannot flush file","File already in error state");
     }
 
-    hasError=fflush(file)!=0;
+    hasError=!FlushBuffer() ||
+             fflush(file)!=0;
 
     if (hasError) {
       throw IOException(filename,"Cannot flush file");
@@ -1326,7 +1483,7 @@ namespace osmscout {
 
     memset(buffer,0,bytesToWrite);
 
-    hasError=fwrite(buffer,sizeof(char),bytesToWrite,file)!=bytesToWrite;
+    hasError=WriteData(buffer,sizeof(char),bytesToWrite)!=bytesToWrite;
 
     delete [] buffer;
 
@@ -19,73 +19,39 @@
 
 #include <osmscout/util/NodeUseMap.h>
 
-#include <limits>
-
 namespace osmscout {
 
   NodeUseMap::NodeUseMap()
-  : nodeCount(0),
-    duplicateCount(0)
   {
     // no code
   }
 
   void NodeUseMap::SetNodeUsed(Id id)
   {
-    PageId resolvedId=id+std::numeric_limits<Id>::min();
-    PageId offset=resolvedId/(4096/2);
-
-    Map::iterator entry=nodeUseMap.find(offset);
-
-    if (entry==nodeUseMap.end()) {
-      entry=nodeUseMap.insert(std::make_pair(offset,Bitset())).first;
-    }
-
-    uint32_t index=(resolvedId%(4096/2))*2;
-
-    if (entry->second[index+1]) {
-      // do nothing
-    }
-    else if (entry->second[index]) {
-      entry->second.set(index+1);
-      duplicateCount++;
-    }
-    else {
-      nodeCount++;
-      entry->second.set(index);
+    // Setting an id, that is already used twice, is a no-op
+    if (!usedOnce.Set(id)) {
+      usedTwice.Set(id);
     }
   }
 
   bool NodeUseMap::IsNodeUsedAtLeastTwice(Id id) const
   {
-    PageId resolvedId=id+std::numeric_limits<Id>::min();
-    PageId offset=resolvedId/(4096/2);
-
-    Map::const_iterator entry=nodeUseMap.find(offset);
-
-    if (entry==nodeUseMap.end()) {
-      return false;
-    }
-
-    uint32_t index=(resolvedId%(4096/2))*2+1;
-
-    return entry->second[index];
+    return usedTwice.IsSet(id);
   }
 
   size_t NodeUseMap::GetNodeUsedCount() const
   {
-    return nodeCount;
+    return usedOnce.GetNodeUsedCount();
   }
 
   size_t NodeUseMap::GetDuplicateCount() const
   {
-    return duplicateCount;
+    return usedTwice.GetNodeUsedCount();
   }
 
   void NodeUseMap::Clear()
   {
-    nodeUseMap.clear();
-    nodeCount=0;
-    duplicateCount=0;
+    usedOnce.Clear();
+    usedTwice.Clear();
   }
 }
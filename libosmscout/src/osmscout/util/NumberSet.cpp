@@ -19,49 +19,220 @@
 
 #include <osmscout/util/NumberSet.h>
 
+#include <algorithm>
 #include <limits>
 
 namespace osmscout {
 
+  bool NumberSet::Chunk::Set(uint16_t value)
+  {
+    if (IsBitmap()) {
+      uint64_t mask=uint64_t(1) << (value%64);
+
+      if ((bitmap[value/64] & mask)!=0) {
+        return false;
+      }
+
+      bitmap[value/64]|=mask;
+      count++;
+
+      return true;
+    }
+
+    auto position=array.end();
+
+    // Fast path for ascending inserts
+    if (!array.empty() &&
+        array.back()>=value) {
+      position=std::lower_bound(array.begin(),array.end(),value);
+
+      if (*position==value) {
+        return false;
+      }
+    }
+
+    if (array.size()<maxArraySize) {
+      array.insert(position,value);
+      count++;
+
+      return true;
+    }
+
+    // Array got too large, convert to bitmap
+    bitmap.assign(bitmapWords,0);
+
+    for (uint16_t v : array) {
+      bitmap[v/64]|=uint64_t(1) << (v%64);
+    }
+
+    array.clear();
+    array.shrink_to_fit();
+
+    bitmap[value/64]|=uint64_t(1) << (value%64);
+    count++;
+
+    return true;
+  }
+
+  bool NumberSet::Chunk::IsSet(uint16_t value) const
+  {
+    if (IsBitmap()) {
+      return (bitmap[value/64] & (uint64_t(1) << (value%64)))!=0;
+    }
+
+    return std::binary_search(array.begin(),array.end(),value);
+  }
+
   NumberSet::NumberSet()
-    : count(0)
+    : lastPage(0),
+      lastChunk(0),
+      count(0)
   {
     // no code
   }
 
-  void NumberSet::Set(Id id)
+  /**
+   * Returns the index of the page, that holds or would hold the chunk with the
+   * given id. There must be at least one page.
+   */
+  size_t NumberSet::FindPage(uint64_t chunkId) const
   {
-    size_t resolvedId=id+std::numeric_limits<Id>::min();
-    size_t offset=resolvedId/(4096/2);
+    auto page=std::upper_bound(pages.begin(),pages.end(),chunkId,[](uint64_t id, const Page& p) {
+      return id<p.front().id;
+    });
 
-    auto entry=map.find(offset);
+    if (page==pages.begin()) {
+      return 0;
+    }
 
-    if (entry==map.end()) {
-      entry=map.insert(std::make_pair(offset,Bitset())).first;
+    return page-pages.begin()-1;
+  }
+
+  NumberSet::Chunk* NumberSet::FindChunk(uint64_t chunkId)
+  {
+    if (lastPage<pages.size() &&
+        lastChunk<pages[lastPage].size() &&
+        pages[lastPage][lastChunk].id==chunkId) {
+      return &pages[lastPage][lastChunk];
     }
 
-    size_t index=resolvedId%4096;
+    if (pages.empty()) {
+      Chunk newChunk;
 
-    if (!entry->second[index]) {
-      count++;
-      entry->second.set(index);
+      newChunk.id=chunkId;
+      newChunk.count=0;
+
+      pages.emplace_back();
+      pages.back().reserve(maxPageChunks);
+      pages.back().push_back(std::move(newChunk));
+
+      lastPage=0;
+      lastChunk=0;
+
+      return &pages.back().back();
     }
+
+    size_t pageIndex=FindPage(chunkId);
+    Page*  page=&pages[pageIndex];
+    auto   chunk=std::lower_bound(page->begin(),page->end(),chunkId,[](const Chunk& c, uint64_t id) {
+      return c.id<id;
+    });
+
+    if (chunk==page->end() ||
+        chunk->id!=chunkId) {
+      size_t position=chunk-page->begin();
+
+      if (page->size()>=maxPageChunks) {
+        if (position==page->size() &&
+            pageIndex==pages.size()-1) {
+          // Ascending insert, start a new page
+          pages.emplace_back();
+          pages.back().reserve(maxPageChunks);
+
+          pageIndex++;
+          position=0;
+        }
+        else {
+          // Move the upper half of the page to a new page
+          Page upperHalf;
+
+          upperHalf.reserve(maxPageChunks);
+          upperHalf.insert(upperHalf.end(),
+                           std::make_move_iterator(page->begin()+maxPageChunks/2),
+                           std::make_move_iterator(page->end()));
+          page->erase(page->begin()+maxPageChunks/2,page->end());
+
+          pages.insert(pages.begin()+pageIndex+1,std::move(upperHalf));
+
+          if (position>=maxPageChunks/2) {
+            pageIndex++;
+            position-=maxPageChunks/2;
+          }
+        }
+
+        page=&pages[pageIndex];
+      }
+
+      Chunk newChunk;
+
+      newChunk.id=chunkId;
+      newChunk.count=0;
+
+      chunk=page->insert(page->begin()+position,std::move(newChunk));
+    }
+
+    lastPage=pageIndex;
+    lastChunk=chunk-page->begin();
+
+    return &*chunk;
   }
 
-  bool NumberSet::IsSet(Id id) const
+  const NumberSet::Chunk* NumberSet::FindChunk(uint64_t chunkId) const
   {
-    size_t resolvedId=id+std::numeric_limits<Id>::min();
-    size_t offset=resolvedId/(4096/2);
+    if (lastPage<pages.size() &&
+        lastChunk<pages[lastPage].size() &&
+        pages[lastPage][lastChunk].id==chunkId) {
+      return &pages[lastPage][lastChunk];
+    }
+
+    if (pages.empty()) {
+      return nullptr;
+    }
 
-    auto entry=map.find(offset);
+    const Page& page=pages[FindPage(chunkId)];
+    auto        chunk=std::lower_bound(page.begin(),page.end(),chunkId,[](const Chunk& c, uint64_t id) {
+      return c.id<id;
+    });
 
-    if (entry==map.end()) {
-      return false;
+    if (chunk==page.end() ||
+        chunk->id!=chunkId) {
+      return nullptr;
     }
 
-    size_t index=resolvedId%4096;
+    return &*chunk;
+  }
 
-    return entry->second[index];
+  bool NumberSet::Set(Id id)
+  {
+    uint64_t resolvedId=id+std::numeric_limits<Id>::min();
+    Chunk*   chunk=FindChunk(resolvedId >> chunkBits);
+
+    if (chunk->Set(uint16_t(resolvedId))) {
+      count++;
+
+      return true;
+    }
+
+    return false;
+  }
+
+  bool NumberSet::IsSet(Id id) const
+  {
+    uint64_t     resolvedId=id+std::numeric_limits<Id>::min();
+    const Chunk* chunk=FindChunk(resolvedId >> chunkBits);
+
+    return chunk!=nullptr &&
+           chunk->IsSet(uint16_t(resolvedId));
   }
 
   size_t NumberSet::GetNodeUsedCount() const
@@ -69,9 +240,122 @@ namespace osmscout {
     return count;
   }
 
+  size_t NumberSet::GetMemoryUsage() const
+  {
+    size_t size=pages.capacity()*sizeof(Page);
+
+    for (const auto& page : pages) {
+      size+=page.capacity()*sizeof(Chunk);
+
+      for (const auto& chunk : page) {
+        size+=chunk.array.capacity()*sizeof(uint16_t);
+        size+=chunk.bitmap.capacity()*sizeof(uint64_t);
+      }
+    }
+
+    return size;
+  }
+
   void NumberSet::Clear()
   {
-    map.clear();
+    pages.clear();
+    lastPage=0;
+    lastChunk=0;
     count=0;
   }
+
+  /**
+   * Write the set to the given FileWriter
+   *
+   * @throws IOException
+   */
+  void NumberSet::Write(FileWriter& writer) const
+  {
+    uint64_t chunkCount=0;
+
+    for (const auto& page : pages) {
+      chunkCount+=page.size();
+    }
+
+    writer.WriteNumber(chunkCount);
+
+    for (const auto& page : pages) {
+      for (const auto& chunk : page) {
+        writer.WriteNumber(chunk.id);
+        writer.WriteNumber(chunk.count);
+        writer.Write(chunk.IsBitmap());
+
+        if (chunk.IsBitmap()) {
+          for (uint64_t word : chunk.bitmap) {
+            writer.Write(word);
+          }
+        }
+        else {
+          // Values are sorted, store deltas
+          uint16_t last=0;
+
+          for (uint16_t value : chunk.array) {
+            writer.WriteNumber(uint16_t(value-last));
+            last=value;
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Read the set from the given FileScanner, replacing the current content
+   *
+   * @throws IOException
+   */
+  void NumberSet::Read(FileScanner& scanner)
+  {
+    uint64_t chunkCount;
+
+    Clear();
+
+    scanner.ReadNumber(chunkCount);
+
+    pages.reserve((chunkCount+maxPageChunks-1)/maxPageChunks);
+
+    for (uint64_t c=0; c<chunkCount; c++) {
+      if (pages.empty() ||
+          pages.back().size()==maxPageChunks) {
+        pages.emplace_back();
+        pages.back().reserve(maxPageChunks);
+      }
+
+      pages.back().emplace_back();
+
+      Chunk& chunk=pages.back().back();
+      bool   isBitmap;
+
+      scanner.ReadNumber(chunk.id);
+      scanner.ReadNumber(chunk.count);
+      scanner.Read(isBitmap);
+
+      if (isBitmap) {
+        chunk.bitmap.resize(bitmapWords);
+
+        for (auto& word : chunk.bitmap) {
+          scanner.Read(word);
+        }
+      }
+      else {
+        uint16_t last=0;
+
+        chunk.array.resize(chunk.count);
+
+        for (auto& value : chunk.array) {
+          uint16_t delta;
+
+          scanner.ReadNumber(delta);
+          value=last+delta;
+          last=value;
+        }
+      }
+
+      count+=chunk.count;
+    }
+  }
 }
@@ -170,5 +170,82 @@ namespace osmscout {
   {
     std::cout << "   !! " << text << std::endl;
   }
+
+  SynchronizedProgress::SynchronizedProgress(Progress& progress)
+  : progress(progress)
+  {
+    SetOutputDebug(progress.OutputDebug());
+  }
+
+  void SynchronizedProgress::SetStep(const std::string& step)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    progress.SetStep(step);
+  }
+
+  void SynchronizedProgress::SetAction(const std::string& action)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    progress.SetAction(action);
+  }
+
+  void SynchronizedProgress::SetProgress(double current, double total)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    progress.SetProgress(current,total);
+  }
+
+  void SynchronizedProgress::SetProgress(unsigned int current, unsigned int total)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    progress.SetProgress(current,total);
+  }
+
+  void SynchronizedProgress::SetProgress(unsigned long current, unsigned long total)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    progress.SetProgress(current,total);
+  }
+
+  void SynchronizedProgress::SetProgress(unsigned long long current,
+                                         unsigned long long total)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    progress.SetProgress(current,total);
+  }
+
+  void SynchronizedProgress::Debug(const std::string& text)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    progress.Debug(text);
+  }
+
+  void SynchronizedProgress::Info(const std::string& text)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    progress.Info(text);
+  }
+
+  void SynchronizedProgress::Warning(const std::string& text)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    progress.Warning(text);
+  }
+
+  void SynchronizedProgress::Error(const std::string& text)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    progress.Error(text);
+  }
 }
 